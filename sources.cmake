@@ -1,5 +1,6 @@
 set(SOURCES
 src/ciphers/aes/aes.c
+src/ciphers/aes/aes_ct.c
 src/ciphers/aes/aes_desc.c
 src/ciphers/aes/aes_tab.c
 src/ciphers/aes/aesni.c
@@ -31,8 +32,10 @@ src/encauth/ccm/ccm_add_aad.c
 src/encauth/ccm/ccm_add_nonce.c
 src/encauth/ccm/ccm_done.c
 src/encauth/ccm/ccm_init.c
+src/encauth/ccm/ccm_int_process_blocks.c
 src/encauth/ccm/ccm_memory.c
 src/encauth/ccm/ccm_process.c
+src/encauth/ccm/ccm_process_iov.c
 src/encauth/ccm/ccm_reset.c
 src/encauth/ccm/ccm_test.c
 src/encauth/chachapoly/chacha20poly1305_add_aad.c
@@ -40,7 +43,9 @@ src/encauth/chachapoly/chacha20poly1305_decrypt.c
 src/encauth/chachapoly/chacha20poly1305_done.c
 src/encauth/chachapoly/chacha20poly1305_encrypt.c
 src/encauth/chachapoly/chacha20poly1305_init.c
+src/encauth/chachapoly/chacha20poly1305_int_crypt.c
 src/encauth/chachapoly/chacha20poly1305_memory.c
+src/encauth/chachapoly/chacha20poly1305_process_iov.c
 src/encauth/chachapoly/chacha20poly1305_setiv.c
 src/encauth/chachapoly/chacha20poly1305_setiv_rfc7905.c
 src/encauth/chachapoly/chacha20poly1305_test.c
@@ -51,6 +56,7 @@ src/encauth/eax/eax_done.c
 src/encauth/eax/eax_encrypt.c
 src/encauth/eax/eax_encrypt_authenticate_memory.c
 src/encauth/eax/eax_init.c
+src/encauth/eax/eax_process_iov.c
 src/encauth/eax/eax_test.c
 src/encauth/gcm/gcm_add_aad.c
 src/encauth/gcm/gcm_add_iv.c
@@ -60,8 +66,11 @@ src/encauth/gcm/gcm_init.c
 src/encauth/gcm/gcm_memory.c
 src/encauth/gcm/gcm_mult_h.c
 src/encauth/gcm/gcm_process.c
+src/encauth/gcm/gcm_process_iov.c
 src/encauth/gcm/gcm_reset.c
 src/encauth/gcm/gcm_test.c
+src/encauth/gcm_siv/gcm_siv_memory.c
+src/encauth/gcm_siv/gcm_siv_test.c
 src/encauth/ocb/ocb_decrypt.c
 src/encauth/ocb/ocb_decrypt_verify_memory.c
 src/encauth/ocb/ocb_done_decrypt.c
@@ -84,6 +93,7 @@ src/encauth/ocb3/ocb3_encrypt_last.c
 src/encauth/ocb3/ocb3_init.c
 src/encauth/ocb3/ocb3_int_ntz.c
 src/encauth/ocb3/ocb3_int_xor_blocks.c
+src/encauth/ocb3/ocb3_process_iov.c
 src/encauth/ocb3/ocb3_test.c
 src/encauth/siv/siv.c
 src/hashes/blake2b.c
@@ -143,6 +153,11 @@ src/mac/f9/f9_memory.c
 src/mac/f9/f9_memory_multi.c
 src/mac/f9/f9_process.c
 src/mac/f9/f9_test.c
+src/mac/gmac/gmac.c
+src/mac/gmac/gmac_file.c
+src/mac/gmac/gmac_memory.c
+src/mac/gmac/gmac_memory_multi.c
+src/mac/gmac/gmac_test.c
 src/mac/hmac/hmac_done.c
 src/mac/hmac/hmac_file.c
 src/mac/hmac/hmac_init.c
@@ -181,6 +196,8 @@ src/mac/xcbc/xcbc_memory.c
 src/mac/xcbc/xcbc_memory_multi.c
 src/mac/xcbc/xcbc_process.c
 src/mac/xcbc/xcbc_test.c
+src/math/fixed_base.c
+src/math/fixed_window.c
 src/math/fp/ltc_ecc_fp_mulmod.c
 src/math/gmp_desc.c
 src/math/ltm_desc.c
@@ -188,8 +205,10 @@ src/math/multi.c
 src/math/radix_to_bin.c
 src/math/rand_bn.c
 src/math/rand_prime.c
+src/math/scratch.c
 src/math/tfm_desc.c
 src/misc/adler32.c
+src/misc/argon2/argon2.c
 src/misc/base16/base16_decode.c
 src/misc/base16/base16_encode.c
 src/misc/base32/base32_decode.c
@@ -197,15 +216,19 @@ src/misc/base32/base32_encode.c
 src/misc/base64/base64_decode.c
 src/misc/base64/base64_encode.c
 src/misc/bcrypt/bcrypt.c
+src/misc/bcrypt/bcrypt_hash.c
 src/misc/burn_stack.c
 src/misc/compare_testvector.c
 src/misc/copy_or_zeromem.c
 src/misc/crc32.c
 src/misc/crypt/crypt.c
 src/misc/crypt/crypt_argchk.c
+src/misc/crypt/crypt_cipher_cbc_mac.c
 src/misc/crypt/crypt_cipher_descriptor.c
+src/misc/crypt/crypt_cipher_ecb_blocks.c
 src/misc/crypt/crypt_cipher_is_valid.c
 src/misc/crypt/crypt_constants.c
+src/misc/crypt/crypt_file_process.c
 src/misc/crypt/crypt_find_cipher.c
 src/misc/crypt/crypt_find_cipher_any.c
 src/misc/crypt/crypt_find_cipher_id.c
@@ -218,6 +241,7 @@ src/misc/crypt/crypt_fsa.c
 src/misc/crypt/crypt_hash_descriptor.c
 src/misc/crypt/crypt_hash_is_valid.c
 src/misc/crypt/crypt_inits.c
+src/misc/crypt/crypt_iov_process.c
 src/misc/crypt/crypt_ltc_mp_descriptor.c
 src/misc/crypt/crypt_prng_descriptor.c
 src/misc/crypt/crypt_prng_is_valid.c
@@ -233,6 +257,7 @@ src/misc/crypt/crypt_unregister_cipher.c
 src/misc/crypt/crypt_unregister_hash.c
 src/misc/crypt/crypt_unregister_prng.c
 src/misc/error_to_string.c
+src/misc/fanout/digest_fanout.c
 src/misc/hkdf/hkdf.c
 src/misc/hkdf/hkdf_test.c
 src/misc/mem_neq.c
@@ -251,6 +276,7 @@ src/misc/pkcs12/pkcs12_utf8_to_utf16.c
 src/misc/pkcs5/pkcs_5_1.c
 src/misc/pkcs5/pkcs_5_2.c
 src/misc/pkcs5/pkcs_5_test.c
+src/misc/scrypt/scrypt.c
 src/misc/ssh/ssh_decode_sequence_multi.c
 src/misc/ssh/ssh_encode_sequence_multi.c
 src/misc/zeromem.c
@@ -270,6 +296,7 @@ src/modes/ctr/ctr_decrypt.c
 src/modes/ctr/ctr_done.c
 src/modes/ctr/ctr_encrypt.c
 src/modes/ctr/ctr_getiv.c
+src/modes/ctr/ctr_seek.c
 src/modes/ctr/ctr_setiv.c
 src/modes/ctr/ctr_start.c
 src/modes/ctr/ctr_test.c
@@ -303,6 +330,7 @@ src/modes/xts/xts_done.c
 src/modes/xts/xts_encrypt.c
 src/modes/xts/xts_init.c
 src/modes/xts/xts_mult_x.c
+src/modes/xts/xts_sectors.c
 src/modes/xts/xts_test.c
 src/pk/asn1/der/bit/der_decode_bit_string.c
 src/pk/asn1/der/bit/der_decode_raw_bit_string.c
@@ -376,6 +404,7 @@ src/pk/dh/dh.c
 src/pk/dh/dh_check_pubkey.c
 src/pk/dh/dh_export.c
 src/pk/dh/dh_export_key.c
+src/pk/dh/dh_fixed_base.c
 src/pk/dh/dh_free.c
 src/pk/dh/dh_generate_key.c
 src/pk/dh/dh_import.c
@@ -393,6 +422,7 @@ src/pk/dsa/dsa_import.c
 src/pk/dsa/dsa_import_pkcs8.c
 src/pk/dsa/dsa_init.c
 src/pk/dsa/dsa_make_key.c
+src/pk/dsa/dsa_prepare_key.c
 src/pk/dsa/dsa_set.c
 src/pk/dsa/dsa_set_pqg_dsaparam.c
 src/pk/dsa/dsa_shared_secret.c
@@ -0,0 +1,781 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/**
+  @file aes_ct.c
+  Constant-time bitsliced implementation of AES, four blocks are processed in parallel
+
+  The bitsliced representation, the S-box circuit of Boyar and Peralta and the
+  compressed key schedule follow the "ct64" implementation of BearSSL by Thomas Pornin.
+  There are no table lookups and no data-dependent branches.
+*/
+
+#include "tomcrypt_private.h"
+
+#if defined(LTC_AES_CT)
+
+static int s_aes_ct_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+static int s_aes_ct_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey);
+
+const struct ltc_cipher_descriptor aes_ct_desc =
+{
+    "aes-ct",
+    6,
+    16, 32, 16, 10,
+    aes_ct_setup, aes_ct_ecb_encrypt, aes_ct_ecb_decrypt, aes_ct_test, aes_ct_done, aes_ct_keysize,
+    s_aes_ct_accel_ecb_encrypt, s_aes_ct_accel_ecb_decrypt, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    NULL, NULL
+};
+
+/* number of blocks in one bitsliced state */
+#define AES_CT_LANES 4
+
+/* the S-box, bit 0 of every byte is in q[0] and bit 7 in q[7] */
+static void s_aes_ct_sbox(ulong64 *q)
+{
+   ulong64 x0, x1, x2, x3, x4, x5, x6, x7;
+   ulong64 y1, y2, y3, y4, y5, y6, y7, y8, y9;
+   ulong64 y10, y11, y12, y13, y14, y15, y16, y17, y18, y19;
+   ulong64 y20, y21;
+   ulong64 z0, z1, z2, z3, z4, z5, z6, z7, z8, z9;
+   ulong64 z10, z11, z12, z13, z14, z15, z16, z17;
+   ulong64 t0, t1, t2, t3, t4, t5, t6, t7, t8, t9;
+   ulong64 t10, t11, t12, t13, t14, t15, t16, t17, t18, t19;
+   ulong64 t20, t21, t22, t23, t24, t25, t26, t27, t28, t29;
+   ulong64 t30, t31, t32, t33, t34, t35, t36, t37, t38, t39;
+   ulong64 t40, t41, t42, t43, t44, t45, t46, t47, t48, t49;
+   ulong64 t50, t51, t52, t53, t54, t55, t56, t57, t58, t59;
+   ulong64 t60, t61, t62, t63, t64, t65, t66, t67;
+   ulong64 s0, s1, s2, s3, s4, s5, s6, s7;
+
+   x0 = q[7];
+   x1 = q[6];
+   x2 = q[5];
+   x3 = q[4];
+   x4 = q[3];
+   x5 = q[2];
+   x6 = q[1];
+   x7 = q[0];
+
+   /* top linear transformation */
+   y14 = x3 ^ x5;
+   y13 = x0 ^ x6;
+   y9  = x0 ^ x3;
+   y8  = x0 ^ x5;
+   t0  = x1 ^ x2;
+   y1  = t0 ^ x7;
+   y4  = y1 ^ x3;
+   y12 = y13 ^ y14;
+   y2  = y1 ^ x0;
+   y5  = y1 ^ x6;
+   y3  = y5 ^ y8;
+   t1  = x4 ^ y12;
+   y15 = t1 ^ x5;
+   y20 = t1 ^ x1;
+   y6  = y15 ^ x7;
+   y10 = y15 ^ t0;
+   y11 = y20 ^ y9;
+   y7  = x7 ^ y11;
+   y17 = y10 ^ y11;
+   y19 = y10 ^ y8;
+   y16 = t0 ^ y11;
+   y21 = y13 ^ y16;
+   y18 = x0 ^ y16;
+
+   /* non-linear section */
+   t2  = y12 & y15;
+   t3  = y3 & y6;
+   t4  = t3 ^ t2;
+   t5  = y4 & x7;
+   t6  = t5 ^ t2;
+   t7  = y13 & y16;
+   t8  = y5 & y1;
+   t9  = t8 ^ t7;
+   t10 = y2 & y7;
+   t11 = t10 ^ t7;
+   t12 = y9 & y11;
+   t13 = y14 & y17;
+   t14 = t13 ^ t12;
+   t15 = y8 & y10;
+   t16 = t15 ^ t12;
+   t17 = t4 ^ t14;
+   t18 = t6 ^ t16;
+   t19 = t9 ^ t14;
+   t20 = t11 ^ t16;
+   t21 = t17 ^ y20;
+   t22 = t18 ^ y19;
+   t23 = t19 ^ y21;
+   t24 = t20 ^ y18;
+
+   t25 = t21 ^ t22;
+   t26 = t21 & t23;
+   t27 = t24 ^ t26;
+   t28 = t25 & t27;
+   t29 = t28 ^ t22;
+   t30 = t23 ^ t24;
+   t31 = t22 ^ t26;
+   t32 = t31 & t30;
+   t33 = t32 ^ t24;
+   t34 = t23 ^ t33;
+   t35 = t27 ^ t33;
+   t36 = t24 & t35;
+   t37 = t36 ^ t34;
+   t38 = t27 ^ t36;
+   t39 = t29 & t38;
+   t40 = t25 ^ t39;
+
+   t41 = t40 ^ t37;
+   t42 = t29 ^ t33;
+   t43 = t29 ^ t40;
+   t44 = t33 ^ t37;
+   t45 = t42 ^ t41;
+   z0  = t44 & y15;
+   z1  = t37 & y6;
+   z2  = t33 & x7;
+   z3  = t43 & y16;
+   z4  = t40 & y1;
+   z5  = t29 & y7;
+   z6  = t42 & y11;
+   z7  = t45 & y17;
+   z8  = t41 & y10;
+   z9  = t44 & y12;
+   z10 = t37 & y3;
+   z11 = t33 & y4;
+   z12 = t43 & y13;
+   z13 = t40 & y5;
+   z14 = t29 & y2;
+   z15 = t42 & y9;
+   z16 = t45 & y14;
+   z17 = t41 & y8;
+
+   /* bottom linear transformation */
+   t46 = z15 ^ z16;
+   t47 = z10 ^ z11;
+   t48 = z5 ^ z13;
+   t49 = z9 ^ z10;
+   t50 = z2 ^ z12;
+   t51 = z2 ^ z5;
+   t52 = z7 ^ z8;
+   t53 = z0 ^ z3;
+   t54 = z6 ^ z7;
+   t55 = z16 ^ z17;
+   t56 = z12 ^ t48;
+   t57 = t50 ^ t53;
+   t58 = z4 ^ t46;
+   t59 = z3 ^ t54;
+   t60 = t46 ^ t57;
+   t61 = z14 ^ t57;
+   t62 = t52 ^ t58;
+   t63 = t49 ^ t58;
+   t64 = z4 ^ t59;
+   t65 = t61 ^ t62;
+   t66 = z1 ^ t63;
+   s0  = t59 ^ t63;
+   s6  = t56 ^ ~t62;
+   s7  = t48 ^ ~t60;
+   t67 = t64 ^ t65;
+   s3  = t53 ^ t66;
+   s4  = t51 ^ t66;
+   s5  = t47 ^ t65;
+   s1  = t64 ^ ~s3;
+   s2  = t55 ^ ~t67;
+
+   q[7] = s0;
+   q[6] = s1;
+   q[5] = s2;
+   q[4] = s3;
+   q[3] = s4;
+   q[2] = s5;
+   q[1] = s6;
+   q[0] = s7;
+}
+
+/* the inverse of the affine transformation of the S-box: x -> A^-1 * (x ^ 0x63) */
+static void s_aes_ct_inv_affine(ulong64 *q)
+{
+   ulong64 q0, q1, q2, q3, q4, q5, q6, q7;
+
+   q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+   q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+
+   q[0] = ~(q2 ^ q5 ^ q7);
+   q[1] = q3 ^ q6 ^ q0;
+   q[2] = ~(q4 ^ q7 ^ q1);
+   q[3] = q5 ^ q0 ^ q2;
+   q[4] = q6 ^ q1 ^ q3;
+   q[5] = q7 ^ q2 ^ q4;
+   q[6] = q0 ^ q3 ^ q5;
+   q[7] = q1 ^ q4 ^ q6;
+}
+
+/* the inverse S-box, the inversion in GF(2^8) is the S-box wrapped in its inverse affine transformation */
+static void s_aes_ct_inv_sbox(ulong64 *q)
+{
+   s_aes_ct_inv_affine(q);
+   s_aes_ct_sbox(q);
+   s_aes_ct_inv_affine(q);
+}
+
+#define AES_CT_SWAPN(cl, ch, s, x, y)                    \
+   do {                                                  \
+      ulong64 a_, b_;                                    \
+      a_ = (x);                                          \
+      b_ = (y);                                          \
+      (x) = (a_ & CONST64(cl)) | ((b_ & CONST64(cl)) << (s)); \
+      (y) = ((a_ & CONST64(ch)) >> (s)) | (b_ & CONST64(ch)); \
+   } while (0)
+
+#define AES_CT_SWAP2(x, y) AES_CT_SWAPN(0x5555555555555555, 0xAAAAAAAAAAAAAAAA, 1, x, y)
+#define AES_CT_SWAP4(x, y) AES_CT_SWAPN(0x3333333333333333, 0xCCCCCCCCCCCCCCCC, 2, x, y)
+#define AES_CT_SWAP8(x, y) AES_CT_SWAPN(0x0F0F0F0F0F0F0F0F, 0xF0F0F0F0F0F0F0F0, 4, x, y)
+
+/* transpose between the interleaved and the bitsliced representation, the operation is its own inverse */
+static void s_aes_ct_ortho(ulong64 *q)
+{
+   AES_CT_SWAP2(q[0], q[1]);
+   AES_CT_SWAP2(q[2], q[3]);
+   AES_CT_SWAP2(q[4], q[5]);
+   AES_CT_SWAP2(q[6], q[7]);
+
+   AES_CT_SWAP4(q[0], q[2]);
+   AES_CT_SWAP4(q[1], q[3]);
+   AES_CT_SWAP4(q[4], q[6]);
+   AES_CT_SWAP4(q[5], q[7]);
+
+   AES_CT_SWAP8(q[0], q[4]);
+   AES_CT_SWAP8(q[1], q[5]);
+   AES_CT_SWAP8(q[2], q[6]);
+   AES_CT_SWAP8(q[3], q[7]);
+}
+
+/* spread the four little endian words of a block over two 64-bit words */
+static void s_aes_ct_interleave_in(ulong64 *q0, ulong64 *q1, const ulong32 *w)
+{
+   ulong64 x0, x1, x2, x3;
+
+   x0 = w[0];
+   x1 = w[1];
+   x2 = w[2];
+   x3 = w[3];
+   x0 |= (x0 << 16);
+   x1 |= (x1 << 16);
+   x2 |= (x2 << 16);
+   x3 |= (x3 << 16);
+   x0 &= CONST64(0x0000FFFF0000FFFF);
+   x1 &= CONST64(0x0000FFFF0000FFFF);
+   x2 &= CONST64(0x0000FFFF0000FFFF);
+   x3 &= CONST64(0x0000FFFF0000FFFF);
+   x0 |= (x0 << 8);
+   x1 |= (x1 << 8);
+   x2 |= (x2 << 8);
+   x3 |= (x3 << 8);
+   x0 &= CONST64(0x00FF00FF00FF00FF);
+   x1 &= CONST64(0x00FF00FF00FF00FF);
+   x2 &= CONST64(0x00FF00FF00FF00FF);
+   x3 &= CONST64(0x00FF00FF00FF00FF);
+   *q0 = x0 | (x2 << 8);
+   *q1 = x1 | (x3 << 8);
+}
+
+static void s_aes_ct_interleave_out(ulong32 *w, ulong64 q0, ulong64 q1)
+{
+   ulong64 x0, x1, x2, x3;
+
+   x0 = q0 & CONST64(0x00FF00FF00FF00FF);
+   x1 = q1 & CONST64(0x00FF00FF00FF00FF);
+   x2 = (q0 >> 8) & CONST64(0x00FF00FF00FF00FF);
+   x3 = (q1 >> 8) & CONST64(0x00FF00FF00FF00FF);
+   x0 |= (x0 >> 8);
+   x1 |= (x1 >> 8);
+   x2 |= (x2 >> 8);
+   x3 |= (x3 >> 8);
+   x0 &= CONST64(0x0000FFFF0000FFFF);
+   x1 &= CONST64(0x0000FFFF0000FFFF);
+   x2 &= CONST64(0x0000FFFF0000FFFF);
+   x3 &= CONST64(0x0000FFFF0000FFFF);
+   w[0] = (ulong32)(x0 | (x0 >> 16));
+   w[1] = (ulong32)(x1 | (x1 >> 16));
+   w[2] = (ulong32)(x2 | (x2 >> 16));
+   w[3] = (ulong32)(x3 | (x3 >> 16));
+}
+
+static ulong32 s_aes_ct_sub_word(ulong32 x)
+{
+   ulong64 q[8];
+
+   XMEMSET(q, 0, sizeof(q));
+   q[0] = x;
+   s_aes_ct_ortho(q);
+   s_aes_ct_sbox(q);
+   s_aes_ct_ortho(q);
+   return (ulong32)q[0];
+}
+
+static void s_aes_ct_add_round_key(ulong64 *q, const ulong64 *sk)
+{
+   int i;
+   for (i = 0; i < 8; i++) {
+      q[i] ^= sk[i];
+   }
+}
+
+static void s_aes_ct_shift_rows(ulong64 *q)
+{
+   int i;
+   ulong64 x;
+
+   for (i = 0; i < 8; i++) {
+      x = q[i];
+      q[i] = (x & CONST64(0x000000000000FFFF))
+           | ((x & CONST64(0x00000000FFF00000)) >> 4)
+           | ((x & CONST64(0x00000000000F0000)) << 12)
+           | ((x & CONST64(0x0000FF0000000000)) >> 8)
+           | ((x & CONST64(0x000000FF00000000)) << 8)
+           | ((x & CONST64(0xF000000000000000)) >> 12)
+           | ((x & CONST64(0x0FFF000000000000)) << 4);
+   }
+}
+
+#define AES_CT_ROTR32(x) (((x) << 32) | ((x) >> 32))
+#define AES_CT_ROTR16(x) (((x) >> 16) | ((x) << 48))
+
+static void s_aes_ct_mix_columns(ulong64 *q)
+{
+   ulong64 q0, q1, q2, q3, q4, q5, q6, q7;
+   ulong64 r0, r1, r2, r3, r4, r5, r6, r7;
+
+   q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+   q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+   r0 = AES_CT_ROTR16(q0); r1 = AES_CT_ROTR16(q1);
+   r2 = AES_CT_ROTR16(q2); r3 = AES_CT_ROTR16(q3);
+   r4 = AES_CT_ROTR16(q4); r5 = AES_CT_ROTR16(q5);
+   r6 = AES_CT_ROTR16(q6); r7 = AES_CT_ROTR16(q7);
+
+   q[0] = q7 ^ r7 ^ r0 ^ AES_CT_ROTR32(q0 ^ r0);
+   q[1] = q0 ^ r0 ^ q7 ^ r7 ^ r1 ^ AES_CT_ROTR32(q1 ^ r1);
+   q[2] = q1 ^ r1 ^ r2 ^ AES_CT_ROTR32(q2 ^ r2);
+   q[3] = q2 ^ r2 ^ q7 ^ r7 ^ r3 ^ AES_CT_ROTR32(q3 ^ r3);
+   q[4] = q3 ^ r3 ^ q7 ^ r7 ^ r4 ^ AES_CT_ROTR32(q4 ^ r4);
+   q[5] = q4 ^ r4 ^ r5 ^ AES_CT_ROTR32(q5 ^ r5);
+   q[6] = q5 ^ r5 ^ r6 ^ AES_CT_ROTR32(q6 ^ r6);
+   q[7] = q6 ^ r6 ^ r7 ^ AES_CT_ROTR32(q7 ^ r7);
+}
+
+static void s_aes_ct_inv_shift_rows(ulong64 *q)
+{
+   int i;
+   ulong64 x;
+
+   for (i = 0; i < 8; i++) {
+      x = q[i];
+      q[i] = (x & CONST64(0x000000000000FFFF))
+           | ((x & CONST64(0x000000000FFF0000)) << 4)
+           | ((x & CONST64(0x00000000F0000000)) >> 12)
+           | ((x & CONST64(0x000000FF00000000)) << 8)
+           | ((x & CONST64(0x0000FF0000000000)) >> 8)
+           | ((x & CONST64(0x000F000000000000)) << 12)
+           | ((x & CONST64(0xFFF0000000000000)) >> 4);
+   }
+}
+
+static void s_aes_ct_inv_mix_columns(ulong64 *q)
+{
+   ulong64 q0, q1, q2, q3, q4, q5, q6, q7;
+   ulong64 r0, r1, r2, r3, r4, r5, r6, r7;
+
+   q0 = q[0]; q1 = q[1]; q2 = q[2]; q3 = q[3];
+   q4 = q[4]; q5 = q[5]; q6 = q[6]; q7 = q[7];
+   r0 = AES_CT_ROTR16(q0); r1 = AES_CT_ROTR16(q1);
+   r2 = AES_CT_ROTR16(q2); r3 = AES_CT_ROTR16(q3);
+   r4 = AES_CT_ROTR16(q4); r5 = AES_CT_ROTR16(q5);
+   r6 = AES_CT_ROTR16(q6); r7 = AES_CT_ROTR16(q7);
+
+   q[0] = q5 ^ q6 ^ q7 ^ r0 ^ r5 ^ r7 ^ AES_CT_ROTR32(q0 ^ q5 ^ q6 ^ r0 ^ r5);
+   q[1] = q0 ^ q5 ^ r0 ^ r1 ^ r5 ^ r6 ^ r7 ^ AES_CT_ROTR32(q1 ^ q5 ^ q7 ^ r1 ^ r5 ^ r6);
+   q[2] = q0 ^ q1 ^ q6 ^ r1 ^ r2 ^ r6 ^ r7 ^ AES_CT_ROTR32(q0 ^ q2 ^ q6 ^ r2 ^ r6 ^ r7);
+   q[3] = q0 ^ q1 ^ q2 ^ q5 ^ q6 ^ r0 ^ r2 ^ r3 ^ r5
+        ^ AES_CT_ROTR32(q0 ^ q1 ^ q3 ^ q5 ^ q6 ^ q7 ^ r0 ^ r3 ^ r5 ^ r7);
+   q[4] = q1 ^ q2 ^ q3 ^ q5 ^ r1 ^ r3 ^ r4 ^ r5 ^ r6 ^ r7
+        ^ AES_CT_ROTR32(q1 ^ q2 ^ q4 ^ q5 ^ q7 ^ r1 ^ r4 ^ r5 ^ r6);
+   q[5] = q2 ^ q3 ^ q4 ^ q6 ^ r2 ^ r4 ^ r5 ^ r6 ^ r7
+        ^ AES_CT_ROTR32(q2 ^ q3 ^ q5 ^ q6 ^ r2 ^ r5 ^ r6 ^ r7);
+   q[6] = q3 ^ q4 ^ q5 ^ q7 ^ r3 ^ r5 ^ r6 ^ r7
+        ^ AES_CT_ROTR32(q3 ^ q4 ^ q6 ^ q7 ^ r3 ^ r6 ^ r7);
+   q[7] = q4 ^ q5 ^ q6 ^ r4 ^ r6 ^ r7 ^ AES_CT_ROTR32(q4 ^ q5 ^ q7 ^ r4 ^ r7);
+}
+
+/* the round keys are computed in the compressed form of two words per round, this expands them to eight */
+static void s_aes_ct_skey_expand(ulong64 *sk, const ulong64 *comp, int Nr)
+{
+   ulong64 x0, x1, x2, x3;
+   int u, n;
+
+   n = (Nr + 1) * 2;
+   for (u = 0; u < n; u++) {
+      x0 = comp[u] & CONST64(0x1111111111111111);
+      x1 = (comp[u] & CONST64(0x2222222222222222)) >> 1;
+      x2 = (comp[u] & CONST64(0x4444444444444444)) >> 2;
+      x3 = (comp[u] & CONST64(0x8888888888888888)) >> 3;
+      sk[u * 4 + 0] = (x0 << 4) - x0;
+      sk[u * 4 + 1] = (x1 << 4) - x1;
+      sk[u * 4 + 2] = (x2 << 4) - x2;
+      sk[u * 4 + 3] = (x3 << 4) - x3;
+   }
+}
+
+ /**
+    Initialize the AES (Rijndael) block cipher
+    @param key The symmetric key you wish to pass
+    @param keylen The key length in bytes
+    @param num_rounds The number of rounds desired (0 for default)
+    @param skey The key in as scheduled by this function.
+    @return CRYPT_OK if successful
+ */
+int aes_ct_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey)
+{
+   static const unsigned char rcon[] = {
+      0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36
+   };
+   ulong32 w[60], tmp;
+   ulong64 q[8], comp[(14 + 1) * 2];
+   int i, j, k, nk, nkf, Nr;
+
+   LTC_ARGCHK(key != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (keylen != 16 && keylen != 24 && keylen != 32) {
+      return CRYPT_INVALID_KEYSIZE;
+   }
+
+   if (num_rounds != 0 && num_rounds != (keylen / 4 + 6)) {
+      return CRYPT_INVALID_ROUNDS;
+   }
+
+   Nr  = keylen / 4 + 6;
+   nk  = keylen / 4;
+   nkf = (Nr + 1) * 4;
+
+   /* the usual key expansion on little endian words, the S-box is the bitsliced one */
+   for (i = 0; i < nk; i++) {
+      LOAD32L(w[i], key + 4 * i);
+   }
+   tmp = w[nk - 1];
+   for (i = nk, j = 0, k = 0; i < nkf; i++) {
+      if (j == 0) {
+         tmp = (tmp << 24) | (tmp >> 8);
+         tmp = s_aes_ct_sub_word(tmp) ^ rcon[k];
+      } else if (nk > 6 && j == 4) {
+         tmp = s_aes_ct_sub_word(tmp);
+      }
+      tmp ^= w[i - nk];
+      w[i] = tmp;
+      if (++j == nk) {
+         j = 0;
+         k++;
+      }
+   }
+
+   /* bitslice every round key, all lanes share it so only one bit of every nibble needs to be kept */
+   for (i = 0, j = 0; i < nkf; i += 4, j += 2) {
+      s_aes_ct_interleave_in(&q[0], &q[4], w + i);
+      q[1] = q[2] = q[3] = q[0];
+      q[5] = q[6] = q[7] = q[4];
+      s_aes_ct_ortho(q);
+      comp[j + 0] = (q[0] & CONST64(0x1111111111111111))
+                  | (q[1] & CONST64(0x2222222222222222))
+                  | (q[2] & CONST64(0x4444444444444444))
+                  | (q[3] & CONST64(0x8888888888888888));
+      comp[j + 1] = (q[4] & CONST64(0x1111111111111111))
+                  | (q[5] & CONST64(0x2222222222222222))
+                  | (q[6] & CONST64(0x4444444444444444))
+                  | (q[7] & CONST64(0x8888888888888888));
+   }
+
+   s_aes_ct_skey_expand(skey->aes_ct.sk, comp, Nr);
+   skey->aes_ct.Nr = Nr;
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(w, sizeof(w));
+   zeromem(q, sizeof(q));
+   zeromem(comp, sizeof(comp));
+#endif
+   return CRYPT_OK;
+}
+
+/* load up to four blocks into the bitsliced state, missing blocks are zero */
+static void s_aes_ct_load(ulong64 *q, const unsigned char *in, unsigned long n)
+{
+   ulong32 w[AES_CT_LANES * 4];
+   unsigned long i;
+
+   XMEMSET(w, 0, sizeof(w));
+   for (i = 0; i < n * 4; i++) {
+      LOAD32L(w[i], in + 4 * i);
+   }
+   for (i = 0; i < AES_CT_LANES; i++) {
+      s_aes_ct_interleave_in(&q[i], &q[i + 4], w + (i << 2));
+   }
+   s_aes_ct_ortho(q);
+}
+
+static void s_aes_ct_store(unsigned char *out, ulong64 *q, unsigned long n)
+{
+   ulong32 w[AES_CT_LANES * 4];
+   unsigned long i;
+
+   s_aes_ct_ortho(q);
+   for (i = 0; i < AES_CT_LANES; i++) {
+      s_aes_ct_interleave_out(w + (i << 2), q[i], q[i + 4]);
+   }
+   for (i = 0; i < n * 4; i++) {
+      STORE32L(w[i], out + 4 * i);
+   }
+}
+
+static void s_aes_ct_encrypt(ulong64 *q, const ulong64 *sk, int Nr)
+{
+   int u;
+
+   s_aes_ct_add_round_key(q, sk);
+   for (u = 1; u < Nr; u++) {
+      s_aes_ct_sbox(q);
+      s_aes_ct_shift_rows(q);
+      s_aes_ct_mix_columns(q);
+      s_aes_ct_add_round_key(q, sk + (u << 3));
+   }
+   s_aes_ct_sbox(q);
+   s_aes_ct_shift_rows(q);
+   s_aes_ct_add_round_key(q, sk + (Nr << 3));
+}
+
+static void s_aes_ct_decrypt(ulong64 *q, const ulong64 *sk, int Nr)
+{
+   int u;
+
+   s_aes_ct_add_round_key(q, sk + (Nr << 3));
+   for (u = Nr - 1; u > 0; u--) {
+      s_aes_ct_inv_shift_rows(q);
+      s_aes_ct_inv_sbox(q);
+      s_aes_ct_add_round_key(q, sk + (u << 3));
+      s_aes_ct_inv_mix_columns(q);
+   }
+   s_aes_ct_inv_shift_rows(q);
+   s_aes_ct_inv_sbox(q);
+   s_aes_ct_add_round_key(q, sk);
+}
+
+static int s_aes_ct_blocks(const unsigned char *in, unsigned char *out, unsigned long blocks,
+                           const symmetric_key *skey, int enc)
+{
+   ulong64 q[8];
+   unsigned long n;
+
+   LTC_ARGCHK(in   != NULL);
+   LTC_ARGCHK(out  != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   if (skey->aes_ct.Nr < 10 || skey->aes_ct.Nr > 14) {
+      return CRYPT_INVALID_ROUNDS;
+   }
+
+   while (blocks > 0) {
+      n = MIN(blocks, AES_CT_LANES);
+      s_aes_ct_load(q, in, n);
+      if (enc) {
+         s_aes_ct_encrypt(q, skey->aes_ct.sk, skey->aes_ct.Nr);
+      } else {
+         s_aes_ct_decrypt(q, skey->aes_ct.sk, skey->aes_ct.Nr);
+      }
+      s_aes_ct_store(out, q, n);
+      in     += n * 16;
+      out    += n * 16;
+      blocks -= n;
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(q, sizeof(q));
+#endif
+   return CRYPT_OK;
+}
+
+/**
+  Encrypts a run of blocks with AES, four at a time
+  @param pt The input plaintext (16 * blocks bytes)
+  @param ct The output ciphertext (16 * blocks bytes), may equal pt
+  @param blocks The number of blocks to process
+  @param skey The key as scheduled by aes_ct_setup()
+  @return CRYPT_OK if successful
+*/
+int aes_ct_ecb_encrypt_blocks(const unsigned char *pt, unsigned char *ct, unsigned long blocks, const symmetric_key *skey)
+{
+   return s_aes_ct_blocks(pt, ct, blocks, skey, 1);
+}
+
+/**
+  Encrypts a block of text with AES
+  @param pt The input plaintext (16 bytes)
+  @param ct The output ciphertext (16 bytes)
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+int aes_ct_ecb_encrypt(const unsigned char *pt, unsigned char *ct, const symmetric_key *skey)
+{
+   return s_aes_ct_blocks(pt, ct, 1, skey, 1);
+}
+
+/**
+  Decrypts a run of blocks with AES, four at a time
+  @param ct The input ciphertext (16 * blocks bytes)
+  @param pt The output plaintext (16 * blocks bytes), may equal ct
+  @param blocks The number of blocks to process
+  @param skey The key as scheduled by aes_ct_setup()
+  @return CRYPT_OK if successful
+*/
+int aes_ct_ecb_decrypt_blocks(const unsigned char *ct, unsigned char *pt, unsigned long blocks, const symmetric_key *skey)
+{
+   return s_aes_ct_blocks(ct, pt, blocks, skey, 0);
+}
+
+/**
+  Decrypts a block of text with AES
+  @param ct The input ciphertext (16 bytes)
+  @param pt The output plaintext (16 bytes)
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+int aes_ct_ecb_decrypt(const unsigned char *ct, unsigned char *pt, const symmetric_key *skey)
+{
+   return s_aes_ct_blocks(ct, pt, 1, skey, 0);
+}
+
+/* the descriptor hooks take a non-const key, so they can't point to the _blocks functions directly */
+static int s_aes_ct_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey)
+{
+   return aes_ct_ecb_encrypt_blocks(pt, ct, blocks, skey);
+}
+
+static int s_aes_ct_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey)
+{
+   return aes_ct_ecb_decrypt_blocks(ct, pt, blocks, skey);
+}
+
+/**
+  Performs a self-test of the AES block cipher
+  @return CRYPT_OK if functional, CRYPT_NOP if self-test has been disabled
+*/
+int aes_ct_test(void)
+{
+ #ifndef LTC_TEST
+    return CRYPT_NOP;
+ #else
+ int err;
+ static const struct {
+     int keylen;
+     unsigned char key[32], pt[16], ct[16];
+ } tests[] = {
+    { 16,
+      { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f },
+      { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+      { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+        0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a }
+    }, {
+      24,
+      { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 },
+      { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+      { 0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+        0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91 }
+    }, {
+      32,
+      { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f },
+      { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff },
+      { 0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+        0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 }
+    }
+ };
+
+  symmetric_key key;
+  unsigned char tmp[2][16], buf[5][16];
+  int i, y;
+
+  for (i = 0; i < (int)(sizeof(tests)/sizeof(tests[0])); i++) {
+    zeromem(&key, sizeof(key));
+    if ((err = aes_ct_setup(tests[i].key, tests[i].keylen, 0, &key)) != CRYPT_OK) {
+       return err;
+    }
+
+    aes_ct_ecb_encrypt(tests[i].pt, tmp[0], &key);
+    aes_ct_ecb_decrypt(tmp[0], tmp[1], &key);
+    if (compare_testvector(tmp[0], 16, tests[i].ct, 16, "AES-CT Encrypt", i) ||
+          compare_testvector(tmp[1], 16, tests[i].pt, 16, "AES-CT Decrypt", i)) {
+        return CRYPT_FAIL_TESTVECTOR;
+    }
+
+    /* every lane of the bitsliced state, and a partially filled one */
+    for (y = 0; y < 5; y++) XMEMCPY(buf[y], tests[i].pt, 16);
+    aes_ct_ecb_encrypt_blocks(buf[0], buf[0], 5, &key);
+    for (y = 0; y < 5; y++) {
+       if (compare_testvector(buf[y], 16, tests[i].ct, 16, "AES-CT Encrypt blocks", i * 5 + y)) {
+          return CRYPT_FAIL_TESTVECTOR;
+       }
+    }
+    aes_ct_ecb_decrypt_blocks(buf[0], buf[0], 5, &key);
+    for (y = 0; y < 5; y++) {
+       if (compare_testvector(buf[y], 16, tests[i].pt, 16, "AES-CT Decrypt blocks", i * 5 + y)) {
+          return CRYPT_FAIL_TESTVECTOR;
+       }
+    }
+
+    /* now see if we can encrypt all zero bytes 1000 times, decrypt and come back where we started */
+    for (y = 0; y < 16; y++) tmp[0][y] = 0;
+    for (y = 0; y < 1000; y++) aes_ct_ecb_encrypt(tmp[0], tmp[0], &key);
+    for (y = 0; y < 1000; y++) aes_ct_ecb_decrypt(tmp[0], tmp[0], &key);
+    for (y = 0; y < 16; y++) if (tmp[0][y] != 0) return CRYPT_FAIL_TESTVECTOR;
+  }
+  return CRYPT_OK;
+ #endif
+}
+
+
+/** Terminate the context
+   @param skey    The scheduled key
+*/
+void aes_ct_done(symmetric_key *skey)
+{
+  LTC_UNUSED_PARAM(skey);
+}
+
+
+/**
+  Gets suitable key size
+  @param keysize [in/out] The length of the recommended key (in bytes).  This function will store the suitable size back in this variable.
+  @return CRYPT_OK if the input key size is acceptable.
+*/
+int aes_ct_keysize(int *keysize)
+{
+   LTC_ARGCHK(keysize != NULL);
+
+   if (*keysize < 16) {
+      return CRYPT_INVALID_KEYSIZE;
+   }
+   if (*keysize < 24) {
+      *keysize = 16;
+      return CRYPT_OK;
+   }
+   if (*keysize < 32) {
+      *keysize = 24;
+      return CRYPT_OK;
+   }
+   *keysize = 32;
+   return CRYPT_OK;
+}
+
+#endif
@@ -11,43 +11,86 @@
 
 #if defined(LTC_RIJNDAEL)
 
+/* only when it has to fall back to the table based implementation, the ECB hook isn't always fast */
+#if defined(LTC_AES_NI) && !defined(LTC_AES_CT)
+#define AES_ACCEL_IS_FAST s_aes_accel_ecb_is_fast
+static int AES_ACCEL_IS_FAST(void);
+#else
+#define AES_ACCEL_IS_FAST NULL
+#endif
+
 #ifndef ENCRYPT_ONLY
 
 #define AES_SETUP aes_setup
 #define AES_ENC   aes_ecb_encrypt
 #define AES_DEC   aes_ecb_decrypt
+#define AES_MAC   aes_cbc_mac
 #define AES_DONE  aes_done
 #define AES_TEST  aes_test
 #define AES_KS    aes_keysize
 
+#if defined(LTC_AES_CT) || defined(LTC_AES_NI)
+#define AES_ACCEL_ENC s_aes_accel_ecb_encrypt
+static int AES_ACCEL_ENC(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+#else
+#define AES_ACCEL_ENC NULL
+#endif
+#if defined(LTC_AES_CT)
+#define AES_ACCEL_DEC s_aes_accel_ecb_decrypt
+static int AES_ACCEL_DEC(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey);
+#else
+#define AES_ACCEL_DEC NULL
+#endif
+
 const struct ltc_cipher_descriptor aes_desc =
 {
     "aes",
     6,
     16, 32, 16, 10,
     AES_SETUP, AES_ENC, AES_DEC, AES_TEST, AES_DONE, AES_KS,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+    AES_ACCEL_ENC, AES_ACCEL_DEC, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    AES_MAC, AES_ACCEL_IS_FAST
 };
 
 #else
 
 #define AES_SETUP aes_enc_setup
 #define AES_ENC   aes_enc_ecb_encrypt
+#define AES_MAC   aes_enc_cbc_mac
 #define AES_DONE  aes_enc_done
 #define AES_TEST  aes_enc_test
 #define AES_KS    aes_enc_keysize
 
+#if defined(LTC_AES_CT) || defined(LTC_AES_NI)
+#define AES_ACCEL_ENC s_aes_enc_accel_ecb_encrypt
+static int AES_ACCEL_ENC(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+#else
+#define AES_ACCEL_ENC NULL
+#endif
+
 const struct ltc_cipher_descriptor aes_enc_desc =
 {
     "aes",
     6,
     16, 32, 16, 10,
     AES_SETUP, AES_ENC, NULL, NULL, AES_DONE, AES_KS,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+    AES_ACCEL_ENC, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    AES_MAC, AES_ACCEL_IS_FAST
 };
 
 #endif
 
+/* the software implementation that is used when there's no hardware support */
+#if defined(LTC_AES_CT)
+#define AES_SW_SETUP aes_ct_setup
+#define AES_SW_ENC   aes_ct_ecb_encrypt
+#define AES_SW_DEC   aes_ct_ecb_decrypt
+#else
+#define AES_SW_SETUP rijndael_setup
+#define AES_SW_ENC   rijndael_ecb_encrypt
+#define AES_SW_DEC   rijndael_ecb_decrypt
+#endif
+
 /* Code partially borrowed from https://software.intel.com/content/www/us/en/develop/articles/intel-sha-extensions.html */
 #if defined(LTC_AES_NI)
 static LTC_INLINE int s_aesni_is_supported(void)
@@ -81,6 +124,14 @@ int aesni_is_supported(void)
    return s_aesni_is_supported();
 }
 #endif
+
+#if !defined(LTC_AES_CT)
+/* on a CPU without AES-NI the ECB hook only loops over the table based implementation */
+static int AES_ACCEL_IS_FAST(void)
+{
+   return s_aesni_is_supported();
+}
+#endif
 #endif
 
  /**
@@ -99,7 +150,7 @@ int AES_SETUP(const unsigned char *key, int keylen, int num_rounds, symmetric_ke
    }
 #endif
    /* Last resort, software AES */
-   return rijndael_setup(key, keylen, num_rounds, skey);
+   return AES_SW_SETUP(key, keylen, num_rounds, skey);
 }
 
 /**
@@ -116,9 +167,76 @@ int AES_ENC(const unsigned char *pt, unsigned char *ct, const symmetric_key *ske
       return aesni_ecb_encrypt(pt, ct, skey);
    }
 #endif
-   return rijndael_ecb_encrypt(pt, ct, skey);
+   return AES_SW_ENC(pt, ct, skey);
+}
+
+#if defined(LTC_AES_CT) || defined(LTC_AES_NI)
+/**
+  Encrypts a run of blocks with AES, AES-NI keeps several blocks in flight and
+  the bitsliced implementation processes four of them at once
+  @param pt The input plaintext (16 * blocks bytes)
+  @param ct The output ciphertext (16 * blocks bytes)
+  @param blocks The number of blocks to process
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+static int AES_ACCEL_ENC(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey)
+{
+#if !defined(LTC_AES_CT)
+   int err;
+#endif
+#ifdef LTC_AES_NI
+   if (s_aesni_is_supported()) {
+      return aesni_ecb_encrypt_blocks(pt, ct, blocks, skey);
+   }
+#endif
+#if defined(LTC_AES_CT)
+   return aes_ct_ecb_encrypt_blocks(pt, ct, blocks, skey);
+#else
+   while (blocks-- > 0) {
+      if ((err = AES_SW_ENC(pt, ct, skey)) != CRYPT_OK) {
+         return err;
+      }
+      pt += 16;
+      ct += 16;
+   }
+   return CRYPT_OK;
+#endif
 }
+#endif
 
+/**
+  CBC-MAC over whole blocks with AES
+  @param in The message blocks
+  @param blocks The number of blocks to process
+  @param IV [in/out] The chaining value
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+int AES_MAC(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey)
+{
+   unsigned long x;
+   int err;
+
+#ifdef LTC_AES_NI
+   if (s_aesni_is_supported()) {
+      return aesni_cbc_mac(in, blocks, IV, skey);
+   }
+#endif
+   LTC_ARGCHK(in != NULL);
+   LTC_ARGCHK(IV != NULL);
+
+   while (blocks-- > 0) {
+      for (x = 0; x < 16; x++) {
+         IV[x] ^= in[x];
+      }
+      if ((err = AES_SW_ENC(IV, IV, skey)) != CRYPT_OK) {
+         return err;
+      }
+      in += 16;
+   }
+   return CRYPT_OK;
+}
 
 #ifndef ENCRYPT_ONLY
 /**
@@ -135,8 +253,36 @@ int AES_DEC(const unsigned char *ct, unsigned char *pt, const symmetric_key *ske
       return aesni_ecb_decrypt(ct, pt, skey);
    }
 #endif
-   return rijndael_ecb_decrypt(ct, pt, skey);
+   return AES_SW_DEC(ct, pt, skey);
 }
+
+#if defined(LTC_AES_CT)
+/**
+  Decrypts a run of blocks with AES, the bitsliced implementation processes four of them at once
+  @param ct The input ciphertext (16 * blocks bytes)
+  @param pt The output plaintext (16 * blocks bytes)
+  @param blocks The number of blocks to process
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+static int AES_ACCEL_DEC(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey)
+{
+#ifdef LTC_AES_NI
+   int err;
+   if (s_aesni_is_supported()) {
+      while (blocks-- > 0) {
+         if ((err = aesni_ecb_decrypt(ct, pt, skey)) != CRYPT_OK) {
+            return err;
+         }
+         ct += 16;
+         pt += 16;
+      }
+      return CRYPT_OK;
+   }
+#endif
+   return aes_ct_ecb_decrypt_blocks(ct, pt, blocks, skey);
+}
+#endif
 #endif /* ENCRYPT_ONLY */
 
 /**
@@ -11,13 +11,20 @@
 
 #if defined(LTC_AES_NI)
 
+#ifdef LTC_CCM_MODE
+#define AESNI_CCM aesni_ccm_memory
+#else
+#define AESNI_CCM NULL
+#endif
+
 const struct ltc_cipher_descriptor aesni_desc =
 {
     "aes",
     6,
     16, 32, 16, 10,
     aesni_setup, aesni_ecb_encrypt, aesni_ecb_decrypt, aesni_test, aesni_done, aesni_keysize,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, AESNI_CCM, NULL, NULL, NULL, NULL, NULL, NULL,
+    aesni_cbc_mac, NULL
 };
 
 #include <emmintrin.h>
@@ -214,6 +221,388 @@ int aesni_ecb_encrypt(const unsigned char *pt, unsigned char *ct, const symmetri
 #endif
 
 
+/**
+  CBC-MAC over whole blocks with AES, the chaining value stays in a register
+  @param in The message blocks
+  @param blocks The number of blocks to process
+  @param IV [in/out] The chaining value
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+LTC_ATTRIBUTE((__target__("aes")))
+#ifdef LTC_CLEAN_STACK
+static int s_aesni_cbc_mac(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey)
+#else
+int aesni_cbc_mac(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey)
+#endif
+{
+   int Nr, r;
+   const __m128i *skeys;
+   __m128i block;
+
+   LTC_ARGCHK(in != NULL);
+   LTC_ARGCHK(IV != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   Nr = skey->rijndael.Nr;
+
+   if (Nr < 2 || Nr > 16) return CRYPT_INVALID_ROUNDS;
+
+   skeys = (__m128i*) skey->rijndael.eK;
+   block = _mm_loadu_si128((const __m128i*) (IV));
+
+   while (blocks-- > 0) {
+      block = _mm_xor_si128(block, _mm_loadu_si128((const __m128i*) (in)));
+      block = _mm_xor_si128(block, skeys[0]);
+      for (r = 1; r < Nr - 1; r += 2) {
+         block = _mm_aesenc_si128(block, skeys[r]);
+         block = _mm_aesenc_si128(block, skeys[r + 1]);
+      }
+      block = _mm_aesenc_si128(block, skeys[Nr - 1]);
+      block = _mm_aesenclast_si128(block, skeys[Nr]);
+      in += 16;
+   }
+
+   _mm_storeu_si128((__m128i*) IV, block);
+
+   return CRYPT_OK;
+}
+
+#ifdef LTC_CLEAN_STACK
+int aesni_cbc_mac(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey)
+{
+   int err = s_aesni_cbc_mac(in, blocks, IV, skey);
+   burn_stack(sizeof(unsigned long)*8 + sizeof(unsigned long*) + sizeof(int)*2);
+   return err;
+}
+#endif
+
+/**
+  Encrypts a run of blocks with AES, up to four blocks are in flight in the pipeline
+  @param pt The input plaintext (16 * blocks bytes)
+  @param ct The output ciphertext (16 * blocks bytes)
+  @param blocks The number of blocks to process
+  @param skey The key as scheduled
+  @return CRYPT_OK if successful
+*/
+LTC_ATTRIBUTE((__target__("aes")))
+int aesni_ecb_encrypt_blocks(const unsigned char *pt, unsigned char *ct, unsigned long blocks, const symmetric_key *skey)
+{
+   int Nr, r;
+   unsigned long i, n;
+   const __m128i *skeys;
+   __m128i block[4];
+
+   LTC_ARGCHK(pt != NULL);
+   LTC_ARGCHK(ct != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   Nr = skey->rijndael.Nr;
+
+   if (Nr < 2 || Nr > 16) return CRYPT_INVALID_ROUNDS;
+
+   skeys = (__m128i*) skey->rijndael.eK;
+
+   while (blocks > 0) {
+      n = MIN(blocks, 4);
+      for (i = 0; i < n; i++) {
+         block[i] = _mm_xor_si128(_mm_loadu_si128((const __m128i*) (pt + 16 * i)), skeys[0]);
+      }
+      for (r = 1; r < Nr; r++) {
+         for (i = 0; i < n; i++) {
+            block[i] = _mm_aesenc_si128(block[i], skeys[r]);
+         }
+      }
+      for (i = 0; i < n; i++) {
+         _mm_storeu_si128((__m128i*) (ct + 16 * i), _mm_aesenclast_si128(block[i], skeys[Nr]));
+      }
+      pt += 16 * n;
+      ct += 16 * n;
+      blocks -= n;
+   }
+
+   return CRYPT_OK;
+}
+
+#ifdef LTC_CCM_MODE
+
+/* encrypt two independent blocks, their rounds interleaved */
+LTC_ATTRIBUTE((__target__("aes")))
+static LTC_INLINE void s_aesni_enc2(__m128i *a, __m128i *b, const __m128i *skeys, int Nr)
+{
+   int r;
+   __m128i x = _mm_xor_si128(*a, skeys[0]), y = _mm_xor_si128(*b, skeys[0]);
+
+   for (r = 1; r < Nr; r++) {
+      x = _mm_aesenc_si128(x, skeys[r]);
+      y = _mm_aesenc_si128(y, skeys[r]);
+   }
+   *a = _mm_aesenclast_si128(x, skeys[Nr]);
+   *b = _mm_aesenclast_si128(y, skeys[Nr]);
+}
+
+LTC_ATTRIBUTE((__target__("aes")))
+static LTC_INLINE __m128i s_aesni_enc1(__m128i x, const __m128i *skeys, int Nr)
+{
+   int r;
+
+   x = _mm_xor_si128(x, skeys[0]);
+   for (r = 1; r < Nr; r++) {
+      x = _mm_aesenc_si128(x, skeys[r]);
+   }
+   return _mm_aesenclast_si128(x, skeys[Nr]);
+}
+
+static LTC_INLINE void s_ccm_ctr_inc(unsigned char *ctr, unsigned long L)
+{
+   unsigned long z;
+
+   for (z = 15; z > 15-L; z--) {
+      ctr[z] = (ctr[z] + 1) & 255;
+      if (ctr[z]) break;
+   }
+}
+
+/**
+   CCM encrypt/decrypt and produce an authentication tag with AES-NI
+
+   The CTR keystream blocks are independent of each other and of the CBC-MAC chain,
+   so every MAC block is encrypted together with a keystream block and both stay in
+   registers for the whole packet.
+
+   @param key        The secret key to use
+   @param keylen     The length of the secret key (octets)
+   @param uskey      A previously scheduled key [optional can be NULL]
+   @param nonce      The session nonce [use once]
+   @param noncelen   The length of the nonce
+   @param header     The header for the session
+   @param headerlen  The length of the header (octets)
+   @param pt         [out] The plaintext
+   @param ptlen      The length of the plaintext (octets)
+   @param ct         [out] The ciphertext
+   @param tag        [out] The destination tag
+   @param taglen     [in/out] The max size and resulting size of the authentication tag
+   @param direction  Encrypt or Decrypt direction (0 or 1)
+   @return CRYPT_OK if successful
+*/
+LTC_ATTRIBUTE((__target__("aes")))
+int aesni_ccm_memory(const unsigned char *key,    unsigned long keylen,
+                     symmetric_key       *uskey,
+                     const unsigned char *nonce,  unsigned long noncelen,
+                     const unsigned char *header, unsigned long headerlen,
+                           unsigned char *pt,     unsigned long ptlen,
+                           unsigned char *ct,
+                           unsigned char *tag,    unsigned long *taglen,
+                                     int  direction)
+{
+   unsigned char  buf[16], ctr[16], *pt_real;
+   unsigned char *pt_work = NULL;
+   symmetric_key *skey;
+   const __m128i *skeys;
+   __m128i        mac, ks, S0, tmp;
+   unsigned long  len, L, x, y, full;
+   int            Nr, err;
+
+   if (uskey == NULL) {
+      LTC_ARGCHK(key    != NULL);
+   }
+   LTC_ARGCHK(nonce  != NULL);
+   if (headerlen > 0) {
+      LTC_ARGCHK(header != NULL);
+   }
+   LTC_ARGCHK(pt     != NULL);
+   LTC_ARGCHK(ct     != NULL);
+   LTC_ARGCHK(tag    != NULL);
+   LTC_ARGCHK(taglen != NULL);
+
+   if (*taglen < 4 || *taglen > 16 || (*taglen % 2) == 1 || headerlen > 0x7fffffffu) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   /* let's get the L value */
+   len = ptlen;
+   L   = 0;
+   while (len) {
+      ++L;
+      len >>= 8;
+   }
+   if (L <= 1) {
+      L = 2;
+   }
+
+   /* increase L to match the nonce len */
+   noncelen = (noncelen > 13) ? 13 : noncelen;
+   if ((15 - noncelen) > L) {
+      L = 15 - noncelen;
+   }
+   if (L > 8) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   /* decrypt into a buffer of our own, the plaintext is only released when the tag matches */
+   pt_real = pt;
+   if (direction == CCM_DECRYPT && ptlen > 0) {
+      pt_work = XMALLOC(ptlen);
+      if (pt_work == NULL) {
+         return CRYPT_MEM;
+      }
+      pt = pt_work;
+   }
+
+   if (uskey == NULL) {
+      skey = XMALLOC(sizeof(*skey));
+      if (skey == NULL) {
+         err = CRYPT_MEM;
+         goto LBL_ERR;
+      }
+      if ((err = aesni_setup(key, (int)keylen, 0, skey)) != CRYPT_OK) {
+         XFREE(skey);
+         goto LBL_ERR;
+      }
+   } else {
+      skey = uskey;
+   }
+   Nr    = skey->rijndael.Nr;
+   skeys = (const __m128i*) skey->rijndael.eK;
+
+   /* form B_0 == flags | Nonce N | l(m) */
+   buf[0] = (unsigned char)(((headerlen > 0) ? (1<<6) : 0) | (((*taglen - 2)>>1)<<3) | (L-1));
+   XMEMCPY(buf + 1, nonce, 15 - L);
+   len = ptlen;
+   for (y = 0; y < L; y++) {
+      buf[15 - y] = (unsigned char)(len & 255);
+      len >>= 8;
+   }
+
+   /* A_0, the counter block that encrypts the tag */
+   ctr[0] = (unsigned char)(L-1);
+   XMEMCPY(ctr + 1, nonce, 15 - L);
+   zeromem(ctr + 16 - L, L);
+
+   mac = _mm_loadu_si128((const __m128i*) buf);
+   S0  = _mm_loadu_si128((const __m128i*) ctr);
+   s_aesni_enc2(&mac, &S0, skeys, Nr);
+
+   /* handle header */
+   if (headerlen > 0) {
+      zeromem(buf, sizeof(buf));
+      x = 0;
+      if (headerlen < ((1UL<<16) - (1UL<<8))) {
+         buf[x++] = (headerlen>>8) & 255;
+         buf[x++] = headerlen & 255;
+      } else {
+         buf[x++] = 0xFF;
+         buf[x++] = 0xFE;
+         buf[x++] = (headerlen>>24) & 255;
+         buf[x++] = (headerlen>>16) & 255;
+         buf[x++] = (headerlen>>8) & 255;
+         buf[x++] = headerlen & 255;
+      }
+      for (y = 0; y < headerlen; ) {
+         len = MIN(16 - x, headerlen - y);
+         XMEMCPY(buf + x, header + y, len);
+         x += len;
+         y += len;
+         if (x == 16 || y == headerlen) {
+            mac = s_aesni_enc1(_mm_xor_si128(mac, _mm_loadu_si128((const __m128i*) buf)), skeys, Nr);
+            zeromem(buf, sizeof(buf));
+            x = 0;
+         }
+      }
+   }
+
+   full = ptlen & ~15uL;
+   if (direction == CCM_ENCRYPT) {
+      for (y = 0; y < full; y += 16) {
+         s_ccm_ctr_inc(ctr, L);
+         tmp = _mm_loadu_si128((const __m128i*) (pt + y));
+         ks  = _mm_loadu_si128((const __m128i*) ctr);
+         mac = _mm_xor_si128(mac, tmp);
+         s_aesni_enc2(&ks, &mac, skeys, Nr);
+         _mm_storeu_si128((__m128i*) (ct + y), _mm_xor_si128(tmp, ks));
+      }
+      if (y < ptlen) {
+         zeromem(buf, sizeof(buf));
+         XMEMCPY(buf, pt + y, ptlen - y);
+         s_ccm_ctr_inc(ctr, L);
+         tmp = _mm_loadu_si128((const __m128i*) buf);
+         ks  = _mm_loadu_si128((const __m128i*) ctr);
+         mac = _mm_xor_si128(mac, tmp);
+         s_aesni_enc2(&ks, &mac, skeys, Nr);
+         _mm_storeu_si128((__m128i*) buf, _mm_xor_si128(tmp, ks));
+         XMEMCPY(ct + y, buf, ptlen - y);
+      }
+   } else {
+      /* the plaintext feeds the MAC, so the keystream of the next block runs alongside the MAC of this one */
+      if (ptlen > 0) {
+         s_ccm_ctr_inc(ctr, L);
+         ks = s_aesni_enc1(_mm_loadu_si128((const __m128i*) ctr), skeys, Nr);
+      } else {
+         ks = _mm_setzero_si128();
+      }
+      for (y = 0; y < full; y += 16) {
+         tmp = _mm_xor_si128(_mm_loadu_si128((const __m128i*) (ct + y)), ks);
+         _mm_storeu_si128((__m128i*) (pt + y), tmp);
+         mac = _mm_xor_si128(mac, tmp);
+         if (y + 16 < ptlen) {
+            s_ccm_ctr_inc(ctr, L);
+            ks = _mm_loadu_si128((const __m128i*) ctr);
+            s_aesni_enc2(&ks, &mac, skeys, Nr);
+         } else {
+            mac = s_aesni_enc1(mac, skeys, Nr);
+         }
+      }
+      if (y < ptlen) {
+         zeromem(buf, sizeof(buf));
+         XMEMCPY(buf, ct + y, ptlen - y);
+         _mm_storeu_si128((__m128i*) buf, _mm_xor_si128(_mm_loadu_si128((const __m128i*) buf), ks));
+         zeromem(buf + ptlen - y, 16 - (ptlen - y));
+         XMEMCPY(pt + y, buf, ptlen - y);
+         mac = s_aesni_enc1(_mm_xor_si128(mac, _mm_loadu_si128((const __m128i*) buf)), skeys, Nr);
+      }
+   }
+
+   if (skey != uskey) {
+      aesni_done(skey);
+#ifdef LTC_CLEAN_STACK
+      zeromem(skey, sizeof(*skey));
+#endif
+      XFREE(skey);
+   }
+
+   _mm_storeu_si128((__m128i*) buf, _mm_xor_si128(mac, S0));
+   if (direction == CCM_ENCRYPT) {
+      XMEMCPY(tag, buf, *taglen);
+      err = CRYPT_OK;
+   } else {
+      /* check the tag and release or zero the plaintext, both in constant time */
+      err = XMEM_NEQ(buf, tag, *taglen);
+      if (ptlen > 0) {
+         copy_or_zeromem(pt, pt_real, ptlen, err);
+      }
+   }
+
+#ifdef LTC_CLEAN_STACK
+   zeromem(buf, sizeof(buf));
+   zeromem(ctr, sizeof(ctr));
+   zeromem(&mac, sizeof(mac));
+   zeromem(&ks,  sizeof(ks));
+   zeromem(&S0,  sizeof(S0));
+   zeromem(&tmp, sizeof(tmp));
+   if (pt_work != NULL) {
+      zeromem(pt_work, ptlen);
+   }
+#endif
+LBL_ERR:
+   if (pt_work != NULL) {
+      XFREE(pt_work);
+   }
+
+   return err;
+}
+
+#endif
+
 /**
   Decrypts a block of text with AES
   @param ct The input ciphertext (16 bytes)
@@ -266,6 +655,72 @@ int aesni_ecb_decrypt(const unsigned char *ct, unsigned char *pt, const symmetri
 }
 #endif
 
+#if defined(LTC_TEST) && defined(LTC_CCM_MODE)
+static int s_aesni_ccm_test(void)
+{
+   /* RFC 3610 packet vector #1 and NIST SP 800-38C example 2 */
+   static const struct {
+      unsigned char key[16], nonce[13], header[16], pt[24], ct[24], tag[8];
+      unsigned long noncelen, headerlen, ptlen, taglen;
+   } tests[] = {
+      { { 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF },
+        { 0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 },
+        { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07 },
+        { 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+          0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E },
+        { 0x58, 0x8C, 0x97, 0x9A, 0x61, 0xC6, 0x63, 0xD2, 0xF0, 0x66, 0xD0, 0xC2, 0xC0, 0xF9, 0x89, 0x80,
+          0x6D, 0x5F, 0x6B, 0x61, 0xDA, 0xC3, 0x84 },
+        { 0x17, 0xE8, 0xD1, 0x2C, 0xFD, 0xF9, 0x26, 0xE0 },
+        13, 8, 23, 8 },
+      { { 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F },
+        { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17 },
+        { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F },
+        { 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F },
+        { 0xD2, 0xA1, 0xF0, 0xE0, 0x51, 0xEA, 0x5F, 0x62, 0x08, 0x1A, 0x77, 0x92, 0x07, 0x3D, 0x59, 0x3D },
+        { 0x1F, 0xC6, 0x4F, 0xBF, 0xAC, 0xCD },
+        8, 16, 16, 6 },
+   };
+   static const unsigned char zero[24] = { 0 };
+   unsigned char buf[24], tag[16];
+   unsigned long taglen;
+   int i, err;
+
+   for (i = 0; i < (int)(sizeof(tests)/sizeof(tests[0])); i++) {
+      taglen = tests[i].taglen;
+      if ((err = aesni_ccm_memory(tests[i].key, 16, NULL, tests[i].nonce, tests[i].noncelen,
+                                  tests[i].header, tests[i].headerlen, (unsigned char *)tests[i].pt, tests[i].ptlen,
+                                  buf, tag, &taglen, CCM_ENCRYPT)) != CRYPT_OK) {
+         return err;
+      }
+      if (compare_testvector(buf, tests[i].ptlen, tests[i].ct, tests[i].ptlen, "AES-NI CCM Encrypt", i) ||
+            compare_testvector(tag, taglen, tests[i].tag, tests[i].taglen, "AES-NI CCM Tag", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+      /* in place */
+      if ((err = aesni_ccm_memory(tests[i].key, 16, NULL, tests[i].nonce, tests[i].noncelen,
+                                  tests[i].header, tests[i].headerlen, buf, tests[i].ptlen,
+                                  buf, tag, &taglen, CCM_DECRYPT)) != CRYPT_OK) {
+         return err;
+      }
+      if (compare_testvector(buf, tests[i].ptlen, tests[i].pt, tests[i].ptlen, "AES-NI CCM Decrypt", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+      tag[0] ^= 1;
+      XMEMCPY(buf, tests[i].ct, tests[i].ptlen);
+      if (aesni_ccm_memory(tests[i].key, 16, NULL, tests[i].nonce, tests[i].noncelen,
+                           tests[i].header, tests[i].headerlen, buf, tests[i].ptlen,
+                           buf, tag, &taglen, CCM_DECRYPT) == CRYPT_OK) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+      /* and the unauthenticated plaintext is not released */
+      if (compare_testvector(buf, tests[i].ptlen, zero, tests[i].ptlen, "AES-NI CCM wrong tag", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+   }
+   return CRYPT_OK;
+}
+#endif
+
 /**
   Performs a self-test of the AES block cipher
   @return CRYPT_OK if functional, CRYPT_NOP if self-test has been disabled
@@ -332,6 +787,11 @@ int aesni_test(void)
     for (y = 0; y < 1000; y++) aesni_ecb_decrypt(tmp[0], tmp[0], &key);
     for (y = 0; y < 16; y++) if (tmp[0][y] != 0) return CRYPT_FAIL_TESTVECTOR;
   }
+#ifdef LTC_CCM_MODE
+  if ((err = s_aesni_ccm_test()) != CRYPT_OK) {
+    return err;
+  }
+#endif
   return CRYPT_OK;
  #endif
 }
@@ -8,6 +8,9 @@
 
 #ifdef LTC_BLOWFISH
 
+static int s_blowfish_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+static int s_blowfish_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey);
+
 const struct ltc_cipher_descriptor blowfish_desc =
 {
     "blowfish",
@@ -19,6 +22,7 @@ const struct ltc_cipher_descriptor blowfish_desc =
     &blowfish_test,
     &blowfish_done,
     &blowfish_keysize,
+    &s_blowfish_accel_ecb_encrypt, &s_blowfish_accel_ecb_decrypt,
     NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
 };
 
@@ -387,31 +391,43 @@ int blowfish_expand(const unsigned char *key, int keylen,
    i = 0;
    B[0] = 0;
    B[1] = 0;
-   for (x = 0; x < 18; x += 2) {
-      if (data != NULL) {
+   if (data == NULL) {
+      /* plain re-keying as used by the bcrypt key schedule, keep the loop free of the data branch */
+      for (x = 0; x < 18; x += 2) {
+         s_blowfish_encipher(&B[0], &B[1], skey);
+         skey->blowfish.K[x] = B[0];
+         skey->blowfish.K[x+1] = B[1];
+      }
+      for (x = 0; x < 4; x++) {
+         for (y = 0; y < 256; y += 2) {
+            s_blowfish_encipher(&B[0], &B[1], skey);
+            skey->blowfish.S[x][y] = B[0];
+            skey->blowfish.S[x][y+1] = B[1];
+         }
+      }
+   } else {
+      for (x = 0; x < 18; x += 2) {
          B[0] ^= s_blowfish_stream2word(data, datalen, &i);
          B[1] ^= s_blowfish_stream2word(data, datalen, &i);
+         /* encrypt it */
+         s_blowfish_encipher(&B[0], &B[1], skey);
+         /* copy it */
+         skey->blowfish.K[x] = B[0];
+         skey->blowfish.K[x+1] = B[1];
       }
-      /* encrypt it */
-      s_blowfish_encipher(&B[0], &B[1], skey);
-      /* copy it */
-      skey->blowfish.K[x] = B[0];
-      skey->blowfish.K[x+1] = B[1];
-   }
 
-   /* encrypt S array */
-   for (x = 0; x < 4; x++) {
-       for (y = 0; y < 256; y += 2) {
-          if (data != NULL) {
-             B[0] ^= s_blowfish_stream2word(data, datalen, &i);
-             B[1] ^= s_blowfish_stream2word(data, datalen, &i);
-          }
-          /* encrypt it */
-          s_blowfish_encipher(&B[0], &B[1], skey);
-          /* copy it */
-          skey->blowfish.S[x][y] = B[0];
-          skey->blowfish.S[x][y+1] = B[1];
-       }
+      /* encrypt S array */
+      for (x = 0; x < 4; x++) {
+         for (y = 0; y < 256; y += 2) {
+            B[0] ^= s_blowfish_stream2word(data, datalen, &i);
+            B[1] ^= s_blowfish_stream2word(data, datalen, &i);
+            /* encrypt it */
+            s_blowfish_encipher(&B[0], &B[1], skey);
+            /* copy it */
+            skey->blowfish.S[x][y] = B[0];
+            skey->blowfish.S[x][y+1] = B[1];
+         }
+      }
    }
 
 #ifdef LTC_CLEAN_STACK
@@ -567,6 +583,117 @@ int blowfish_ecb_decrypt(const unsigned char *ct, unsigned char *pt, const symme
 #endif
 
 
+/* two blocks at once, the rounds of both are interleaved so that their S-box lookups overlap */
+static void s_blowfish_encipher2(ulong32 *d, const symmetric_key *skey)
+{
+   int rounds;
+   ulong32 l0, r0, l1, r1;
+#ifndef __GNUC__
+   const ulong32 *S1, *S2, *S3, *S4;
+
+   S1 = skey->blowfish.S[0];
+   S2 = skey->blowfish.S[1];
+   S3 = skey->blowfish.S[2];
+   S4 = skey->blowfish.S[3];
+#endif
+
+   l0 = d[0]; r0 = d[1];
+   l1 = d[2]; r1 = d[3];
+
+   for (rounds = 0; rounds < 16; rounds += 2) {
+      l0 ^= skey->blowfish.K[rounds];    l1 ^= skey->blowfish.K[rounds];
+      r0 ^= F(l0);                       r1 ^= F(l1);
+      r0 ^= skey->blowfish.K[rounds+1];  r1 ^= skey->blowfish.K[rounds+1];
+      l0 ^= F(r0);                       l1 ^= F(r1);
+   }
+   l0 ^= skey->blowfish.K[16];  l1 ^= skey->blowfish.K[16];
+   r0 ^= skey->blowfish.K[17];  r1 ^= skey->blowfish.K[17];
+
+   d[0] = r0; d[1] = l0;
+   d[2] = r1; d[3] = l1;
+}
+
+static void s_blowfish_decipher2(ulong32 *d, const symmetric_key *skey)
+{
+   int rounds;
+   ulong32 l0, r0, l1, r1;
+#ifndef __GNUC__
+   const ulong32 *S1, *S2, *S3, *S4;
+
+   S1 = skey->blowfish.S[0];
+   S2 = skey->blowfish.S[1];
+   S3 = skey->blowfish.S[2];
+   S4 = skey->blowfish.S[3];
+#endif
+
+   r0 = d[0]; l0 = d[1];
+   r1 = d[2]; l1 = d[3];
+
+   r0 ^= skey->blowfish.K[17];  r1 ^= skey->blowfish.K[17];
+   l0 ^= skey->blowfish.K[16];  l1 ^= skey->blowfish.K[16];
+   for (rounds = 15; rounds > 0; rounds -= 2) {
+      l0 ^= F(r0);                       l1 ^= F(r1);
+      r0 ^= skey->blowfish.K[rounds];    r1 ^= skey->blowfish.K[rounds];
+      r0 ^= F(l0);                       r1 ^= F(l1);
+      l0 ^= skey->blowfish.K[rounds-1];  l1 ^= skey->blowfish.K[rounds-1];
+   }
+
+   d[0] = l0; d[1] = r0;
+   d[2] = l1; d[3] = r1;
+}
+
+static int s_blowfish_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey)
+{
+   ulong32 d[4];
+
+   LTC_ARGCHK(pt   != NULL);
+   LTC_ARGCHK(ct   != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   for (; blocks >= 2; blocks -= 2) {
+      LOAD32H(d[0], pt +  0); LOAD32H(d[1], pt +  4);
+      LOAD32H(d[2], pt +  8); LOAD32H(d[3], pt + 12);
+      s_blowfish_encipher2(d, skey);
+      STORE32H(d[0], ct +  0); STORE32H(d[1], ct +  4);
+      STORE32H(d[2], ct +  8); STORE32H(d[3], ct + 12);
+      pt += 16;
+      ct += 16;
+   }
+   if (blocks != 0) {
+      blowfish_ecb_encrypt(pt, ct, skey);
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(d, sizeof(d));
+#endif
+   return CRYPT_OK;
+}
+
+static int s_blowfish_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey)
+{
+   ulong32 d[4];
+
+   LTC_ARGCHK(pt   != NULL);
+   LTC_ARGCHK(ct   != NULL);
+   LTC_ARGCHK(skey != NULL);
+
+   for (; blocks >= 2; blocks -= 2) {
+      LOAD32H(d[0], ct +  0); LOAD32H(d[1], ct +  4);
+      LOAD32H(d[2], ct +  8); LOAD32H(d[3], ct + 12);
+      s_blowfish_decipher2(d, skey);
+      STORE32H(d[0], pt +  0); STORE32H(d[1], pt +  4);
+      STORE32H(d[2], pt +  8); STORE32H(d[3], pt + 12);
+      ct += 16;
+      pt += 16;
+   }
+   if (blocks != 0) {
+      blowfish_ecb_decrypt(ct, pt, skey);
+   }
+#ifdef LTC_CLEAN_STACK
+   zeromem(d, sizeof(d));
+#endif
+   return CRYPT_OK;
+}
+
 /**
   Performs a self-test of the Blowfish block cipher
   @return CRYPT_OK if functional, CRYPT_NOP if self-test has been disabled
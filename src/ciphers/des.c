@@ -12,6 +12,11 @@
 #define EN0 0
 #define DE1 1
 
+static int s_des_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+static int s_des_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey);
+static int s_des3_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey);
+static int s_des3_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey);
+
 const struct ltc_cipher_descriptor des_desc =
 {
     "des",
@@ -23,6 +28,7 @@ const struct ltc_cipher_descriptor des_desc =
     &des_test,
     &des_done,
     &des_keysize,
+    &s_des_accel_ecb_encrypt, &s_des_accel_ecb_decrypt,
     NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
 };
 
@@ -37,6 +43,7 @@ const struct ltc_cipher_descriptor des3_desc =
     &des3_test,
     &des3_done,
     &des3_keysize,
+    &s_des3_accel_ecb_encrypt, &s_des3_accel_ecb_decrypt,
     NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
 };
 
@@ -51,7 +58,7 @@ const struct ltc_cipher_descriptor desx_desc =
     &desx_test,
     &desx_done,
     &desx_keysize,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
 };
 
 static const ulong32 bytebit[8] =
@@ -1402,6 +1409,84 @@ static void cookey(const ulong32 *raw1, ulong32 *keyout)
 }
 #endif
 
+/* initial permutation of one block held in leftt/right */
+#ifdef LTC_SMALL_CODE
+#define DES_IP(leftt, right, work)                      \
+   do {                                                 \
+      work = ((leftt >> 4)  ^ right) & 0x0f0f0f0fL;     \
+      right ^= work;                                    \
+      leftt ^= (work << 4);                             \
+      work = ((leftt >> 16) ^ right) & 0x0000ffffL;     \
+      right ^= work;                                    \
+      leftt ^= (work << 16);                            \
+      work = ((right >> 2)  ^ leftt) & 0x33333333L;     \
+      leftt ^= work;                                    \
+      right ^= (work << 2);                             \
+      work = ((right >> 8)  ^ leftt) & 0x00ff00ffL;     \
+      leftt ^= work;                                    \
+      right ^= (work << 8);                             \
+      right = ROLc(right, 1);                           \
+      work = (leftt ^ right) & 0xaaaaaaaaL;             \
+      leftt ^= work;                                    \
+      right ^= work;                                    \
+      leftt = ROLc(leftt, 1);                           \
+   } while (0)
+
+#define DES_FP(leftt, right, work)                      \
+   do {                                                 \
+      right = RORc(right, 1);                           \
+      work = (leftt ^ right) & 0xaaaaaaaaL;             \
+      leftt ^= work;                                    \
+      right ^= work;                                    \
+      leftt = RORc(leftt, 1);                           \
+      work = ((leftt >> 8) ^ right) & 0x00ff00ffL;      \
+      right ^= work;                                    \
+      leftt ^= (work << 8);                             \
+      work = ((leftt >> 2) ^ right) & 0x33333333L;      \
+      right ^= work;                                    \
+      leftt ^= (work << 2);                             \
+      work = ((right >> 16) ^ leftt) & 0x0000ffffL;     \
+      leftt ^= work;                                    \
+      right ^= (work << 16);                            \
+      work = ((right >> 4) ^ leftt) & 0x0f0f0f0fL;      \
+      leftt ^= work;                                    \
+      right ^= (work << 4);                             \
+   } while (0)
+#else
+#define DES_PERM(tab, leftt, right)                     \
+   do {                                                 \
+      ulong64 tmp_;                                     \
+      tmp_ = tab[0][LTC_BYTE(leftt, 0)] ^               \
+             tab[1][LTC_BYTE(leftt, 1)] ^               \
+             tab[2][LTC_BYTE(leftt, 2)] ^               \
+             tab[3][LTC_BYTE(leftt, 3)] ^               \
+             tab[4][LTC_BYTE(right, 0)] ^               \
+             tab[5][LTC_BYTE(right, 1)] ^               \
+             tab[6][LTC_BYTE(right, 2)] ^               \
+             tab[7][LTC_BYTE(right, 3)];                \
+      leftt = (ulong32)(tmp_ >> 32);                    \
+      right = (ulong32)(tmp_ & 0xFFFFFFFFUL);           \
+   } while (0)
+
+#define DES_IP(leftt, right, work) DES_PERM(des_ip, leftt, right)
+#define DES_FP(leftt, right, work) DES_PERM(des_fp, leftt, right)
+#endif
+
+/* one Feistel round, dst ^= f(src, keys[0..1]) */
+#define DES_F(dst, src, keys, work)                     \
+   do {                                                 \
+      work  = RORc(src, 4) ^ (keys)[0];                 \
+      dst  ^= SP7[ work        & 0x3fL]                 \
+           ^  SP5[(work >>  8) & 0x3fL]                 \
+           ^  SP3[(work >> 16) & 0x3fL]                 \
+           ^  SP1[(work >> 24) & 0x3fL];                \
+      work  = src ^ (keys)[1];                          \
+      dst  ^= SP8[ work        & 0x3fL]                 \
+           ^  SP6[(work >>  8) & 0x3fL]                 \
+           ^  SP4[(work >> 16) & 0x3fL]                 \
+           ^  SP2[(work >> 24) & 0x3fL];                \
+   } while (0)
+
 #ifndef LTC_CLEAN_STACK
 static void desfunc(ulong32 *block, const ulong32 *keys)
 #else
@@ -1414,116 +1499,146 @@ static void s_desfunc(ulong32 *block, const ulong32 *keys)
     leftt = block[0];
     right = block[1];
 
-#ifdef LTC_SMALL_CODE
-    work = ((leftt >> 4)  ^ right) & 0x0f0f0f0fL;
-    right ^= work;
-    leftt ^= (work << 4);
+    DES_IP(leftt, right, work);
 
-    work = ((leftt >> 16) ^ right) & 0x0000ffffL;
-    right ^= work;
-    leftt ^= (work << 16);
+    for (cur_round = 0; cur_round < 8; cur_round++) {
+        DES_F(leftt, right, keys, work);
+        DES_F(right, leftt, keys + 2, work);
+        keys += 4;
+    }
 
-    work = ((right >> 2)  ^ leftt) & 0x33333333L;
-    leftt ^= work;
-    right ^= (work << 2);
+    DES_FP(leftt, right, work);
 
-    work = ((right >> 8)  ^ leftt) & 0x00ff00ffL;
-    leftt ^= work;
-    right ^= (work << 8);
+    block[0] = right;
+    block[1] = leftt;
+}
 
-    right = ROLc(right, 1);
-    work = (leftt ^ right) & 0xaaaaaaaaL;
+#ifdef LTC_CLEAN_STACK
+static void desfunc(ulong32 *block, const ulong32 *keys)
+{
+   s_desfunc(block, keys);
+   burn_stack(sizeof(ulong32) * 4 + sizeof(int));
+}
+#endif
 
-    leftt ^= work;
-    right ^= work;
-    leftt = ROLc(leftt, 1);
+/* two blocks at once, the rounds of both are interleaved so that their table lookups overlap */
+#ifndef LTC_CLEAN_STACK
+static void desfunc2(ulong32 *block, const ulong32 *keys)
 #else
-   {
-      ulong64 tmp;
-      tmp = des_ip[0][LTC_BYTE(leftt, 0)] ^
-            des_ip[1][LTC_BYTE(leftt, 1)] ^
-            des_ip[2][LTC_BYTE(leftt, 2)] ^
-            des_ip[3][LTC_BYTE(leftt, 3)] ^
-            des_ip[4][LTC_BYTE(right, 0)] ^
-            des_ip[5][LTC_BYTE(right, 1)] ^
-            des_ip[6][LTC_BYTE(right, 2)] ^
-            des_ip[7][LTC_BYTE(right, 3)];
-      leftt = (ulong32)(tmp >> 32);
-      right = (ulong32)(tmp & 0xFFFFFFFFUL);
-   }
+static void s_desfunc2(ulong32 *block, const ulong32 *keys)
 #endif
+{
+    ulong32 work0, right0, leftt0, work1, right1, leftt1;
+    int cur_round;
+
+    leftt0 = block[0];
+    right0 = block[1];
+    leftt1 = block[2];
+    right1 = block[3];
+
+    DES_IP(leftt0, right0, work0);
+    DES_IP(leftt1, right1, work1);
 
     for (cur_round = 0; cur_round < 8; cur_round++) {
-        work  = RORc(right, 4) ^ *keys++;
-        leftt ^= SP7[work        & 0x3fL]
-              ^  SP5[(work >>  8) & 0x3fL]
-              ^  SP3[(work >> 16) & 0x3fL]
-              ^  SP1[(work >> 24) & 0x3fL];
-        work  = right ^ *keys++;
-        leftt ^= SP8[ work        & 0x3fL]
-              ^  SP6[(work >>  8) & 0x3fL]
-              ^  SP4[(work >> 16) & 0x3fL]
-              ^  SP2[(work >> 24) & 0x3fL];
-
-        work = RORc(leftt, 4) ^ *keys++;
-        right ^= SP7[ work        & 0x3fL]
-              ^  SP5[(work >>  8) & 0x3fL]
-              ^  SP3[(work >> 16) & 0x3fL]
-              ^  SP1[(work >> 24) & 0x3fL];
-        work  = leftt ^ *keys++;
-        right ^= SP8[ work        & 0x3fL]
-              ^  SP6[(work >>  8) & 0x3fL]
-              ^  SP4[(work >> 16) & 0x3fL]
-              ^  SP2[(work >> 24) & 0x3fL];
+        DES_F(leftt0, right0, keys, work0);
+        DES_F(leftt1, right1, keys, work1);
+        DES_F(right0, leftt0, keys + 2, work0);
+        DES_F(right1, leftt1, keys + 2, work1);
+        keys += 4;
     }
 
-#ifdef LTC_SMALL_CODE
-    right = RORc(right, 1);
-    work = (leftt ^ right) & 0xaaaaaaaaL;
-    leftt ^= work;
-    right ^= work;
-    leftt = RORc(leftt, 1);
-    work = ((leftt >> 8) ^ right) & 0x00ff00ffL;
-    right ^= work;
-    leftt ^= (work << 8);
-    /* -- */
-    work = ((leftt >> 2) ^ right) & 0x33333333L;
-    right ^= work;
-    leftt ^= (work << 2);
-    work = ((right >> 16) ^ leftt) & 0x0000ffffL;
-    leftt ^= work;
-    right ^= (work << 16);
-    work = ((right >> 4) ^ leftt) & 0x0f0f0f0fL;
-    leftt ^= work;
-    right ^= (work << 4);
-#else
-   {
-      ulong64 tmp;
-      tmp = des_fp[0][LTC_BYTE(leftt, 0)] ^
-            des_fp[1][LTC_BYTE(leftt, 1)] ^
-            des_fp[2][LTC_BYTE(leftt, 2)] ^
-            des_fp[3][LTC_BYTE(leftt, 3)] ^
-            des_fp[4][LTC_BYTE(right, 0)] ^
-            des_fp[5][LTC_BYTE(right, 1)] ^
-            des_fp[6][LTC_BYTE(right, 2)] ^
-            des_fp[7][LTC_BYTE(right, 3)];
-      leftt = (ulong32)(tmp >> 32);
-      right = (ulong32)(tmp & 0xFFFFFFFFUL);
-   }
-#endif
+    DES_FP(leftt0, right0, work0);
+    DES_FP(leftt1, right1, work1);
 
-    block[0] = right;
-    block[1] = leftt;
+    block[0] = right0;
+    block[1] = leftt0;
+    block[2] = right1;
+    block[3] = leftt1;
 }
 
 #ifdef LTC_CLEAN_STACK
-static void desfunc(ulong32 *block, const ulong32 *keys)
+static void desfunc2(ulong32 *block, const ulong32 *keys)
 {
-   s_desfunc(block, keys);
-   burn_stack(sizeof(ulong32) * 4 + sizeof(int));
+   s_desfunc2(block, keys);
+   burn_stack(sizeof(ulong32) * 8 + sizeof(int));
 }
 #endif
 
+/* 1DES or 3DES over several blocks, two at a time */
+static void s_des_blocks(const unsigned char *in, unsigned char *out, unsigned long blocks,
+                         const ulong32 *k0, const ulong32 *k1, const ulong32 *k2)
+{
+    ulong32 work[4];
+
+    for (; blocks >= 2; blocks -= 2) {
+        LOAD32H(work[0], in+0);
+        LOAD32H(work[1], in+4);
+        LOAD32H(work[2], in+8);
+        LOAD32H(work[3], in+12);
+        desfunc2(work, k0);
+        if (k1 != NULL) {
+           desfunc2(work, k1);
+           desfunc2(work, k2);
+        }
+        STORE32H(work[0], out+0);
+        STORE32H(work[1], out+4);
+        STORE32H(work[2], out+8);
+        STORE32H(work[3], out+12);
+        in  += 16;
+        out += 16;
+    }
+    if (blocks != 0) {
+        LOAD32H(work[0], in+0);
+        LOAD32H(work[1], in+4);
+        desfunc(work, k0);
+        if (k1 != NULL) {
+           desfunc(work, k1);
+           desfunc(work, k2);
+        }
+        STORE32H(work[0], out+0);
+        STORE32H(work[1], out+4);
+    }
+#ifdef LTC_CLEAN_STACK
+    zeromem(work, sizeof(work));
+#endif
+}
+
+static int s_des_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey)
+{
+    LTC_ARGCHK(pt   != NULL);
+    LTC_ARGCHK(ct   != NULL);
+    LTC_ARGCHK(skey != NULL);
+    s_des_blocks(pt, ct, blocks, skey->des.ek, NULL, NULL);
+    return CRYPT_OK;
+}
+
+static int s_des_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey)
+{
+    LTC_ARGCHK(pt   != NULL);
+    LTC_ARGCHK(ct   != NULL);
+    LTC_ARGCHK(skey != NULL);
+    s_des_blocks(ct, pt, blocks, skey->des.dk, NULL, NULL);
+    return CRYPT_OK;
+}
+
+static int s_des3_accel_ecb_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_key *skey)
+{
+    LTC_ARGCHK(pt   != NULL);
+    LTC_ARGCHK(ct   != NULL);
+    LTC_ARGCHK(skey != NULL);
+    s_des_blocks(pt, ct, blocks, skey->des3.ek[0], skey->des3.ek[1], skey->des3.ek[2]);
+    return CRYPT_OK;
+}
+
+static int s_des3_accel_ecb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_key *skey)
+{
+    LTC_ARGCHK(pt   != NULL);
+    LTC_ARGCHK(ct   != NULL);
+    LTC_ARGCHK(skey != NULL);
+    s_des_blocks(ct, pt, blocks, skey->des3.dk[0], skey->des3.dk[1], skey->des3.dk[2]);
+    return CRYPT_OK;
+}
+
  /**
     Initialize the DES block cipher
     @param key The symmetric key you wish to pass
@@ -30,7 +30,7 @@ const struct ltc_cipher_descriptor idea_desc = {
    &idea_test,
    &idea_done,
    &idea_keysize,
-   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
 };
 
 typedef unsigned short int ushort16;
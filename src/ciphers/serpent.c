@@ -23,7 +23,7 @@ const struct ltc_cipher_descriptor serpent_desc = {
    &serpent_test,
    &serpent_done,
    &serpent_keysize,
-   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+   NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
 };
 
 /* linear transformation */
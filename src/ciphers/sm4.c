@@ -372,6 +372,7 @@ const struct ltc_cipher_descriptor sm4_desc = {
     &sm4_keysize,
     NULL, NULL, NULL, NULL, NULL, NULL, NULL,
     NULL, NULL, NULL, NULL, NULL, NULL, NULL,
+    NULL, NULL,
 };
 
 #endif      /*LTC_SM4*/
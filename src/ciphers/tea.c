@@ -20,7 +20,7 @@ const struct ltc_cipher_descriptor tea_desc =
     &tea_test,
     &tea_done,
     &tea_keysize,
-    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
+    NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL
 };
 
 #define DELTA 0x9E3779B9uL
@@ -0,0 +1,91 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file ccm_int_process_blocks.c
+  CCM support, process whole blocks with the CTR and CBC-MAC encryptions paired
+*/
+
+#ifdef LTC_CCM_MODE
+
+/*
+   Process complete blocks through CCM
+
+   The keystream block of the counter and the CBC-MAC block of the previous message block
+   do not depend on each other, so they are handed to the cipher in a single call.
+   That lets an accelerated or bitsliced cipher work on both at once instead of running
+   two serial single block encryptions per 16 octets.
+
+   On return the last message block is xor'ed into PAD but not encrypted yet, i.e. the
+   caller has to continue with x == 16, and CTRPAD holds the exhausted keystream block.
+
+   @param cipher     The index of the cipher
+   @param skey       The scheduled key
+   @param L          The CCM L value
+   @param ctr        [in/out] The counter block
+   @param CTRPAD     [out] The last keystream block
+   @param PAD        [in/out] The CBC-MAC chaining value
+   @param pending    Non-zero if PAD still has to be encrypted before the first block (x == 16)
+   @param pt         The plaintext
+   @param ct         The ciphertext
+   @param blocks     The number of complete blocks to process
+   @param direction  Encrypt or Decrypt mode (CCM_ENCRYPT or CCM_DECRYPT)
+   @return CRYPT_OK if successful
+*/
+int ccm_int_process_blocks(int cipher, const symmetric_key *skey, unsigned long L,
+                           unsigned char *ctr, unsigned char *CTRPAD, unsigned char *PAD, int pending,
+                           unsigned char *pt, unsigned char *ct, unsigned long blocks, int direction)
+{
+   unsigned char buf[32], b;
+   unsigned long y, z;
+   int err;
+
+   if (blocks == 0) {
+      return CRYPT_OK;
+   }
+
+   for (y = 0; y < blocks; y++) {
+      /* increment the ctr */
+      for (z = 15; z > 15-L; z--) {
+         ctr[z] = (ctr[z] + 1) & 255;
+         if (ctr[z]) break;
+      }
+
+      /* the keystream block and the CBC-MAC of the previous block go in together */
+      XMEMCPY(buf, ctr, 16);
+      if (pending) {
+         XMEMCPY(buf + 16, PAD, 16);
+      }
+      if ((err = cipher_ecb_encrypt_blocks(cipher, buf, buf, pending ? 2 : 1, skey)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+      if (pending) {
+         XMEMCPY(PAD, buf + 16, 16);
+      }
+
+      for (z = 0; z < 16; z++) {
+         if (direction == CCM_ENCRYPT) {
+            b     = pt[z];
+            ct[z] = b ^ buf[z];
+         } else {
+            b     = ct[z] ^ buf[z];
+            pt[z] = b;
+         }
+         PAD[z] ^= b;
+      }
+      pending = 1;
+      pt += 16;
+      ct += 16;
+   }
+   XMEMCPY(CTRPAD, buf, 16);
+   err = CRYPT_OK;
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(buf, sizeof(buf));
+#endif
+   return err;
+}
+
+#endif
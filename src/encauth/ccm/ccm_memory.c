@@ -230,8 +230,16 @@ int ccm_memory(int cipher,
    /* now handle the PT */
    if (ptlen > 0) {
       y = 0;
+      /* an accelerated cipher gets the keystream and the CBC-MAC block in one call */
+      if (ptlen >= 16 && cipher_ecb_blocks_accelerated(cipher)) {
+         y = ptlen & ~15uL;
+         if ((err = ccm_int_process_blocks(cipher, skey, L, ctr, CTRPAD, PAD, 0, pt, ct, y / 16, direction)) != CRYPT_OK) {
+            goto error;
+         }
+         x = 16;
+      }
 #ifdef LTC_FAST
-      if (ptlen & ~15)  {
+      else if (ptlen & ~15)  {
           if (direction == CCM_ENCRYPT) {
              for (; y < (ptlen & ~15); y += 16) {
                 /* increment the ctr? */
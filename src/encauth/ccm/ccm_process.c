@@ -40,7 +40,19 @@ int ccm_process(ccm_state *ccm,
       LTC_ARGCHK(pt != NULL);
       LTC_ARGCHK(ct != NULL);
 
-      for (y = 0; y < ptlen; y++) {
+      y = 0;
+      /* on a keystream block boundary an accelerated cipher gets whole blocks through the paired path */
+      if (ccm->CTRlen == 16 && (ccm->x == 0 || ccm->x == 16) && ptlen >= 16
+       && cipher_ecb_blocks_accelerated(ccm->cipher)) {
+         y = ptlen & ~15uL;
+         if ((err = ccm_int_process_blocks(ccm->cipher, &ccm->K, ccm->L, ccm->ctr, ccm->CTRPAD, ccm->PAD,
+                                           ccm->x == 16, pt, ct, y / 16, direction)) != CRYPT_OK) {
+            return err;
+         }
+         ccm->x = 16;
+      }
+
+      for (; y < ptlen; y++) {
          /* increment the ctr? */
          if (ccm->CTRlen == 16) {
             for (z = 15; z > 15-ccm->L; z--) {
@@ -0,0 +1,38 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+#ifdef LTC_CCM_MODE
+
+static int s_ccm_iov(void *st, const unsigned char *in, unsigned long inlen, unsigned char *out, int direction)
+{
+   /* ccm_process() doesn't write to its input */
+   if (direction == CCM_ENCRYPT) {
+      return ccm_process(st, (unsigned char *)in, inlen, out, direction);
+   }
+   return ccm_process(st, out, inlen, (unsigned char *)in, direction);
+}
+
+/**
+  Process plaintext/ciphertext through CCM, scattered over several segments
+  @param ccm       The CCM state
+  @param in        The input segments (plaintext when encrypting, ciphertext when decrypting)
+  @param incnt     The number of input segments
+  @param out       [out] The output segments, of the same total length, may equal in
+  @param outcnt    The number of output segments
+  @param direction Encrypt or Decrypt mode (CCM_ENCRYPT or CCM_DECRYPT)
+  @return CRYPT_OK on success
+ */
+int ccm_process_iov(ccm_state *ccm,
+                    const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    int direction)
+{
+   LTC_ARGCHK(ccm != NULL);
+   if (direction != CCM_ENCRYPT && direction != CCM_DECRYPT) {
+      return CRYPT_INVALID_ARG;
+   }
+   return ltc_iov_process(in, incnt, out, outcnt, 1, s_ccm_iov, NULL, ccm, direction);
+}
+
+#endif
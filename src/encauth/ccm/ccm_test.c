@@ -240,6 +240,101 @@ int ccm_test(void)
       }
    }
 
+   /* scattered over segments that neither match the blocks nor each other, decrypted in place */
+   for (x = 0; x < (sizeof(tests)/sizeof(tests[0])); x++) {
+      ltc_iovec vin[2], vout[3];
+      unsigned long a = (unsigned long)tests[x].ptlen / 3, b = (unsigned long)tests[x].ptlen / 2;
+
+      vin[0].data  = tests[x].pt;     vin[0].len  = a;
+      vin[1].data  = tests[x].pt + a; vin[1].len  = tests[x].ptlen - a;
+      vout[0].data = buf;             vout[0].len = b;
+      vout[1].data = NULL;            vout[1].len = 0;
+      vout[2].data = buf + b;         vout[2].len = tests[x].ptlen - b;
+
+      for (y = 0; y < 2; y++) {
+         if ((err = ccm_init(&ccm, idx, tests[x].key, 16, tests[x].ptlen, tests[x].taglen, tests[x].headerlen)) != CRYPT_OK) {
+            return err;
+         }
+         if ((err = ccm_add_nonce(&ccm, tests[x].nonce, tests[x].noncelen)) != CRYPT_OK) {
+            return err;
+         }
+         if ((err = ccm_add_aad(&ccm, tests[x].header, tests[x].headerlen)) != CRYPT_OK) {
+            return err;
+         }
+         if (y == 0) {
+            err = ccm_process_iov(&ccm, vin, 2, vout, 3, CCM_ENCRYPT);
+         } else {
+            err = ccm_process_iov(&ccm, vout, 3, vout, 3, CCM_DECRYPT);
+         }
+         if (err != CRYPT_OK) {
+            return err;
+         }
+         taglen = tests[x].taglen;
+         if ((err = ccm_done(&ccm, tag, &taglen)) != CRYPT_OK) {
+            return err;
+         }
+         if (compare_testvector(buf, tests[x].ptlen, y == 0 ? tests[x].ct : tests[x].pt, tests[x].ptlen, "CCM iov data", x)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+         if (compare_testvector(tag, taglen, tests[x].tag, tests[x].taglen, "CCM iov tag", x)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+   }
+
+   /* streamed with a block aligned split, the second call starts with the CBC-MAC of the first block pending */
+   {
+      static const unsigned char stream_tag[16] = {
+         0xf6, 0x41, 0xb2, 0x0b, 0x26, 0xb7, 0xa7, 0x5c, 0x34, 0x3f, 0x69, 0xa3, 0x66, 0x4c, 0x52, 0xe5
+      };
+      unsigned char pt[64];
+
+      for (x = 0; x < sizeof(pt); x++) {
+         pt[x] = (unsigned char)x;
+      }
+      taglen = sizeof(tag3);
+      if ((err = ccm_memory(idx, tests[0].key, 16, NULL, tests[0].nonce, tests[0].noncelen,
+                            tests[0].header, tests[0].headerlen, pt, sizeof(pt), buf2, tag3, &taglen, CCM_ENCRYPT)) != CRYPT_OK) {
+         return err;
+      }
+      if (compare_testvector(tag3, taglen, stream_tag, sizeof(stream_tag), "CCM stream memory tag", 0)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+      for (y = 0; y < 2; y++) {
+         if ((err = ccm_init(&ccm, idx, tests[0].key, 16, sizeof(pt), sizeof(stream_tag), tests[0].headerlen)) != CRYPT_OK) {
+            return err;
+         }
+         if ((err = ccm_add_nonce(&ccm, tests[0].nonce, tests[0].noncelen)) != CRYPT_OK) {
+            return err;
+         }
+         if ((err = ccm_add_aad(&ccm, tests[0].header, tests[0].headerlen)) != CRYPT_OK) {
+            return err;
+         }
+         if (y == 0) {
+            if ((err = ccm_process(&ccm, pt, 16, buf, CCM_ENCRYPT)) != CRYPT_OK) {
+               return err;
+            }
+            err = ccm_process(&ccm, pt + 16, sizeof(pt) - 16, buf + 16, CCM_ENCRYPT);
+         } else {
+            if ((err = ccm_process(&ccm, buf2, 16, buf, CCM_DECRYPT)) != CRYPT_OK) {
+               return err;
+            }
+            err = ccm_process(&ccm, buf2 + 16, sizeof(pt) - 16, buf + 16, CCM_DECRYPT);
+         }
+         if (err != CRYPT_OK) {
+            return err;
+         }
+         taglen = sizeof(tag);
+         if ((err = ccm_done(&ccm, tag, &taglen)) != CRYPT_OK) {
+            return err;
+         }
+         if (compare_testvector(y == 0 ? buf : buf2, sizeof(pt), y == 0 ? buf2 : pt, sizeof(pt), "CCM stream data", (int)y) ||
+             compare_testvector(tag, taglen, stream_tag, sizeof(stream_tag), "CCM stream tag", (int)y)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+   }
+
    /* wycheproof failing test - https://github.com/libtom/libtomcrypt/pull/452 */
    {
       unsigned char key[] = { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f };
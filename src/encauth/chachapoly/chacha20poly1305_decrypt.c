@@ -15,24 +15,7 @@
 */
 int chacha20poly1305_decrypt(chacha20poly1305_state *st, const unsigned char *in, unsigned long inlen, unsigned char *out)
 {
-   unsigned char padzero[16] = { 0 };
-   unsigned long padlen;
-   int err;
-
-   LTC_ARGCHK(st != NULL);
-
-   if (st->aadflg) {
-      padlen = 16 - (unsigned long)(st->aadlen % 16);
-      if (padlen < 16) {
-        if ((err = poly1305_process(&st->poly, padzero, padlen)) != CRYPT_OK) return err;
-      }
-      st->aadflg = 0; /* no more AAD */
-   }
-   if (st->aadflg) st->aadflg = 0; /* no more AAD */
-   if ((err = poly1305_process(&st->poly, in, inlen)) != CRYPT_OK)         return err;
-   if ((err = chacha_crypt(&st->chacha, in, inlen, out)) != CRYPT_OK)      return err;
-   st->ctlen += (ulong64)inlen;
-   return CRYPT_OK;
+   return chacha20poly1305_int_crypt(st, in, inlen, out, CHACHA20POLY1305_DECRYPT);
 }
 
 #endif
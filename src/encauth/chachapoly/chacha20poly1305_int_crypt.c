@@ -0,0 +1,60 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#include "tomcrypt_private.h"
+
+#ifdef LTC_CHACHA20POLY1305_MODE
+
+/* the data is processed in chunks of this many octets, small enough to stay in the L1 cache */
+#define CHACHA20POLY1305_CHUNK 512
+
+/**
+   Encrypt or decrypt and authenticate the ciphertext in one pass
+   Keystream generation, XOR and Poly1305 alternate on each chunk, so every octet
+   is still in the cache when it's authenticated.
+   @param st        The ChaCha20Poly1305 state
+   @param in        The input
+   @param inlen     The length of the input (octets)
+   @param out       [out] The output (length inlen), may equal in
+   @param direction CHACHA20POLY1305_ENCRYPT or CHACHA20POLY1305_DECRYPT
+   @return CRYPT_OK if successful
+*/
+int chacha20poly1305_int_crypt(chacha20poly1305_state *st, const unsigned char *in, unsigned long inlen,
+                               unsigned char *out, int direction)
+{
+   unsigned char padzero[16] = { 0 };
+   unsigned long padlen, n;
+   int err;
+
+   LTC_ARGCHK(st != NULL);
+
+   if (st->aadflg) {
+      padlen = 16 - (unsigned long)(st->aadlen % 16);
+      if (padlen < 16) {
+        if ((err = poly1305_process(&st->poly, padzero, padlen)) != CRYPT_OK) return err;
+      }
+      st->aadflg = 0; /* no more AAD */
+   }
+
+   /* end the first chunk on a chunk boundary of the stream, then ChaCha and Poly1305 only see whole blocks */
+   n = (CHACHA20POLY1305_CHUNK - (unsigned long)(st->ctlen % CHACHA20POLY1305_CHUNK));
+   while (inlen > 0) {
+      n = MIN(n, inlen);
+      if (direction == CHACHA20POLY1305_ENCRYPT) {
+         if ((err = chacha_crypt(&st->chacha, in, n, out)) != CRYPT_OK)      return err;
+         if ((err = poly1305_process(&st->poly, out, n)) != CRYPT_OK)        return err;
+      } else {
+         /* authenticate first, out may overwrite in */
+         if ((err = poly1305_process(&st->poly, in, n)) != CRYPT_OK)         return err;
+         if ((err = chacha_crypt(&st->chacha, in, n, out)) != CRYPT_OK)      return err;
+      }
+      st->ctlen += (ulong64)n;
+      in    += n;
+      out   += n;
+      inlen -= n;
+      n = CHACHA20POLY1305_CHUNK;
+   }
+   return CRYPT_OK;
+}
+
+#endif
@@ -0,0 +1,35 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#include "tomcrypt_private.h"
+
+#ifdef LTC_CHACHA20POLY1305_MODE
+
+static int s_chacha20poly1305_iov(void *st, const unsigned char *in, unsigned long inlen, unsigned char *out, int direction)
+{
+   return chacha20poly1305_int_crypt(st, in, inlen, out, direction);
+}
+
+/**
+   Encrypt or decrypt with ChaCha20Poly1305, scattered over several segments
+   @param st        The ChaCha20Poly1305 state
+   @param in        The input segments (plaintext when encrypting, ciphertext when decrypting)
+   @param incnt     The number of input segments
+   @param out       [out] The output segments, of the same total length, may equal in
+   @param outcnt    The number of output segments
+   @param direction CHACHA20POLY1305_ENCRYPT or CHACHA20POLY1305_DECRYPT
+   @return CRYPT_OK if successful
+*/
+int chacha20poly1305_process_iov(chacha20poly1305_state *st,
+                                 const ltc_iovec *in,  unsigned long incnt,
+                                 const ltc_iovec *out, unsigned long outcnt,
+                                 int direction)
+{
+   LTC_ARGCHK(st != NULL);
+   if (direction != CHACHA20POLY1305_ENCRYPT && direction != CHACHA20POLY1305_DECRYPT) {
+      return CRYPT_INVALID_ARG;
+   }
+   return ltc_iov_process(in, incnt, out, outcnt, 1, s_chacha20poly1305_iov, NULL, st, direction);
+}
+
+#endif
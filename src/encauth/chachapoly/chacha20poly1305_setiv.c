@@ -14,40 +14,33 @@
  */
 int chacha20poly1305_setiv(chacha20poly1305_state *st, const unsigned char *iv, unsigned long ivlen)
 {
-   chacha_state tmp_st;
-   int i, err;
-   unsigned char polykey[32];
+   unsigned char polykey[64];
+   int err;
 
    LTC_ARGCHK(st != NULL);
    LTC_ARGCHK(iv != NULL);
    LTC_ARGCHK(ivlen == 12 || ivlen == 8);
 
-   /* set IV for chacha20 */
+   /* set IV for chacha20, starting at block 0 */
    if (ivlen == 12) {
       /* IV 96bit */
-      if ((err = chacha_ivctr32(&st->chacha, iv, ivlen, 1)) != CRYPT_OK) return err;
+      if ((err = chacha_ivctr32(&st->chacha, iv, ivlen, 0)) != CRYPT_OK) return err;
    }
    else {
       /* IV 64bit */
-      if ((err = chacha_ivctr64(&st->chacha, iv, ivlen, 1)) != CRYPT_OK) return err;
+      if ((err = chacha_ivctr64(&st->chacha, iv, ivlen, 0)) != CRYPT_OK) return err;
    }
 
-   /* copy chacha20 key to temporary state */
-   for(i = 0; i < 12; i++) tmp_st.input[i] = st->chacha.input[i];
-   tmp_st.rounds = 20;
-   /* set IV */
-   if (ivlen == 12) {
-      /* IV 32bit */
-      if ((err = chacha_ivctr32(&tmp_st, iv, ivlen, 0)) != CRYPT_OK) return err;
+   /* block 0 provides the poly1305 key, this leaves the stream at the start of block 1 */
+   err = chacha_keystream(&st->chacha, polykey, sizeof(polykey));
+   if (err == CRYPT_OK) {
+      /* (re)initialise poly1305 */
+      err = poly1305_init(&st->poly, polykey, 32);
    }
-   else {
-      /* IV 64bit */
-      if ((err = chacha_ivctr64(&tmp_st, iv, ivlen, 0)) != CRYPT_OK) return err;
-   }
-   /* (re)generate new poly1305 key */
-   if ((err = chacha_keystream(&tmp_st, polykey, 32)) != CRYPT_OK) return err;
-   /* (re)initialise poly1305 */
-   if ((err = poly1305_init(&st->poly, polykey, 32)) != CRYPT_OK) return err;
+#ifdef LTC_CLEAN_STACK
+   zeromem(polykey, sizeof(polykey));
+#endif
+   if (err != CRYPT_OK) return err;
    st->ctlen  = 0;
    st->aadlen = 0;
    st->aadflg = 1;
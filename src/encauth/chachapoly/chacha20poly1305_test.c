@@ -117,6 +117,67 @@ int chacha20poly1305_test(void)
    if (compare_testvector(pt, mlen, m, mlen, "DEC-PT4", 1) != 0) return CRYPT_FAIL_TESTVECTOR;
    if (compare_testvector(dmac, len, emac, len, "DEC-TAG4", 2) != 0) return CRYPT_FAIL_TESTVECTOR;
 
+   /* a message over several chunks, in odd pieces and in place, has to match the one-shot result */
+   {
+      unsigned char buf[1000];
+      unsigned long x, off, pieces[] = { 1, 63, 100, 511, 7, 318 };
+      ltc_iovec vin[6], vout[2];
+
+      for (x = 0; x < sizeof(pt); x++) pt[x] = (unsigned char)(x * 7 + 3);
+      len = sizeof(emac);
+      if ((err = chacha20poly1305_memory(k, sizeof(k), i12, sizeof(i12), aad, sizeof(aad), pt,
+                                         sizeof(pt), ct, emac, &len, CHACHA20POLY1305_ENCRYPT)) != CRYPT_OK) return err;
+
+      XMEMCPY(buf, pt, sizeof(buf));
+      if ((err = chacha20poly1305_init(&st1, k, sizeof(k))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_setiv(&st1, i12, sizeof(i12))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_add_aad(&st1, aad, sizeof(aad))) != CRYPT_OK) return err;
+      for (x = off = 0; x < sizeof(pieces)/sizeof(pieces[0]); off += pieces[x++]) {
+         if ((err = chacha20poly1305_encrypt(&st1, buf + off, pieces[x], buf + off)) != CRYPT_OK) return err;
+      }
+      len = sizeof(dmac);
+      if ((err = chacha20poly1305_done(&st1, dmac, &len)) != CRYPT_OK) return err;
+      if (compare_testvector(buf, sizeof(buf), ct, sizeof(ct), "ENC-CT5", 1) != 0) return CRYPT_FAIL_TESTVECTOR;
+      if (compare_testvector(dmac, len, emac, len, "ENC-TAG5", 2) != 0) return CRYPT_FAIL_TESTVECTOR;
+
+      if ((err = chacha20poly1305_init(&st2, k, sizeof(k))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_setiv(&st2, i12, sizeof(i12))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_add_aad(&st2, aad, sizeof(aad))) != CRYPT_OK) return err;
+      for (x = off = 0; x < sizeof(pieces)/sizeof(pieces[0]); off += pieces[x++]) {
+         if ((err = chacha20poly1305_decrypt(&st2, buf + off, pieces[x], buf + off)) != CRYPT_OK) return err;
+      }
+      len = sizeof(dmac);
+      if ((err = chacha20poly1305_done(&st2, dmac, &len)) != CRYPT_OK) return err;
+      if (compare_testvector(buf, sizeof(buf), pt, sizeof(pt), "DEC-PT5", 3) != 0) return CRYPT_FAIL_TESTVECTOR;
+      if (compare_testvector(dmac, len, emac, len, "DEC-TAG5", 4) != 0) return CRYPT_FAIL_TESTVECTOR;
+
+      /* the same pieces as scatter-gather list, encrypting into differently cut segments and decrypting in place */
+      for (x = off = 0; x < sizeof(pieces)/sizeof(pieces[0]); off += pieces[x++]) {
+         vin[x].data = pt + off;
+         vin[x].len  = pieces[x];
+      }
+      vout[0].data = buf;       vout[0].len = 500;
+      vout[1].data = buf + 500; vout[1].len = sizeof(buf) - 500;
+      if ((err = chacha20poly1305_init(&st1, k, sizeof(k))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_setiv(&st1, i12, sizeof(i12))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_add_aad(&st1, aad, sizeof(aad))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_process_iov(&st1, vin, sizeof(pieces)/sizeof(pieces[0]), vout, 2,
+                                              CHACHA20POLY1305_ENCRYPT)) != CRYPT_OK) return err;
+      len = sizeof(dmac);
+      if ((err = chacha20poly1305_done(&st1, dmac, &len)) != CRYPT_OK) return err;
+      if (compare_testvector(buf, sizeof(buf), ct, sizeof(ct), "ENC-CT6", 1) != 0) return CRYPT_FAIL_TESTVECTOR;
+      if (compare_testvector(dmac, len, emac, len, "ENC-TAG6", 2) != 0) return CRYPT_FAIL_TESTVECTOR;
+
+      if ((err = chacha20poly1305_init(&st2, k, sizeof(k))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_setiv(&st2, i12, sizeof(i12))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_add_aad(&st2, aad, sizeof(aad))) != CRYPT_OK) return err;
+      if ((err = chacha20poly1305_process_iov(&st2, vout, 2, vout, 2, CHACHA20POLY1305_DECRYPT)) != CRYPT_OK) return err;
+      len = sizeof(dmac);
+      if ((err = chacha20poly1305_done(&st2, dmac, &len)) != CRYPT_OK) return err;
+      if (compare_testvector(buf, sizeof(buf), pt, sizeof(pt), "DEC-PT6", 3) != 0) return CRYPT_FAIL_TESTVECTOR;
+      if (compare_testvector(dmac, len, emac, len, "DEC-TAG6", 4) != 0) return CRYPT_FAIL_TESTVECTOR;
+   }
+
    /* wycheproof failing test - https://github.com/libtom/libtomcrypt/pull/451 */
    {
       unsigned char key[] = { 0x00,0x11,0x22,0x33,0x44,0x55,0x66,0x77,0x88,0x99,0xaa,0xbb,0xcc,0xdd,0xee,0xff,
@@ -0,0 +1,42 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/**
+   @file eax_process_iov.c
+   EAX implementation, process data given as scatter-gather lists
+*/
+#include "tomcrypt_private.h"
+
+#ifdef LTC_EAX_MODE
+
+static int s_eax_iov(void *st, const unsigned char *in, unsigned long inlen, unsigned char *out, int direction)
+{
+   if (direction == EAX_ENCRYPT) {
+      return eax_encrypt(st, in, out, inlen);
+   }
+   return eax_decrypt(st, in, out, inlen);
+}
+
+/**
+   Encrypt or decrypt with EAX, scattered over several segments
+   @param eax        The EAX state
+   @param in         The input segments (plaintext when encrypting, ciphertext when decrypting)
+   @param incnt      The number of input segments
+   @param out        [out] The output segments, of the same total length, may equal in
+   @param outcnt     The number of output segments
+   @param direction  EAX_ENCRYPT or EAX_DECRYPT
+   @return CRYPT_OK if successful
+*/
+int eax_process_iov(eax_state *eax,
+                    const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    int direction)
+{
+   LTC_ARGCHK(eax != NULL);
+   if (direction != EAX_ENCRYPT && direction != EAX_DECRYPT) {
+      return CRYPT_INVALID_ARG;
+   }
+   return ltc_iov_process(in, incnt, out, outcnt, 1, s_eax_iov, NULL, eax, direction);
+}
+
+#endif
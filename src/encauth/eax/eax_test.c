@@ -205,9 +205,11 @@ int eax_test(void)
 }
 
 };
-   int err, x, idx, res;
-   unsigned long len;
+   int err, x, y, idx, res;
+   unsigned long len, a, b;
    unsigned char outct[MAXBLOCKSIZE], outtag[MAXBLOCKSIZE];
+   ltc_iovec vin[2], vout[2];
+   eax_state eax;
 
     /* AES can be under rijndael or aes... try to find it */
     if ((idx = find_cipher("aes")) == -1) {
@@ -241,6 +243,31 @@ int eax_test(void)
            return CRYPT_FAIL_TESTVECTOR;
         }
 
+        /* the same through scattered segments, decrypted in place */
+        a = (unsigned long)tests[x].msglen / 3;
+        b = (unsigned long)tests[x].msglen / 2;
+        vin[0].data  = tests[x].plaintext;     vin[0].len  = a;
+        vin[1].data  = tests[x].plaintext + a; vin[1].len  = tests[x].msglen - a;
+        vout[0].data = outct;                  vout[0].len = b;
+        vout[1].data = outct + b;              vout[1].len = tests[x].msglen - b;
+        for (y = 0; y < 2; y++) {
+           if ((err = eax_init(&eax, idx, tests[x].key, tests[x].keylen, tests[x].nonce, tests[x].noncelen,
+                               tests[x].header, tests[x].headerlen)) != CRYPT_OK) {
+              return err;
+           }
+           if ((err = eax_process_iov(&eax, y == 0 ? vin : vout, 2, vout, 2, y == 0 ? EAX_ENCRYPT : EAX_DECRYPT)) != CRYPT_OK) {
+              return err;
+           }
+           len = sizeof(outtag);
+           if ((err = eax_done(&eax, outtag, &len)) != CRYPT_OK) {
+              return err;
+           }
+           if (compare_testvector(outct, tests[x].msglen, y == 0 ? tests[x].ciphertext : tests[x].plaintext,
+                                  tests[x].msglen, "EAX iov", x) ||
+               compare_testvector(outtag, len, tests[x].tag, len, "EAX iov Tag", x)) {
+              return CRYPT_FAIL_TESTVECTOR;
+           }
+        }
     }
     return CRYPT_OK;
 #endif /* LTC_TEST */
@@ -10,14 +10,14 @@
 #ifdef LTC_GCM_MODE
 
 /**
-  Add AAD to the GCM state
-  @param gcm       The GCM state
+  Add AAD to a GCM message
+  @param msg       The GCM message state
   @param adata     The additional authentication data to add to the GCM state
   @param adatalen  The length of the AAD data.
   @return CRYPT_OK on success
  */
-int gcm_add_aad(gcm_state *gcm,
-               const unsigned char *adata,  unsigned long adatalen)
+int gcm_msg_add_aad(gcm_msg_state *msg,
+                    const unsigned char *adata,  unsigned long adatalen)
 {
    unsigned long x;
    int           err;
@@ -25,71 +25,72 @@ int gcm_add_aad(gcm_state *gcm,
    unsigned long y;
 #endif
 
-   LTC_ARGCHK(gcm    != NULL);
+   LTC_ARGCHK(msg      != NULL);
+   LTC_ARGCHK(msg->key != NULL);
    if (adatalen > 0) {
-      LTC_ARGCHK(adata  != NULL);
+      LTC_ARGCHK(adata    != NULL);
    }
 
-   if (gcm->buflen > 16 || gcm->buflen < 0) {
+   if (msg->buflen > 16 || msg->buflen < 0) {
       return CRYPT_INVALID_ARG;
    }
 
-   if ((err = cipher_is_valid(gcm->cipher)) != CRYPT_OK) {
+   if ((err = cipher_is_valid(msg->key->cipher)) != CRYPT_OK) {
       return err;
    }
 
    /* in IV mode? */
-   if (gcm->mode == LTC_GCM_MODE_IV) {
+   if (msg->mode == LTC_GCM_MODE_IV) {
       /* IV length must be > 0 */
-      if (gcm->buflen == 0 && gcm->totlen == 0) return CRYPT_ERROR;
+      if (msg->buflen == 0 && msg->totlen == 0) return CRYPT_ERROR;
       /* let's process the IV */
-      if (gcm->ivmode || gcm->buflen != 12) {
-         for (x = 0; x < (unsigned long)gcm->buflen; x++) {
-             gcm->X[x] ^= gcm->buf[x];
+      if (msg->ivmode || msg->buflen != 12) {
+         for (x = 0; x < (unsigned long)msg->buflen; x++) {
+             msg->X[x] ^= msg->buf[x];
          }
-         if (gcm->buflen) {
-            gcm->totlen += gcm->buflen * CONST64(8);
-            gcm_mult_h(gcm, gcm->X);
+         if (msg->buflen) {
+            msg->totlen += msg->buflen * CONST64(8);
+            gcm_key_mult_h(msg->key, msg->X);
          }
 
          /* mix in the length */
-         zeromem(gcm->buf, 8);
-         STORE64H(gcm->totlen, gcm->buf+8);
+         zeromem(msg->buf, 8);
+         STORE64H(msg->totlen, msg->buf+8);
          for (x = 0; x < 16; x++) {
-             gcm->X[x] ^= gcm->buf[x];
+             msg->X[x] ^= msg->buf[x];
          }
-         gcm_mult_h(gcm, gcm->X);
+         gcm_key_mult_h(msg->key, msg->X);
 
          /* copy counter out */
-         XMEMCPY(gcm->Y, gcm->X, 16);
-         zeromem(gcm->X, 16);
+         XMEMCPY(msg->Y, msg->X, 16);
+         zeromem(msg->X, 16);
       } else {
-         XMEMCPY(gcm->Y, gcm->buf, 12);
-         gcm->Y[12] = 0;
-         gcm->Y[13] = 0;
-         gcm->Y[14] = 0;
-         gcm->Y[15] = 1;
+         XMEMCPY(msg->Y, msg->buf, 12);
+         msg->Y[12] = 0;
+         msg->Y[13] = 0;
+         msg->Y[14] = 0;
+         msg->Y[15] = 1;
       }
-      XMEMCPY(gcm->Y_0, gcm->Y, 16);
-      zeromem(gcm->buf, 16);
-      gcm->buflen = 0;
-      gcm->totlen = 0;
-      gcm->mode   = LTC_GCM_MODE_AAD;
+      XMEMCPY(msg->Y_0, msg->Y, 16);
+      zeromem(msg->buf, 16);
+      msg->buflen = 0;
+      msg->totlen = 0;
+      msg->mode   = LTC_GCM_MODE_AAD;
    }
 
-   if (gcm->mode != LTC_GCM_MODE_AAD || gcm->buflen >= 16) {
+   if (msg->mode != LTC_GCM_MODE_AAD || msg->buflen >= 16) {
       return CRYPT_INVALID_ARG;
    }
 
    x = 0;
 #ifdef LTC_FAST
-   if (gcm->buflen == 0 && adatalen > 15) {
+   if (msg->buflen == 0 && adatalen > 15) {
       for (x = 0; x < (adatalen & ~15); x += 16) {
           for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-              *(LTC_FAST_TYPE_PTR_CAST(&gcm->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&adata[x + y]));
+              *(LTC_FAST_TYPE_PTR_CAST(&msg->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&adata[x + y]));
           }
-          gcm_mult_h(gcm, gcm->X);
-          gcm->totlen += 128;
+          gcm_key_mult_h(msg->key, msg->X);
+          msg->totlen += 128;
       }
       adata += x;
    }
@@ -98,17 +99,32 @@ int gcm_add_aad(gcm_state *gcm,
 
    /* start adding AAD data to the state */
    for (; x < adatalen; x++) {
-      gcm->X[gcm->buflen++] ^= *adata++;
+      msg->X[msg->buflen++] ^= *adata++;
 
-      if (gcm->buflen == 16) {
+      if (msg->buflen == 16) {
          /* GF mult it */
-         gcm_mult_h(gcm, gcm->X);
-         gcm->buflen = 0;
-         gcm->totlen += 128;
+         gcm_key_mult_h(msg->key, msg->X);
+         msg->buflen = 0;
+         msg->totlen += 128;
       }
    }
 
    return CRYPT_OK;
 }
+
+/**
+  Add AAD to the GCM state
+  @param gcm       The GCM state
+  @param adata     The additional authentication data to add to the GCM state
+  @param adatalen  The length of the AAD data.
+  @return CRYPT_OK on success
+ */
+int gcm_add_aad(gcm_state *gcm,
+               const unsigned char *adata,  unsigned long adatalen)
+{
+   LTC_ARGCHK(gcm != NULL);
+   gcm->msg.key = &gcm->key;
+   return gcm_msg_add_aad(&gcm->msg, adata, adatalen);
+}
 #endif
 
@@ -10,51 +10,52 @@
 #ifdef LTC_GCM_MODE
 
 /**
-  Add IV data to the GCM state
-  @param gcm    The GCM state
+  Add IV data to a GCM message
+  @param msg    The GCM message state
   @param IV     The initial value data to add
   @param IVlen  The length of the IV
   @return CRYPT_OK on success
  */
-int gcm_add_iv(gcm_state *gcm,
-               const unsigned char *IV,     unsigned long IVlen)
+int gcm_msg_add_iv(gcm_msg_state *msg,
+                   const unsigned char *IV,     unsigned long IVlen)
 {
    unsigned long x, y;
    int           err;
 
-   LTC_ARGCHK(gcm != NULL);
+   LTC_ARGCHK(msg != NULL);
+   LTC_ARGCHK(msg->key != NULL);
    if (IVlen > 0) {
       LTC_ARGCHK(IV  != NULL);
    }
 
    /* must be in IV mode */
-   if (gcm->mode != LTC_GCM_MODE_IV) {
+   if (msg->mode != LTC_GCM_MODE_IV) {
       return CRYPT_INVALID_ARG;
    }
 
-   if (gcm->buflen >= 16 || gcm->buflen < 0) {
+   if (msg->buflen >= 16 || msg->buflen < 0) {
       return CRYPT_INVALID_ARG;
    }
 
-   if ((err = cipher_is_valid(gcm->cipher)) != CRYPT_OK) {
+   if ((err = cipher_is_valid(msg->key->cipher)) != CRYPT_OK) {
       return err;
    }
 
 
    /* trip the ivmode flag */
-   if (IVlen + gcm->buflen > 12) {
-      gcm->ivmode |= 1;
+   if (IVlen + msg->buflen > 12) {
+      msg->ivmode |= 1;
    }
 
    x = 0;
 #ifdef LTC_FAST
-   if (gcm->buflen == 0) {
+   if (msg->buflen == 0) {
       for (x = 0; x < (IVlen & ~15); x += 16) {
           for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-              *(LTC_FAST_TYPE_PTR_CAST(&gcm->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&IV[x + y]));
+              *(LTC_FAST_TYPE_PTR_CAST(&msg->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&IV[x + y]));
           }
-          gcm_mult_h(gcm, gcm->X);
-          gcm->totlen += 128;
+          gcm_key_mult_h(msg->key, msg->X);
+          msg->totlen += 128;
       }
       IV += x;
    }
@@ -62,21 +63,37 @@ int gcm_add_iv(gcm_state *gcm,
 
    /* start adding IV data to the state */
    for (; x < IVlen; x++) {
-       gcm->buf[gcm->buflen++] = *IV++;
+       msg->buf[msg->buflen++] = *IV++;
 
-      if (gcm->buflen == 16) {
+      if (msg->buflen == 16) {
          /* GF mult it */
          for (y = 0; y < 16; y++) {
-             gcm->X[y] ^= gcm->buf[y];
+             msg->X[y] ^= msg->buf[y];
          }
-         gcm_mult_h(gcm, gcm->X);
-         gcm->buflen = 0;
-         gcm->totlen += 128;
+         gcm_key_mult_h(msg->key, msg->X);
+         msg->buflen = 0;
+         msg->totlen += 128;
       }
    }
 
    return CRYPT_OK;
 }
 
+/**
+  Add IV data to the GCM state
+  @param gcm    The GCM state
+  @param IV     The initial value data to add
+  @param IVlen  The length of the IV
+  @return CRYPT_OK on success
+ */
+int gcm_add_iv(gcm_state *gcm,
+               const unsigned char *IV,     unsigned long IVlen)
+{
+   LTC_ARGCHK(gcm != NULL);
+   /* the state may have been copied, so refresh the reference to the embedded key */
+   gcm->msg.key = &gcm->key;
+   return gcm_msg_add_iv(&gcm->msg, IV, IVlen);
+}
+
 #endif
 
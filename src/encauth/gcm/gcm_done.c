@@ -10,68 +10,104 @@
 #ifdef LTC_GCM_MODE
 
 /**
-  Terminate a GCM stream
-  @param gcm     The GCM state
+  Terminate a GCM message, the key stays usable for further messages
+  @param msg     The GCM message state
   @param tag     [out] The destination for the MAC tag
   @param taglen  [in/out]  The length of the MAC tag
   @return CRYPT_OK on success
  */
-int gcm_done(gcm_state *gcm,
-                     unsigned char *tag,    unsigned long *taglen)
+int gcm_msg_done(gcm_msg_state *msg,
+                       unsigned char *tag,    unsigned long *taglen)
 {
    unsigned long x;
    int err;
 
-   LTC_ARGCHK(gcm     != NULL);
-   LTC_ARGCHK(tag     != NULL);
-   LTC_ARGCHK(taglen  != NULL);
+   LTC_ARGCHK(msg      != NULL);
+   LTC_ARGCHK(msg->key != NULL);
+   LTC_ARGCHK(tag      != NULL);
+   LTC_ARGCHK(taglen   != NULL);
 
-   if (gcm->buflen > 16 || gcm->buflen < 0) {
+   if (msg->buflen > 16 || msg->buflen < 0) {
       return CRYPT_INVALID_ARG;
    }
 
-   if ((err = cipher_is_valid(gcm->cipher)) != CRYPT_OK) {
+   if ((err = cipher_is_valid(msg->key->cipher)) != CRYPT_OK) {
       return err;
    }
 
-   if (gcm->mode == LTC_GCM_MODE_IV) {
+   if (msg->mode == LTC_GCM_MODE_IV) {
       /* let's process the IV */
-      if ((err = gcm_add_aad(gcm, NULL, 0)) != CRYPT_OK) return err;
+      if ((err = gcm_msg_add_aad(msg, NULL, 0)) != CRYPT_OK) return err;
    }
 
-   if (gcm->mode == LTC_GCM_MODE_AAD) {
+   if (msg->mode == LTC_GCM_MODE_AAD) {
       /* let's process the AAD */
-      if ((err = gcm_process(gcm, NULL, 0, NULL, 0)) != CRYPT_OK) return err;
+      if ((err = gcm_msg_process(msg, NULL, 0, NULL, 0)) != CRYPT_OK) return err;
    }
 
-   if (gcm->mode != LTC_GCM_MODE_TEXT) {
+   if (msg->mode != LTC_GCM_MODE_TEXT) {
       return CRYPT_INVALID_ARG;
    }
 
    /* handle remaining ciphertext */
-   if (gcm->buflen) {
-      gcm->pttotlen += gcm->buflen * CONST64(8);
-      gcm_mult_h(gcm, gcm->X);
+   if (msg->buflen) {
+      msg->pttotlen += msg->buflen * CONST64(8);
+      gcm_key_mult_h(msg->key, msg->X);
    }
 
    /* length */
-   STORE64H(gcm->totlen, gcm->buf);
-   STORE64H(gcm->pttotlen, gcm->buf+8);
+   STORE64H(msg->totlen, msg->buf);
+   STORE64H(msg->pttotlen, msg->buf+8);
    for (x = 0; x < 16; x++) {
-       gcm->X[x] ^= gcm->buf[x];
+       msg->X[x] ^= msg->buf[x];
    }
-   gcm_mult_h(gcm, gcm->X);
+   gcm_key_mult_h(msg->key, msg->X);
 
    /* encrypt original counter */
-   if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y_0, gcm->buf, &gcm->K)) != CRYPT_OK) {
+   if ((err = cipher_descriptor[msg->key->cipher].ecb_encrypt(msg->Y_0, msg->buf, &msg->key->K)) != CRYPT_OK) {
       return err;
    }
    for (x = 0; x < 16 && x < *taglen; x++) {
-       tag[x] = gcm->buf[x] ^ gcm->X[x];
+       tag[x] = msg->buf[x] ^ msg->X[x];
    }
    *taglen = x;
 
-   cipher_descriptor[gcm->cipher].done(&gcm->K);
+   return CRYPT_OK;
+}
+
+/**
+  Release a GCM key
+  @param key     The GCM key
+*/
+void gcm_key_done(gcm_key *key)
+{
+   LTC_ARGCHKVD(key != NULL);
+
+   if (cipher_is_valid(key->cipher) == CRYPT_OK) {
+      cipher_descriptor[key->cipher].done(&key->K);
+   }
+   zeromem(key, sizeof(*key));
+}
+
+/**
+  Terminate a GCM stream
+  @param gcm     The GCM state
+  @param tag     [out] The destination for the MAC tag
+  @param taglen  [in/out]  The length of the MAC tag
+  @return CRYPT_OK on success
+ */
+int gcm_done(gcm_state *gcm,
+                     unsigned char *tag,    unsigned long *taglen)
+{
+   int err;
+
+   LTC_ARGCHK(gcm != NULL);
+   gcm->msg.key = &gcm->key;
+   if ((err = gcm_msg_done(&gcm->msg, tag, taglen)) != CRYPT_OK) {
+      return err;
+   }
+
+   cipher_descriptor[gcm->key.cipher].done(&gcm->key.K);
 
    return CRYPT_OK;
 }
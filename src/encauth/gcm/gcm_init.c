@@ -9,25 +9,64 @@
 
 #ifdef LTC_GCM_MODE
 
+#ifdef LTC_GCM_TABLES
 /**
-  Initialize a GCM state
-  @param gcm     The GCM state to initialize
+  Build the multiplication tables of a GCM key (internal use only)
+  @param key     The GCM key, key->H has to be set
+ */
+void gcm_key_init_tables(gcm_key *key)
+{
+   int x, y, z, t;
+
+   /* the first table has no shifting, B[0] = 0x80 is H itself and every further bit is H times x */
+   XMEMCPY(&key->PC[0][0x80][0], key->H, 16);
+   for (y = 0x40; y > 0; y >>= 1) {
+      t = key->PC[0][y << 1][15] & 1;
+      for (z = 15; z > 0; z--) {
+         key->PC[0][y][z] = (unsigned char)((key->PC[0][y << 1][z] >> 1) | (key->PC[0][y << 1][z - 1] << 7));
+      }
+      key->PC[0][y][0] = (unsigned char)((key->PC[0][y << 1][0] >> 1) ^ (t ? 0xE1 : 0));
+   }
+   /* the product is linear in B[0], so the rest is the sum of the single bit entries */
+   zeromem(&key->PC[0][0][0], 16);
+   for (y = 3; y < 256; y++) {
+      if ((y & (y - 1)) == 0) {
+         continue;
+      }
+      for (z = 0; z < 16; z++) {
+         key->PC[0][y][z] = key->PC[0][y & (y - 1)][z] ^ key->PC[0][y & -y][z];
+      }
+   }
+
+   /* now generate the rest of the tables based the previous table */
+   for (x = 1; x < 16; x++) {
+      for (y = 0; y < 256; y++) {
+         /* now shift it right by 8 bits */
+         t = key->PC[x-1][y][15];
+         XMEMCPY(&key->PC[x][y][1], &key->PC[x-1][y][0], 15);
+         key->PC[x][y][0] = gcm_shift_table[t<<1];
+         key->PC[x][y][1] ^= gcm_shift_table[(t<<1)+1];
+      }
+   }
+}
+#endif
+
+/**
+  Initialize a GCM key, it can be shared by all messages that are processed under this key
+  @param key     The GCM key to initialize
   @param cipher  The index of the cipher to use
-  @param key     The secret key
+  @param K       The secret key
   @param keylen  The length of the secret key
   @return CRYPT_OK on success
  */
-int gcm_init(gcm_state *gcm, int cipher,
-             const unsigned char *key,  int keylen)
+int gcm_key_init(gcm_key *key, int cipher,
+                 const unsigned char *K, int keylen)
 {
    int           err;
    unsigned char B[16];
-#ifdef LTC_GCM_TABLES
-   int           x, y, z, t;
-#endif
 
-   LTC_ARGCHK(gcm != NULL);
    LTC_ARGCHK(key != NULL);
+   LTC_ARGCHK(K   != NULL);
 
 #ifdef LTC_FAST
    if (16 % sizeof(LTC_FAST_TYPE)) {
@@ -44,52 +83,44 @@ int gcm_init(gcm_state *gcm, int cipher,
    }
 
    /* schedule key */
-   if ((err = cipher_descriptor[cipher].setup(key, keylen, 0, &gcm->K)) != CRYPT_OK) {
+   if ((err = cipher_descriptor[cipher].setup(K, keylen, 0, &key->K)) != CRYPT_OK) {
       return err;
    }
 
    /* H = E(0) */
    zeromem(B, 16);
-   if ((err = cipher_descriptor[cipher].ecb_encrypt(B, gcm->H, &gcm->K)) != CRYPT_OK) {
+   if ((err = cipher_descriptor[cipher].ecb_encrypt(B, key->H, &key->K)) != CRYPT_OK) {
       return err;
    }
 
-   /* setup state */
-   zeromem(gcm->buf, sizeof(gcm->buf));
-   zeromem(gcm->X,   sizeof(gcm->X));
-   gcm->cipher   = cipher;
-   gcm->mode     = LTC_GCM_MODE_IV;
-   gcm->ivmode   = 0;
-   gcm->buflen   = 0;
-   gcm->totlen   = 0;
-   gcm->pttotlen = 0;
+   key->cipher = cipher;
 
 #ifdef LTC_GCM_TABLES
-   /* setup tables */
+   gcm_key_init_tables(key);
+#endif
 
-   /* generate the first table as it has no shifting (from which we make the other tables) */
-   zeromem(B, 16);
-   for (y = 0; y < 256; y++) {
-        B[0] = y;
-        gcm_gf_mult(gcm->H, B, &gcm->PC[0][y][0]);
-   }
+   return CRYPT_OK;
+}
 
-   /* now generate the rest of the tables based the previous table */
-   for (x = 1; x < 16; x++) {
-      for (y = 0; y < 256; y++) {
-         /* now shift it right by 8 bits */
-         t = gcm->PC[x-1][y][15];
-         for (z = 15; z > 0; z--) {
-             gcm->PC[x][y][z] = gcm->PC[x-1][y][z-1];
-         }
-         gcm->PC[x][y][0] = gcm_shift_table[t<<1];
-         gcm->PC[x][y][1] ^= gcm_shift_table[(t<<1)+1];
-      }
-   }
+/**
+  Initialize a GCM state
+  @param gcm     The GCM state to initialize
+  @param cipher  The index of the cipher to use
+  @param key     The secret key
+  @param keylen  The length of the secret key
+  @return CRYPT_OK on success
+ */
+int gcm_init(gcm_state *gcm, int cipher,
+             const unsigned char *key,  int keylen)
+{
+   int err;
 
-#endif
+   LTC_ARGCHK(gcm != NULL);
 
-   return CRYPT_OK;
+   if ((err = gcm_key_init(&gcm->key, cipher, key, keylen)) != CRYPT_OK) {
+      return err;
+   }
+   return gcm_msg_init(&gcm->msg, &gcm->key);
 }
 
 #endif
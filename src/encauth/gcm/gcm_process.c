@@ -10,141 +10,201 @@
 #ifdef LTC_GCM_MODE
 
 /**
-  Process plaintext/ciphertext through GCM
-  @param gcm       The GCM state
+  Process whole blocks of a GCM message, the counters of a batch are encrypted at once
+  @param msg       The GCM message state, with an empty buffer
   @param pt        The plaintext
-  @param ptlen     The plaintext length (ciphertext length is the same)
   @param ct        The ciphertext
+  @param blocks    The number of blocks, at most LTC_ECB_BATCH_BLOCKS
   @param direction Encrypt or Decrypt mode (GCM_ENCRYPT or GCM_DECRYPT)
   @return CRYPT_OK on success
  */
-int gcm_process(gcm_state *gcm,
-                     unsigned char *pt,     unsigned long ptlen,
-                     unsigned char *ct,
-                     int direction)
+static int s_gcm_process_blocks(gcm_msg_state *msg,
+                                unsigned char *pt, unsigned char *ct,
+                                unsigned long blocks, int direction)
 {
+   unsigned char buf[(LTC_ECB_BATCH_BLOCKS + 1) * 16], *ks;
    unsigned long x;
    int           y, err;
+
+   /* the pad of the first block is already in msg->buf, the one after the last block is kept for the next call */
+   XMEMCPY(buf, msg->buf, 16);
+   for (x = 1; x <= blocks; x++) {
+      /* increment counter */
+      for (y = 15; y >= 12; y--) {
+          if (++msg->Y[y] & 255) { break; }
+      }
+      XMEMCPY(buf + x * 16, msg->Y, 16);
+   }
+   if ((err = cipher_ecb_encrypt_blocks(msg->key->cipher, buf + 16, buf + 16, blocks, &msg->key->K)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+
+   for (x = 0; x < blocks; x++) {
+      ks = buf + x * 16;
+#ifdef LTC_FAST
+      if (direction == GCM_ENCRYPT) {
+         for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
+             *(LTC_FAST_TYPE_PTR_CAST(&ct[y])) = *(LTC_FAST_TYPE_PTR_CAST(&pt[y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&ks[y]));
+             *(LTC_FAST_TYPE_PTR_CAST(&msg->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&ct[y]));
+         }
+      } else {
+         for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
+             *(LTC_FAST_TYPE_PTR_CAST(&msg->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&ct[y]));
+             *(LTC_FAST_TYPE_PTR_CAST(&pt[y])) = *(LTC_FAST_TYPE_PTR_CAST(&ct[y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&ks[y]));
+         }
+      }
+#else
+      if (direction == GCM_ENCRYPT) {
+         for (y = 0; y < 16; y++) {
+             ct[y] = pt[y] ^ ks[y];
+             msg->X[y] ^= ct[y];
+         }
+      } else {
+         for (y = 0; y < 16; y++) {
+             msg->X[y] ^= ct[y];
+             pt[y] = ct[y] ^ ks[y];
+         }
+      }
+#endif
+      /* GMAC it */
+      msg->pttotlen += 128;
+      gcm_key_mult_h(msg->key, msg->X);
+      pt += 16;
+      ct += 16;
+   }
+   XMEMCPY(msg->buf, buf + blocks * 16, 16);
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(buf, sizeof(buf));
+#endif
+   return err;
+}
+
+/**
+  Process plaintext/ciphertext of a GCM message
+  @param msg       The GCM message state
+  @param pt        The plaintext
+  @param ptlen     The plaintext length (ciphertext length is the same)
+  @param ct        The ciphertext
+  @param direction Encrypt or Decrypt mode (GCM_ENCRYPT or GCM_DECRYPT)
+  @return CRYPT_OK on success
+ */
+int gcm_msg_process(gcm_msg_state *msg,
+                          unsigned char *pt,     unsigned long ptlen,
+                          unsigned char *ct,
+                          int direction)
+{
+   unsigned long x, n;
+   int           y, err;
    unsigned char b;
 
-   LTC_ARGCHK(gcm != NULL);
+   LTC_ARGCHK(msg != NULL);
+   LTC_ARGCHK(msg->key != NULL);
    if (ptlen > 0) {
       LTC_ARGCHK(pt  != NULL);
       LTC_ARGCHK(ct  != NULL);
    }
 
-   if (gcm->buflen > 16 || gcm->buflen < 0) {
+   if (msg->buflen > 16 || msg->buflen < 0) {
       return CRYPT_INVALID_ARG;
    }
 
-   if ((err = cipher_is_valid(gcm->cipher)) != CRYPT_OK) {
+   if ((err = cipher_is_valid(msg->key->cipher)) != CRYPT_OK) {
       return err;
    }
 
    /* 0xFFFFFFFE0 = ((2^39)-256)/8 */
-   if (gcm->pttotlen / 8 + (ulong64)gcm->buflen + (ulong64)ptlen >= CONST64(0xFFFFFFFE0)) {
+   if (msg->pttotlen / 8 + (ulong64)msg->buflen + (ulong64)ptlen >= CONST64(0xFFFFFFFE0)) {
       return CRYPT_INVALID_ARG;
    }
 
-   if (gcm->mode == LTC_GCM_MODE_IV) {
+   if (msg->mode == LTC_GCM_MODE_IV) {
       /* let's process the IV */
-      if ((err = gcm_add_aad(gcm, NULL, 0)) != CRYPT_OK) return err;
+      if ((err = gcm_msg_add_aad(msg, NULL, 0)) != CRYPT_OK) return err;
    }
 
    /* in AAD mode? */
-   if (gcm->mode == LTC_GCM_MODE_AAD) {
+   if (msg->mode == LTC_GCM_MODE_AAD) {
       /* let's process the AAD */
-      if (gcm->buflen) {
-         gcm->totlen += gcm->buflen * CONST64(8);
-         gcm_mult_h(gcm, gcm->X);
+      if (msg->buflen) {
+         msg->totlen += msg->buflen * CONST64(8);
+         gcm_key_mult_h(msg->key, msg->X);
       }
 
       /* increment counter */
       for (y = 15; y >= 12; y--) {
-          if (++gcm->Y[y] & 255) { break; }
+          if (++msg->Y[y] & 255) { break; }
       }
       /* encrypt the counter */
-      if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y, gcm->buf, &gcm->K)) != CRYPT_OK) {
+      if ((err = cipher_descriptor[msg->key->cipher].ecb_encrypt(msg->Y, msg->buf, &msg->key->K)) != CRYPT_OK) {
          return err;
       }
 
-      gcm->buflen = 0;
-      gcm->mode   = LTC_GCM_MODE_TEXT;
+      msg->buflen = 0;
+      msg->mode   = LTC_GCM_MODE_TEXT;
    }
 
-   if (gcm->mode != LTC_GCM_MODE_TEXT) {
+   if (msg->mode != LTC_GCM_MODE_TEXT) {
       return CRYPT_INVALID_ARG;
    }
 
    x = 0;
-#ifdef LTC_FAST
-   if (gcm->buflen == 0) {
-      if (direction == GCM_ENCRYPT) {
-         for (x = 0; x < (ptlen & ~15); x += 16) {
-             /* ctr encrypt */
-             for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-                 *(LTC_FAST_TYPE_PTR_CAST(&ct[x + y])) = *(LTC_FAST_TYPE_PTR_CAST(&pt[x+y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&gcm->buf[y]));
-                 *(LTC_FAST_TYPE_PTR_CAST(&gcm->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&ct[x+y]));
-             }
-             /* GMAC it */
-             gcm->pttotlen += 128;
-             gcm_mult_h(gcm, gcm->X);
-             /* increment counter */
-             for (y = 15; y >= 12; y--) {
-                 if (++gcm->Y[y] & 255) { break; }
-             }
-             if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y, gcm->buf, &gcm->K)) != CRYPT_OK) {
-                return err;
-             }
-         }
-      } else {
-         for (x = 0; x < (ptlen & ~15); x += 16) {
-             /* ctr encrypt */
-             for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-                 *(LTC_FAST_TYPE_PTR_CAST(&gcm->X[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&ct[x+y]));
-                 *(LTC_FAST_TYPE_PTR_CAST(&pt[x + y])) = *(LTC_FAST_TYPE_PTR_CAST(&ct[x+y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&gcm->buf[y]));
-             }
-             /* GMAC it */
-             gcm->pttotlen += 128;
-             gcm_mult_h(gcm, gcm->X);
-             /* increment counter */
-             for (y = 15; y >= 12; y--) {
-                 if (++gcm->Y[y] & 255) { break; }
-             }
-             if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y, gcm->buf, &gcm->K)) != CRYPT_OK) {
-                return err;
-             }
+   if (msg->buflen == 0) {
+      while (x < (ptlen & ~15)) {
+         n = MIN((ptlen - x) / 16, LTC_ECB_BATCH_BLOCKS);
+         if ((err = s_gcm_process_blocks(msg, pt + x, ct + x, n, direction)) != CRYPT_OK) {
+            return err;
          }
+         x += n * 16;
       }
    }
-#endif
 
    /* process text */
    for (; x < ptlen; x++) {
-       if (gcm->buflen == 16) {
-          gcm->pttotlen += 128;
-          gcm_mult_h(gcm, gcm->X);
+       if (msg->buflen == 16) {
+          msg->pttotlen += 128;
+          gcm_key_mult_h(msg->key, msg->X);
 
           /* increment counter */
           for (y = 15; y >= 12; y--) {
-              if (++gcm->Y[y] & 255) { break; }
+              if (++msg->Y[y] & 255) { break; }
           }
-          if ((err = cipher_descriptor[gcm->cipher].ecb_encrypt(gcm->Y, gcm->buf, &gcm->K)) != CRYPT_OK) {
+          if ((err = cipher_descriptor[msg->key->cipher].ecb_encrypt(msg->Y, msg->buf, &msg->key->K)) != CRYPT_OK) {
              return err;
           }
-          gcm->buflen = 0;
+          msg->buflen = 0;
        }
 
        if (direction == GCM_ENCRYPT) {
-          b = ct[x] = pt[x] ^ gcm->buf[gcm->buflen];
+          b = ct[x] = pt[x] ^ msg->buf[msg->buflen];
        } else {
           b = ct[x];
-          pt[x] = ct[x] ^ gcm->buf[gcm->buflen];
+          pt[x] = ct[x] ^ msg->buf[msg->buflen];
        }
-       gcm->X[gcm->buflen++] ^= b;
+       msg->X[msg->buflen++] ^= b;
    }
 
    return CRYPT_OK;
 }
 
+/**
+  Process plaintext/ciphertext through GCM
+  @param gcm       The GCM state
+  @param pt        The plaintext
+  @param ptlen     The plaintext length (ciphertext length is the same)
+  @param ct        The ciphertext
+  @param direction Encrypt or Decrypt mode (GCM_ENCRYPT or GCM_DECRYPT)
+  @return CRYPT_OK on success
+ */
+int gcm_process(gcm_state *gcm,
+                     unsigned char *pt,     unsigned long ptlen,
+                     unsigned char *ct,
+                     int direction)
+{
+   LTC_ARGCHK(gcm != NULL);
+   gcm->msg.key = &gcm->key;
+   return gcm_msg_process(&gcm->msg, pt, ptlen, ct, direction);
+}
+
 #endif
@@ -0,0 +1,63 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/**
+   @file gcm_process_iov.c
+   GCM implementation, process message data given as scatter-gather lists
+*/
+#include "tomcrypt_private.h"
+
+#ifdef LTC_GCM_MODE
+
+static int s_gcm_iov(void *st, const unsigned char *in, unsigned long inlen, unsigned char *out, int direction)
+{
+   /* gcm_msg_process() doesn't write to its input */
+   if (direction == GCM_ENCRYPT) {
+      return gcm_msg_process(st, (unsigned char *)in, inlen, out, direction);
+   }
+   return gcm_msg_process(st, out, inlen, (unsigned char *)in, direction);
+}
+
+/**
+  Process plaintext/ciphertext of a GCM message, scattered over several segments
+  @param msg       The GCM message state
+  @param in        The input segments (plaintext when encrypting, ciphertext when decrypting)
+  @param incnt     The number of input segments
+  @param out       [out] The output segments, of the same total length, may equal in
+  @param outcnt    The number of output segments
+  @param direction Encrypt or Decrypt mode (GCM_ENCRYPT or GCM_DECRYPT)
+  @return CRYPT_OK on success
+ */
+int gcm_msg_process_iov(gcm_msg_state *msg,
+                        const ltc_iovec *in,  unsigned long incnt,
+                        const ltc_iovec *out, unsigned long outcnt,
+                        int direction)
+{
+   LTC_ARGCHK(msg != NULL);
+   if (direction != GCM_ENCRYPT && direction != GCM_DECRYPT) {
+      return CRYPT_INVALID_ARG;
+   }
+   return ltc_iov_process(in, incnt, out, outcnt, 1, s_gcm_iov, NULL, msg, direction);
+}
+
+/**
+  Process plaintext/ciphertext through GCM, scattered over several segments
+  @param gcm       The GCM state
+  @param in        The input segments (plaintext when encrypting, ciphertext when decrypting)
+  @param incnt     The number of input segments
+  @param out       [out] The output segments, of the same total length, may equal in
+  @param outcnt    The number of output segments
+  @param direction Encrypt or Decrypt mode (GCM_ENCRYPT or GCM_DECRYPT)
+  @return CRYPT_OK on success
+ */
+int gcm_process_iov(gcm_state *gcm,
+                    const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    int direction)
+{
+   LTC_ARGCHK(gcm != NULL);
+   gcm->msg.key = &gcm->key;
+   return gcm_msg_process_iov(&gcm->msg, in, incnt, out, outcnt, direction);
+}
+
+#endif
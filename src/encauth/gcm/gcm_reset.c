@@ -9,6 +9,30 @@
 
 #ifdef LTC_GCM_MODE
 
+/**
+  Start a new message under a GCM key.
+  The key isn't modified by any of the gcm_msg_*() functions, it has to stay valid until the message is done.
+  @param msg   The message state to initialize
+  @param key   The GCM key as set up by gcm_key_init()
+  @return CRYPT_OK on success
+*/
+int gcm_msg_init(gcm_msg_state *msg, const gcm_key *key)
+{
+   LTC_ARGCHK(msg != NULL);
+   LTC_ARGCHK(key != NULL);
+
+   msg->key      = key;
+   zeromem(msg->buf, sizeof(msg->buf));
+   zeromem(msg->X,   sizeof(msg->X));
+   msg->mode     = LTC_GCM_MODE_IV;
+   msg->ivmode   = 0;
+   msg->buflen   = 0;
+   msg->totlen   = 0;
+   msg->pttotlen = 0;
+
+   return CRYPT_OK;
+}
+
 /**
   Reset a GCM state to as if you just called gcm_init().  This saves the initialization time.
   @param gcm   The GCM state to reset
@@ -18,15 +42,7 @@ int gcm_reset(gcm_state *gcm)
 {
    LTC_ARGCHK(gcm != NULL);
 
-   zeromem(gcm->buf, sizeof(gcm->buf));
-   zeromem(gcm->X,   sizeof(gcm->X));
-   gcm->mode     = LTC_GCM_MODE_IV;
-   gcm->ivmode   = 0;
-   gcm->buflen   = 0;
-   gcm->totlen   = 0;
-   gcm->pttotlen = 0;
-
-   return CRYPT_OK;
+   return gcm_msg_init(&gcm->msg, &gcm->key);
 }
 
 #endif
@@ -371,6 +371,132 @@ int gcm_test(void)
        }
    }
 
+   /* two messages interleaved under one shared key */
+   {
+      gcm_key *key;
+      gcm_msg_state msg[2];
+      unsigned long half;
+
+      if ((key = XMALLOC(sizeof(*key))) == NULL) {
+         return CRYPT_MEM;
+      }
+      for (x = 0; x < (int)(sizeof(tests)/sizeof(tests[0])); x++) {
+          half = tests[x].ptlen / 2;
+          if ((err = gcm_key_init(key, idx, tests[x].K, tests[x].keylen)) != CRYPT_OK) {
+             /* nothing to release in a key that failed to initialise */
+             XFREE(key);
+             return err;
+          }
+          if ((err = gcm_msg_init(&msg[0], key)) != CRYPT_OK)                                               goto LBL_KEY;
+          if ((err = gcm_msg_init(&msg[1], key)) != CRYPT_OK)                                               goto LBL_KEY;
+          if ((err = gcm_msg_add_iv(&msg[0], tests[x].IV, tests[x].IVlen)) != CRYPT_OK)                     goto LBL_KEY;
+          if ((err = gcm_msg_add_iv(&msg[1], tests[x].IV, tests[x].IVlen)) != CRYPT_OK)                     goto LBL_KEY;
+          if ((err = gcm_msg_add_aad(&msg[0], tests[x].A, tests[x].alen)) != CRYPT_OK)                      goto LBL_KEY;
+          if ((err = gcm_msg_add_aad(&msg[1], tests[x].A, tests[x].alen)) != CRYPT_OK)                      goto LBL_KEY;
+          if ((err = gcm_msg_process(&msg[0], (unsigned char*)tests[x].P, half, out[0], GCM_ENCRYPT)) != CRYPT_OK) goto LBL_KEY;
+          if ((err = gcm_msg_process(&msg[1], out[1], half, (unsigned char*)tests[x].C, GCM_DECRYPT)) != CRYPT_OK) goto LBL_KEY;
+          if ((err = gcm_msg_process(&msg[0], (unsigned char*)tests[x].P + half, tests[x].ptlen - half,
+                                     out[0] + half, GCM_ENCRYPT)) != CRYPT_OK)                              goto LBL_KEY;
+          if ((err = gcm_msg_process(&msg[1], out[1] + half, tests[x].ptlen - half,
+                                     (unsigned char*)tests[x].C + half, GCM_DECRYPT)) != CRYPT_OK)          goto LBL_KEY;
+          y = sizeof(T[0]);
+          if ((err = gcm_msg_done(&msg[0], T[0], &y)) != CRYPT_OK)                                          goto LBL_KEY;
+          y = sizeof(T[1]);
+          if ((err = gcm_msg_done(&msg[1], T[1], &y)) != CRYPT_OK)                                          goto LBL_KEY;
+          if (compare_testvector(out[0], tests[x].ptlen, tests[x].C, tests[x].ptlen, "GCM shared key CT", x)
+           || compare_testvector(out[1], tests[x].ptlen, tests[x].P, tests[x].ptlen, "GCM shared key PT", x)
+           || compare_testvector(T[0], 16, tests[x].T, 16, "GCM shared key Encrypt Tag", x)
+           || compare_testvector(T[1], 16, tests[x].T, 16, "GCM shared key Decrypt Tag", x)) {
+             err = CRYPT_FAIL_TESTVECTOR;
+             goto LBL_KEY;
+          }
+          gcm_key_done(key);
+      }
+LBL_KEY:
+      if (err != CRYPT_OK) {
+         gcm_key_done(key);
+      }
+      XFREE(key);
+      if (err != CRYPT_OK) {
+         return err;
+      }
+   }
+
+   /* scattered over segments that neither match the blocks nor each other, decrypted in place */
+   {
+      ltc_iovec vin[3], vout[2];
+      unsigned long a, b;
+
+      for (x = 0; x < (int)(sizeof(tests)/sizeof(tests[0])); x++) {
+          a = tests[x].ptlen / 3;
+          b = tests[x].ptlen / 2;
+          vin[0].data  = tests[x].P;     vin[0].len  = a;
+          vin[1].data  = NULL;           vin[1].len  = 0;
+          vin[2].data  = tests[x].P + a; vin[2].len  = tests[x].ptlen - a;
+          vout[0].data = out[0];         vout[0].len = b;
+          vout[1].data = out[0] + b;     vout[1].len = tests[x].ptlen - b;
+
+          if ((err = gcm_init(&gcm, idx, tests[x].K, tests[x].keylen)) != CRYPT_OK)           return err;
+          if ((err = gcm_add_iv(&gcm, tests[x].IV, tests[x].IVlen)) != CRYPT_OK)              return err;
+          if ((err = gcm_add_aad(&gcm, tests[x].A, tests[x].alen)) != CRYPT_OK)               return err;
+          if ((err = gcm_process_iov(&gcm, vin, 3, vout, 2, GCM_ENCRYPT)) != CRYPT_OK)        return err;
+          y = sizeof(T[0]);
+          if ((err = gcm_done(&gcm, T[0], &y)) != CRYPT_OK)                                   return err;
+          if (compare_testvector(out[0], tests[x].ptlen, tests[x].C, tests[x].ptlen, "GCM iov CT", x)) {
+             return CRYPT_FAIL_TESTVECTOR;
+          }
+
+          if ((err = gcm_init(&gcm, idx, tests[x].K, tests[x].keylen)) != CRYPT_OK)           return err;
+          if ((err = gcm_add_iv(&gcm, tests[x].IV, tests[x].IVlen)) != CRYPT_OK)              return err;
+          if ((err = gcm_add_aad(&gcm, tests[x].A, tests[x].alen)) != CRYPT_OK)               return err;
+          if ((err = gcm_process_iov(&gcm, vout, 2, vout, 2, GCM_DECRYPT)) != CRYPT_OK)       return err;
+          y = sizeof(T[1]);
+          if ((err = gcm_done(&gcm, T[1], &y)) != CRYPT_OK)                                   return err;
+          if (compare_testvector(out[0], tests[x].ptlen, tests[x].P, tests[x].ptlen, "GCM iov PT", x)
+           || compare_testvector(T[0], 16, tests[x].T, 16, "GCM iov Encrypt Tag", x)
+           || compare_testvector(T[1], 16, tests[x].T, 16, "GCM iov Decrypt Tag", x)) {
+             return CRYPT_FAIL_TESTVECTOR;
+          }
+      }
+   }
+
+   /* more blocks than one batch of counters, in one call and in pieces that leave the blocks at odd offsets */
+   {
+      unsigned char buf[3][341];
+      unsigned long pieces[] = { 3, 29, 160, 341 - 3 - 29 - 160 }, off;
+
+      for (x = 0; x < sizeof(buf[0]); x++) {
+         buf[0][x] = (unsigned char)(x * 7 + 1);
+      }
+      if ((err = gcm_init(&gcm, idx, tests[1].K, tests[1].keylen)) != CRYPT_OK)            return err;
+      if ((err = gcm_add_iv(&gcm, tests[1].IV, tests[1].IVlen)) != CRYPT_OK)               return err;
+      if ((err = gcm_process(&gcm, buf[0], sizeof(buf[0]), buf[1], GCM_ENCRYPT)) != CRYPT_OK) return err;
+      y = sizeof(T[0]);
+      if ((err = gcm_done(&gcm, T[0], &y)) != CRYPT_OK)                                    return err;
+
+      if ((err = gcm_init(&gcm, idx, tests[1].K, tests[1].keylen)) != CRYPT_OK)            return err;
+      if ((err = gcm_add_iv(&gcm, tests[1].IV, tests[1].IVlen)) != CRYPT_OK)               return err;
+      for (x = 0, off = 0; x < sizeof(pieces)/sizeof(pieces[0]); off += pieces[x++]) {
+         if ((err = gcm_process(&gcm, buf[0] + off, pieces[x], buf[2] + off, GCM_ENCRYPT)) != CRYPT_OK) return err;
+      }
+      y = sizeof(T[1]);
+      if ((err = gcm_done(&gcm, T[1], &y)) != CRYPT_OK)                                    return err;
+      if (compare_testvector(buf[2], sizeof(buf[2]), buf[1], sizeof(buf[1]), "GCM long CT", 0)
+       || compare_testvector(T[1], 16, T[0], 16, "GCM long Tag", 0)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+
+      if ((err = gcm_init(&gcm, idx, tests[1].K, tests[1].keylen)) != CRYPT_OK)            return err;
+      if ((err = gcm_add_iv(&gcm, tests[1].IV, tests[1].IVlen)) != CRYPT_OK)               return err;
+      if ((err = gcm_process(&gcm, buf[2], sizeof(buf[2]), buf[2], GCM_DECRYPT)) != CRYPT_OK) return err;
+      y = sizeof(T[1]);
+      if ((err = gcm_done(&gcm, T[1], &y)) != CRYPT_OK)                                    return err;
+      if (compare_testvector(buf[2], sizeof(buf[2]), buf[0], sizeof(buf[0]), "GCM long PT", 0)
+       || compare_testvector(T[1], 16, T[0], 16, "GCM long Decrypt Tag", 0)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+   }
+
    /* wycheproof failing test - https://github.com/libtom/libtomcrypt/pull/451 */
    {
       unsigned char key[] = { 0x00,0x01,0x02,0x03,0x04,0x05,0x06,0x07,0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f };
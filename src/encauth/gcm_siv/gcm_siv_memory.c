@@ -0,0 +1,307 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+   @file gcm_siv_memory.c
+   AES-GCM-SIV, nonce misuse-resistant authenticated encryption, RFC 8452
+*/
+
+#ifdef LTC_GCM_SIV_MODE
+
+#define GCM_SIV_BATCH LTC_ECB_BATCH_BLOCKS
+
+/* from this much POLYVAL input on it pays off to build the 64KiB multiplication tables for H */
+#define GCM_SIV_TABLES_MIN 4096
+
+/* everything a single GCM-SIV operation works on */
+struct gcm_siv_arena {
+   symmetric_key key;
+   gcm_key       *tab;       /* the tables for H, NULL when they're not used */
+   void          *tab_orig;  /* what was allocated for tab, before the alignment */
+   unsigned char auth_key[16],
+                 enc_key[32],
+                 H[16],      /* the authentication key as GHASH multiplier */
+                 S[16],      /* POLYVAL accumulator, in GHASH byte order */
+                 blk[GCM_SIV_BATCH][16],
+                 tag[16];
+};
+
+/*
+   POLYVAL(H, X) = ByteReverse(GHASH(mulX_GHASH(ByteReverse(H)), ByteReverse(X))), c.f. RFC 8452 Appendix A,
+   so POLYVAL runs on the GF(2^128) multiplication of GCM. For long inputs the same tables
+   as for a GCM key are built for the derived H, short ones don't amortize their setup.
+*/
+static int s_polyval_init(struct gcm_siv_arena *a, ulong64 inlen)
+{
+   int x;
+   unsigned char carry;
+
+   for (x = 0; x < 16; x++) {
+      a->H[x] = a->auth_key[15 - x];
+   }
+   /* multiply by x in the bit reflected representation of GHASH */
+   carry = a->H[15] & 1;
+   for (x = 15; x > 0; x--) {
+      a->H[x] = (unsigned char)((a->H[x] >> 1) | (a->H[x - 1] << 7));
+   }
+   a->H[0] >>= 1;
+   if (carry) {
+      a->H[0] ^= 0xE1;
+   }
+   zeromem(a->S, sizeof(a->S));
+
+#ifdef LTC_GCM_TABLES
+   if (inlen >= GCM_SIV_TABLES_MIN) {
+#ifndef LTC_GCM_TABLES_SSE2
+      a->tab_orig = a->tab = XMALLOC(sizeof(*a->tab));
+#else
+      a->tab_orig = a->tab = XMALLOC(sizeof(*a->tab) + 16);
+#endif
+      if (a->tab == NULL) {
+         return CRYPT_MEM;
+      }
+#ifdef LTC_GCM_TABLES_SSE2
+      /* the SSE2 multiplication loads PC with aligned loads */
+      a->tab = LTC_ALIGN_BUF(a->tab, 16);
+#endif
+      XMEMCPY(a->tab->H, a->H, 16);
+      gcm_key_init_tables(a->tab);
+   }
+#else
+   LTC_UNUSED_PARAM(inlen);
+#endif
+   return CRYPT_OK;
+}
+
+/* absorb data, a partial last block is padded with zeros */
+static void s_polyval_process(struct gcm_siv_arena *a, const unsigned char *in, unsigned long inlen)
+{
+   unsigned long n;
+   int x;
+
+   while (inlen > 0) {
+      n = MIN(inlen, 16);
+      for (x = 0; x < (int)n; x++) {
+         a->S[15 - x] ^= in[x];
+      }
+      if (a->tab != NULL) {
+         gcm_key_mult_h(a->tab, a->S);
+      } else {
+         gcm_gf_mult(a->S, a->H, a->S);
+      }
+      in    += n;
+      inlen -= n;
+   }
+}
+
+/* derive the per-nonce authentication and encryption keys */
+static int s_gcm_siv_derive(struct gcm_siv_arena *a, int cipher, const unsigned char *key, unsigned long keylen,
+                            const unsigned char *IV)
+{
+   unsigned long x, n;
+   int err;
+
+   if ((err = cipher_descriptor[cipher].setup(key, (int)keylen, 0, &a->key)) != CRYPT_OK) {
+      return err;
+   }
+   /* two blocks for the authentication key, two or four for the encryption key */
+   n = 2 + keylen / 8;
+   for (x = 0; x < n; x++) {
+      STORE32L((ulong32)x, a->blk[x]);
+      XMEMCPY(a->blk[x] + 4, IV, 12);
+   }
+   err = cipher_ecb_encrypt_blocks(cipher, a->blk[0], a->blk[0], n, &a->key);
+   cipher_descriptor[cipher].done(&a->key);
+   if (err != CRYPT_OK) {
+      return err;
+   }
+   /* only the first half of each block is used */
+   XMEMCPY(a->auth_key,     a->blk[0], 8);
+   XMEMCPY(a->auth_key + 8, a->blk[1], 8);
+   XMEMCPY(a->enc_key,      a->blk[2], 8);
+   XMEMCPY(a->enc_key + 8,  a->blk[3], 8);
+   if (keylen == 32) {
+      XMEMCPY(a->enc_key + 16, a->blk[4], 8);
+      XMEMCPY(a->enc_key + 24, a->blk[5], 8);
+   }
+
+   return cipher_descriptor[cipher].setup(a->enc_key, (int)keylen, 0, &a->key);
+}
+
+/* tag = E(POLYVAL(...) ^ nonce with the msb cleared), the POLYVAL input has to be absorbed already */
+static int s_gcm_siv_tag(struct gcm_siv_arena *a, int cipher, const unsigned char *IV,
+                         unsigned long adatalen, unsigned long ptlen)
+{
+   unsigned char len[16];
+   int x;
+
+   STORE64L((ulong64)adatalen * 8, len);
+   STORE64L((ulong64)ptlen * 8, len + 8);
+   s_polyval_process(a, len, 16);
+
+   for (x = 0; x < 16; x++) {
+      a->tag[x] = a->S[15 - x];
+   }
+   for (x = 0; x < 12; x++) {
+      a->tag[x] ^= IV[x];
+   }
+   a->tag[15] &= 0x7F;
+   return cipher_descriptor[cipher].ecb_encrypt(a->tag, a->tag, &a->key);
+}
+
+/* CTR with the tag as initial counter block, the counter is the first 32 bits as little endian value */
+static int s_gcm_siv_ctr(struct gcm_siv_arena *a, int cipher, const unsigned char *in, unsigned char *out,
+                         unsigned long len, int direction)
+{
+   unsigned long x, y, n, blocks;
+   ulong32 ctr;
+   int err;
+
+   LOAD32L(ctr, a->tag);
+   while (len > 0) {
+      blocks = MIN((len + 15) / 16, GCM_SIV_BATCH);
+      for (x = 0; x < blocks; x++) {
+         STORE32L(ctr, a->blk[x]);
+         XMEMCPY(a->blk[x] + 4, a->tag + 4, 11);
+         a->blk[x][15] = a->tag[15] | 0x80;
+         ctr = (ctr + 1) & 0xFFFFFFFFUL;
+      }
+      if ((err = cipher_ecb_encrypt_blocks(cipher, a->blk[0], a->blk[0], blocks, &a->key)) != CRYPT_OK) {
+         return err;
+      }
+      n = MIN(len, blocks * 16);
+      for (y = 0; y < n; y++) {
+         out[y] = in[y] ^ a->blk[y / 16][y % 16];
+      }
+      /* the plaintext is only known after decryption */
+      if (direction == GCM_SIV_DECRYPT) {
+         s_polyval_process(a, out, n);
+      }
+      in  += n;
+      out += n;
+      len -= n;
+   }
+   return CRYPT_OK;
+}
+
+/**
+  Process an entire GCM-SIV packet in one call.
+  @param cipher            Index of cipher to use, it has to be AES
+  @param key               The secret key
+  @param keylen            The length of the secret key (16 or 32 octets)
+  @param IV                The nonce
+  @param IVlen             The length of the nonce (must be 12)
+  @param adata             The additional authentication data (header)
+  @param adatalen          The length of the adata
+  @param pt                The plaintext
+  @param ptlen             The length of the plaintext (ciphertext length is the same)
+  @param ct                The ciphertext
+  @param tag               [in/out] The MAC tag, computed when encrypting and verified when decrypting
+  @param taglen            [in/out] The MAC tag length (16 octets)
+  @param direction         Encrypt or Decrypt mode (GCM_SIV_ENCRYPT or GCM_SIV_DECRYPT)
+  @return CRYPT_OK on success, CRYPT_ERROR if the tag doesn't match when decrypting
+ */
+int gcm_siv_memory(      int           cipher,
+                   const unsigned char *key,    unsigned long keylen,
+                   const unsigned char *IV,     unsigned long IVlen,
+                   const unsigned char *adata,  unsigned long adatalen,
+                         unsigned char *pt,     unsigned long ptlen,
+                         unsigned char *ct,
+                         unsigned char *tag,    unsigned long *taglen,
+                                   int direction)
+{
+   struct gcm_siv_arena *a;
+   int err;
+
+   LTC_ARGCHK(key    != NULL);
+   LTC_ARGCHK(IV     != NULL);
+   LTC_ARGCHK(tag    != NULL);
+   LTC_ARGCHK(taglen != NULL);
+   if (adatalen > 0) {
+      LTC_ARGCHK(adata != NULL);
+   }
+   if (ptlen > 0) {
+      LTC_ARGCHK(pt != NULL);
+      LTC_ARGCHK(ct != NULL);
+   }
+
+   if ((err = cipher_is_valid(cipher)) != CRYPT_OK) {
+      return err;
+   }
+   if (cipher_descriptor[cipher].block_length != 16) {
+      return CRYPT_INVALID_CIPHER;
+   }
+   if (keylen != 16 && keylen != 32) {
+      return CRYPT_INVALID_KEYSIZE;
+   }
+   if (IVlen != 12 || (direction != GCM_SIV_ENCRYPT && direction != GCM_SIV_DECRYPT)) {
+      return CRYPT_INVALID_ARG;
+   }
+   /* both lengths are limited to 2^36 octets */
+   if ((ulong64)ptlen > CONST64(0x1000000000) || (ulong64)adatalen > CONST64(0x1000000000)) {
+      return CRYPT_INVALID_ARG;
+   }
+   if (direction == GCM_SIV_ENCRYPT && *taglen < 16) {
+      *taglen = 16;
+      return CRYPT_BUFFER_OVERFLOW;
+   }
+   if (direction == GCM_SIV_DECRYPT && *taglen != 16) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   a = XMALLOC(sizeof(*a));
+   if (a == NULL) {
+      return CRYPT_MEM;
+   }
+   a->tab = NULL;
+   a->tab_orig = NULL;
+
+   if ((err = s_gcm_siv_derive(a, cipher, key, keylen, IV)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   if ((err = s_polyval_init(a, (ulong64)adatalen + ptlen)) != CRYPT_OK) {
+      goto LBL_DONE;
+   }
+   s_polyval_process(a, adata, adatalen);
+
+   if (direction == GCM_SIV_ENCRYPT) {
+      s_polyval_process(a, pt, ptlen);
+      if ((err = s_gcm_siv_tag(a, cipher, IV, adatalen, ptlen)) != CRYPT_OK) {
+         goto LBL_DONE;
+      }
+      if ((err = s_gcm_siv_ctr(a, cipher, pt, ct, ptlen, direction)) != CRYPT_OK) {
+         goto LBL_DONE;
+      }
+      XMEMCPY(tag, a->tag, 16);
+      *taglen = 16;
+   } else {
+      XMEMCPY(a->tag, tag, 16);
+      if ((err = s_gcm_siv_ctr(a, cipher, ct, pt, ptlen, direction)) != CRYPT_OK) {
+         goto LBL_DONE;
+      }
+      if ((err = s_gcm_siv_tag(a, cipher, IV, adatalen, ptlen)) != CRYPT_OK) {
+         goto LBL_DONE;
+      }
+      if (XMEM_NEQ(a->tag, tag, 16) != 0) {
+         /* don't release unauthenticated plaintext */
+         if (ptlen > 0) {
+            zeromem(pt, ptlen);
+         }
+         err = CRYPT_ERROR;
+      }
+   }
+
+LBL_DONE:
+   cipher_descriptor[cipher].done(&a->key);
+LBL_ERR:
+   if (a->tab != NULL) {
+      zeromem(a->tab, sizeof(*a->tab));
+      XFREE(a->tab_orig);
+   }
+   zeromem(a, sizeof(*a));
+   XFREE(a);
+   return err;
+}
+
+#endif
@@ -0,0 +1,184 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+   @file gcm_siv_test.c
+   AES-GCM-SIV, test vectors of RFC 8452
+*/
+
+#ifdef LTC_GCM_SIV_MODE
+
+/**
+  Test the GCM-SIV code
+  @return CRYPT_OK on success
+ */
+int gcm_siv_test(void)
+{
+#ifndef LTC_TEST
+   return CRYPT_NOP;
+#else
+   static const struct {
+      unsigned char K[32];
+      unsigned long keylen;
+      unsigned char N[12];
+      unsigned char A[16];
+      unsigned long alen;
+      unsigned char P[16];
+      unsigned long ptlen;
+      unsigned char C[16];
+      unsigned char T[16];
+   } tests[] = {
+      /* RFC 8452 C.1 AEAD_AES_128_GCM_SIV */
+      {
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 16,
+        { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00 },
+        { 0 }, 0,
+        { 0 }, 0,
+        { 0 },
+        { 0xdc, 0x20, 0xe2, 0xd8, 0x3f, 0x25, 0x70, 0x5b,
+          0xb4, 0x9e, 0x43, 0x9e, 0xca, 0x56, 0xde, 0x25 }
+      },
+      {
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 16,
+        { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00 },
+        { 0 }, 0,
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 8,
+        { 0xb5, 0xd8, 0x39, 0x33, 0x0a, 0xc7, 0xb7, 0x86 },
+        { 0x57, 0x87, 0x82, 0xff, 0xf6, 0x01, 0x3b, 0x81,
+          0x5b, 0x28, 0x7c, 0x22, 0x49, 0x3a, 0x36, 0x4c }
+      },
+      {
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 16,
+        { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00 },
+        { 0 }, 0,
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00 }, 12,
+        { 0x73, 0x23, 0xea, 0x61, 0xd0, 0x59, 0x32, 0x26,
+          0x00, 0x47, 0xd9, 0x42 },
+        { 0xa4, 0x97, 0x8d, 0xb3, 0x57, 0x39, 0x1a, 0x0b,
+          0xc4, 0xfd, 0xec, 0x8b, 0x0d, 0x10, 0x66, 0x39 }
+      },
+      {
+        { 0xee, 0x8e, 0x1e, 0xd9, 0xff, 0x25, 0x40, 0xae,
+          0x8f, 0x2b, 0xa9, 0xf5, 0x0b, 0xc2, 0xf2, 0x7c }, 16,
+        { 0x75, 0x2a, 0xba, 0xd3, 0xe0, 0xaf, 0xb5, 0xf4,
+          0x34, 0xdc, 0x43, 0x10 },
+        { 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65 }, 7,
+        { 0x48, 0x65, 0x6c, 0x6c, 0x6f, 0x20, 0x77, 0x6f,
+          0x72, 0x6c, 0x64 }, 11,
+        { 0x5d, 0x34, 0x9e, 0xad, 0x17, 0x5e, 0xf6, 0xb1,
+          0xde, 0xf6, 0xfd },
+        { 0x4f, 0xbc, 0xde, 0xb7, 0xe4, 0x79, 0x3f, 0x4a,
+          0x1d, 0x7e, 0x4f, 0xaa, 0x70, 0x10, 0x0a, 0xf1 }
+      },
+      /* RFC 8452 C.2 AEAD_AES_256_GCM_SIV */
+      {
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 32,
+        { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00 },
+        { 0 }, 0,
+        { 0 }, 0,
+        { 0 },
+        { 0x07, 0xf5, 0xf4, 0x16, 0x9b, 0xbf, 0x55, 0xa8,
+          0x40, 0x0c, 0xd4, 0x7e, 0xa6, 0xfd, 0x40, 0x0f }
+      },
+      {
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 32,
+        { 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+          0x00, 0x00, 0x00, 0x00 },
+        { 0 }, 0,
+        { 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 8,
+        { 0xc2, 0xef, 0x32, 0x8e, 0x5c, 0x71, 0xc8, 0x3b },
+        { 0x84, 0x31, 0x22, 0x13, 0x0f, 0x73, 0x64, 0xb7,
+          0x61, 0xe0, 0xb9, 0x74, 0x27, 0xe3, 0xdf, 0x28 }
+      }
+   };
+   /* 40 octets of AAD and 4113 octets of plaintext, both i*7, under the key and nonce of the first vector,
+      long enough to go through the multiplication tables (and their aligned loads in a LTC_GCM_TABLES_SSE2 build),
+      the tag is the one of the bitserial multiplication */
+   static const unsigned char long_T[16] = {
+      0x05, 0x73, 0x1f, 0x41, 0xa4, 0xb2, 0xf5, 0xda, 0x84, 0x8d, 0x83, 0xbd, 0xa0, 0x8c, 0x93, 0x31
+   };
+   unsigned char out[16], T[16], *buf;
+   unsigned long Tlen, n;
+   int idx, err, i;
+
+   idx = find_cipher("aes");
+   if (idx == -1) {
+      idx = find_cipher("rijndael");
+      if (idx == -1) {
+         return CRYPT_NOP;
+      }
+   }
+
+   for (i = 0; i < (int)(sizeof(tests)/sizeof(tests[0])); i++) {
+      Tlen = sizeof(T);
+      if ((err = gcm_siv_memory(idx, tests[i].K, tests[i].keylen, tests[i].N, 12, tests[i].A, tests[i].alen,
+                                (unsigned char *)tests[i].P, tests[i].ptlen, out, T, &Tlen, GCM_SIV_ENCRYPT)) != CRYPT_OK) {
+         return err;
+      }
+      if (compare_testvector(out, tests[i].ptlen, tests[i].C, tests[i].ptlen, "GCM-SIV CT", i) ||
+          compare_testvector(T, Tlen, tests[i].T, 16, "GCM-SIV Tag", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+
+      /* decrypt in place */
+      if ((err = gcm_siv_memory(idx, tests[i].K, tests[i].keylen, tests[i].N, 12, tests[i].A, tests[i].alen,
+                                out, tests[i].ptlen, out, T, &Tlen, GCM_SIV_DECRYPT)) != CRYPT_OK) {
+         return err;
+      }
+      if (compare_testvector(out, tests[i].ptlen, tests[i].P, tests[i].ptlen, "GCM-SIV PT", i)) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+
+      /* a modified tag is rejected and the plaintext is not released */
+      T[0] ^= 1;
+      XMEMCPY(out, tests[i].C, tests[i].ptlen);
+      if (gcm_siv_memory(idx, tests[i].K, tests[i].keylen, tests[i].N, 12, tests[i].A, tests[i].alen,
+                         out, tests[i].ptlen, out, T, &Tlen, GCM_SIV_DECRYPT) != CRYPT_ERROR) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+   }
+
+   if ((buf = XMALLOC(2 * 4113)) == NULL) {
+      return CRYPT_MEM;
+   }
+   for (n = 0; n < 4113; n++) {
+      buf[n] = (unsigned char)(n * 7);
+   }
+   Tlen = sizeof(T);
+   if ((err = gcm_siv_memory(idx, tests[0].K, 16, tests[0].N, 12, buf, 40, buf, 4113, buf + 4113,
+                             T, &Tlen, GCM_SIV_ENCRYPT)) != CRYPT_OK) {
+      goto LBL_LONG;
+   }
+   if (compare_testvector(T, Tlen, long_T, 16, "GCM-SIV long Tag", 0)) {
+      err = CRYPT_FAIL_TESTVECTOR;
+      goto LBL_LONG;
+   }
+   if ((err = gcm_siv_memory(idx, tests[0].K, 16, tests[0].N, 12, buf, 40, buf + 4113, 4113, buf + 4113,
+                             T, &Tlen, GCM_SIV_DECRYPT)) != CRYPT_OK) {
+      goto LBL_LONG;
+   }
+   if (compare_testvector(buf + 4113, 4113, buf, 4113, "GCM-SIV long PT", 0)) {
+      err = CRYPT_FAIL_TESTVECTOR;
+   }
+LBL_LONG:
+   XFREE(buf);
+   return err;
+#endif
+}
+
+#endif
@@ -10,29 +10,40 @@
 #ifdef LTC_OCB3_MODE
 
 /**
-   Add one block of AAD data (internal function)
+   Add full blocks of AAD data (internal function)
    @param ocb        The OCB state
-   @param aad_block  [in] AAD data (block_len size)
+   @param aad        [in] AAD data (blocks * block_len size)
+   @param blocks     The number of blocks
    @return CRYPT_OK if successful
 */
-static int s_ocb3_int_aad_add_block(ocb3_state *ocb, const unsigned char *aad_block)
+static int s_ocb3_int_aad_add_blocks(ocb3_state *ocb, const unsigned char *aad, unsigned long blocks)
 {
-   unsigned char tmp[MAXBLOCKSIZE];
-   int err;
-
-   /* Offset_i = Offset_{i-1} xor L_{ntz(i)} */
-   ocb3_int_xor_blocks(ocb->aOffset_current, ocb->aOffset_current, ocb->L_[ocb3_int_ntz(ocb->ablock_index)], ocb->block_len);
-
-   /* Sum_i = Sum_{i-1} xor ENCIPHER(K, A_i xor Offset_i) */
-   ocb3_int_xor_blocks(tmp, aad_block, ocb->aOffset_current, ocb->block_len);
-   if ((err = cipher_descriptor[ocb->cipher].ecb_encrypt(tmp, tmp, &ocb->key)) != CRYPT_OK) {
-     return err;
+   unsigned char tmp[LTC_ECB_BATCH_BLOCKS * MAXBLOCKSIZE];
+   unsigned long i, j, n;
+   int err = CRYPT_OK;
+
+   for (i = 0; i < blocks; i += n) {
+     n = MIN(blocks - i, LTC_ECB_BATCH_BLOCKS);
+     for (j = 0; j < n; j++) {
+       /* Offset_i = Offset_{i-1} xor L_{ntz(i)} */
+       ocb3_int_xor_blocks(ocb->aOffset_current, ocb->aOffset_current, ocb->L_[ocb3_int_ntz(ocb->ablock_index)], ocb->block_len);
+       ocb3_int_xor_blocks(tmp + j*ocb->block_len, aad + (i+j)*ocb->block_len, ocb->aOffset_current, ocb->block_len);
+       ocb->ablock_index++;
+     }
+     /* Sum_i = Sum_{i-1} xor ENCIPHER(K, A_i xor Offset_i) */
+     if ((err = cipher_ecb_encrypt_blocks(ocb->cipher, tmp, tmp, n, &ocb->key)) != CRYPT_OK) {
+       goto LBL_ERR;
+     }
+     for (j = 0; j < n; j++) {
+       ocb3_int_xor_blocks(ocb->aSum_current, ocb->aSum_current, tmp + j*ocb->block_len, ocb->block_len);
+     }
    }
-   ocb3_int_xor_blocks(ocb->aSum_current, ocb->aSum_current, tmp, ocb->block_len);
-
-   ocb->ablock_index++;
 
-   return CRYPT_OK;
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(tmp, sizeof(tmp));
+#endif
+   return err;
 }
 
 /**
@@ -44,7 +55,7 @@ static int s_ocb3_int_aad_add_block(ocb3_state *ocb, const unsigned char *aad_bl
 */
 int ocb3_add_aad(ocb3_state *ocb, const unsigned char *aad, unsigned long aadlen)
 {
-   int err, x, full_blocks, full_blocks_len, last_block_len;
+   int err, full_blocks, full_blocks_len, last_block_len;
    unsigned char *data;
    unsigned long datalen, l;
 
@@ -59,7 +70,7 @@ int ocb3_add_aad(ocb3_state *ocb, const unsigned char *aad, unsigned long aadlen
      ocb->adata_buffer_bytes += l;
 
      if (ocb->adata_buffer_bytes == ocb->block_len) {
-       if ((err = s_ocb3_int_aad_add_block(ocb, ocb->adata_buffer)) != CRYPT_OK) {
+       if ((err = s_ocb3_int_aad_add_blocks(ocb, ocb->adata_buffer, 1)) != CRYPT_OK) {
          return err;
        }
        ocb->adata_buffer_bytes = 0;
@@ -79,8 +90,8 @@ int ocb3_add_aad(ocb3_state *ocb, const unsigned char *aad, unsigned long aadlen
    full_blocks_len = full_blocks * ocb->block_len;
    last_block_len = datalen - full_blocks_len;
 
-   for (x=0; x<full_blocks; x++) {
-     if ((err = s_ocb3_int_aad_add_block(ocb, data+x*ocb->block_len)) != CRYPT_OK) {
+   if (full_blocks > 0) {
+     if ((err = s_ocb3_int_aad_add_blocks(ocb, data, full_blocks)) != CRYPT_OK) {
        return err;
      }
    }
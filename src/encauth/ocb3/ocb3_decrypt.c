@@ -19,8 +19,8 @@
 */
 int ocb3_decrypt(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen, unsigned char *pt)
 {
-   unsigned char tmp[MAXBLOCKSIZE];
-   int err, i, full_blocks;
+   unsigned char tmp[LTC_ECB_BATCH_BLOCKS * MAXBLOCKSIZE], off[LTC_ECB_BATCH_BLOCKS * MAXBLOCKSIZE];
+   int err, i, j, n, full_blocks;
    unsigned char *pt_b, *ct_b;
 
    LTC_ARGCHK(ocb != NULL);
@@ -40,28 +40,34 @@ int ocb3_decrypt(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen,
    }
 
    full_blocks = ctlen/ocb->block_len;
-   for(i=0; i<full_blocks; i++) {
+   /* the offsets are computed for a run of blocks, which are then decrypted in one go */
+   for(i=0; i<full_blocks; i+=n) {
+     n = MIN(full_blocks - i, LTC_ECB_BATCH_BLOCKS);
      pt_b = (unsigned char *)pt+i*ocb->block_len;
      ct_b = (unsigned char *)ct+i*ocb->block_len;
 
-     /* ocb->Offset_current[] = ocb->Offset_current[] ^ Offset_{ntz(block_index)} */
-     ocb3_int_xor_blocks(ocb->Offset_current, ocb->Offset_current, ocb->L_[ocb3_int_ntz(ocb->block_index)], ocb->block_len);
+     for(j=0; j<n; j++) {
+       /* ocb->Offset_current[] = ocb->Offset_current[] ^ Offset_{ntz(block_index)} */
+       ocb3_int_xor_blocks(ocb->Offset_current, ocb->Offset_current, ocb->L_[ocb3_int_ntz(ocb->block_index)], ocb->block_len);
+       XMEMCPY(off+j*ocb->block_len, ocb->Offset_current, ocb->block_len);
+       ocb->block_index++;
+     }
 
-     /* tmp[] = ct[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(tmp, ct_b, ocb->Offset_current, ocb->block_len);
+     /* tmp[] = ct[] XOR offsets[] */
+     ocb3_int_xor_blocks(tmp, ct_b, off, n*ocb->block_len);
 
      /* decrypt */
-     if ((err = cipher_descriptor[ocb->cipher].ecb_decrypt(tmp, tmp, &ocb->key)) != CRYPT_OK) {
+     if ((err = cipher_ecb_decrypt_blocks(ocb->cipher, tmp, tmp, n, &ocb->key)) != CRYPT_OK) {
         goto LBL_ERR;
      }
 
-     /* pt[] = tmp[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(pt_b, tmp, ocb->Offset_current, ocb->block_len);
-
-     /* ocb->checksum[] = ocb->checksum[] XOR pt[] */
-     ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt_b, ocb->block_len);
+     /* pt[] = tmp[] XOR offsets[] */
+     ocb3_int_xor_blocks(pt_b, tmp, off, n*ocb->block_len);
 
-     ocb->block_index++;
+     for(j=0; j<n; j++) {
+       /* ocb->checksum[] = ocb->checksum[] XOR pt[] */
+       ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt_b+j*ocb->block_len, ocb->block_len);
+     }
    }
 
    err = CRYPT_OK;
@@ -69,6 +75,7 @@ int ocb3_decrypt(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen,
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
    zeromem(tmp, sizeof(tmp));
+   zeromem(off, sizeof(off));
 #endif
    return err;
 }
@@ -19,8 +19,8 @@
 */
 int ocb3_encrypt(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen, unsigned char *ct)
 {
-   unsigned char tmp[MAXBLOCKSIZE];
-   int err, i, full_blocks;
+   unsigned char tmp[LTC_ECB_BATCH_BLOCKS * MAXBLOCKSIZE], off[LTC_ECB_BATCH_BLOCKS * MAXBLOCKSIZE];
+   int err, i, j, n, full_blocks;
    unsigned char *pt_b, *ct_b;
 
    LTC_ARGCHK(ocb != NULL);
@@ -40,28 +40,31 @@ int ocb3_encrypt(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen,
    }
 
    full_blocks = ptlen/ocb->block_len;
-   for(i=0; i<full_blocks; i++) {
+   /* the offsets are computed for a run of blocks, which are then encrypted in one go */
+   for(i=0; i<full_blocks; i+=n) {
+     n = MIN(full_blocks - i, LTC_ECB_BATCH_BLOCKS);
      pt_b = (unsigned char *)pt+i*ocb->block_len;
      ct_b = (unsigned char *)ct+i*ocb->block_len;
 
-     /* ocb->Offset_current[] = ocb->Offset_current[] ^ Offset_{ntz(block_index)} */
-     ocb3_int_xor_blocks(ocb->Offset_current, ocb->Offset_current, ocb->L_[ocb3_int_ntz(ocb->block_index)], ocb->block_len);
+     for(j=0; j<n; j++) {
+       /* ocb->Offset_current[] = ocb->Offset_current[] ^ Offset_{ntz(block_index)} */
+       ocb3_int_xor_blocks(ocb->Offset_current, ocb->Offset_current, ocb->L_[ocb3_int_ntz(ocb->block_index)], ocb->block_len);
+       XMEMCPY(off+j*ocb->block_len, ocb->Offset_current, ocb->block_len);
+       /* ocb->checksum[] = ocb->checksum[] XOR pt[] */
+       ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt_b+j*ocb->block_len, ocb->block_len);
+       ocb->block_index++;
+     }
 
-     /* tmp[] = pt[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(tmp, pt_b, ocb->Offset_current, ocb->block_len);
+     /* tmp[] = pt[] XOR offsets[] */
+     ocb3_int_xor_blocks(tmp, pt_b, off, n*ocb->block_len);
 
      /* encrypt */
-     if ((err = cipher_descriptor[ocb->cipher].ecb_encrypt(tmp, tmp, &ocb->key)) != CRYPT_OK) {
+     if ((err = cipher_ecb_encrypt_blocks(ocb->cipher, tmp, tmp, n, &ocb->key)) != CRYPT_OK) {
         goto LBL_ERR;
      }
 
-     /* ct[] = tmp[] XOR ocb->Offset_current[] */
-     ocb3_int_xor_blocks(ct_b, tmp, ocb->Offset_current, ocb->block_len);
-
-     /* ocb->checksum[] = ocb->checksum[] XOR pt[] */
-     ocb3_int_xor_blocks(ocb->checksum, ocb->checksum, pt_b, ocb->block_len);
-
-     ocb->block_index++;
+     /* ct[] = tmp[] XOR offsets[] */
+     ocb3_int_xor_blocks(ct_b, tmp, off, n*ocb->block_len);
    }
 
    err = CRYPT_OK;
@@ -69,6 +72,7 @@ int ocb3_encrypt(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen,
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
    zeromem(tmp, sizeof(tmp));
+   zeromem(off, sizeof(off));
 #endif
    return err;
 }
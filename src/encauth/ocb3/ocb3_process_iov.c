@@ -0,0 +1,53 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+/**
+   @file ocb3_process_iov.c
+   OCB implementation, process data given as scatter-gather lists
+*/
+#include "tomcrypt_private.h"
+
+#ifdef LTC_OCB3_MODE
+
+static int s_ocb3_iov(void *st, const unsigned char *in, unsigned long inlen, unsigned char *out, int direction)
+{
+   if (direction == OCB3_ENCRYPT) {
+      return ocb3_encrypt(st, in, inlen, out);
+   }
+   return ocb3_decrypt(st, in, inlen, out);
+}
+
+static int s_ocb3_iov_last(void *st, const unsigned char *in, unsigned long inlen, unsigned char *out, int direction)
+{
+   if (direction == OCB3_ENCRYPT) {
+      return ocb3_encrypt_last(st, in, inlen, out);
+   }
+   return ocb3_decrypt_last(st, in, inlen, out);
+}
+
+/**
+   Encrypt or decrypt the remaining data of an OCB stream, scattered over several segments
+   This finishes the stream like ocb3_encrypt_last() resp. ocb3_decrypt_last(), so it can only be
+   called once and ocb3_done() has to follow. The segments don't have to be multiples of the block length.
+   @param ocb        The OCB state
+   @param in         The input segments (plaintext when encrypting, ciphertext when decrypting)
+   @param incnt      The number of input segments
+   @param out        [out] The output segments, of the same total length, may equal in
+   @param outcnt     The number of output segments
+   @param direction  OCB3_ENCRYPT or OCB3_DECRYPT
+   @return CRYPT_OK if successful
+*/
+int ocb3_process_iov(ocb3_state *ocb,
+                     const ltc_iovec *in,  unsigned long incnt,
+                     const ltc_iovec *out, unsigned long outcnt,
+                     int direction)
+{
+   LTC_ARGCHK(ocb != NULL);
+   if (direction != OCB3_ENCRYPT && direction != OCB3_DECRYPT) {
+      return CRYPT_INVALID_ARG;
+   }
+   return ltc_iov_process(in, incnt, out, outcnt, (unsigned long)ocb->block_len,
+                          s_ocb3_iov, s_ocb3_iov_last, ocb, direction);
+}
+
+#endif
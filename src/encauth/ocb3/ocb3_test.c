@@ -201,6 +201,7 @@ int ocb3_test(void)
    unsigned char outct[MAXBLOCKSIZE]  = { 0 };
    unsigned char outtag[MAXBLOCKSIZE] = { 0 };
    ocb3_state ocb;
+   ltc_iovec vin[3], vout[3];
 
     /* AES can be under rijndael or aes... try to find it */
     if ((idx = find_cipher("aes")) == -1) {
@@ -292,6 +293,30 @@ int ocb3_test(void)
     if (compare_testvector(outct, sizeof(C), P, sizeof(P), "OCB3 PT", x))          return CRYPT_FAIL_TESTVECTOR;
     if (compare_testvector(outtag, len, T, sizeof(T), "OCB3 Tag.dec", x))          return CRYPT_FAIL_TESTVECTOR;
 
+    /* RFC 7253 - test vector with a tag length of 96 bits - part 3, scattered with blocks straddling the segments */
+    x = 101;
+    vin[0].data  = P;          vin[0].len  = 7;
+    vin[1].data  = P + 7;      vin[1].len  = 20;
+    vin[2].data  = P + 27;     vin[2].len  = sizeof(P) - 27;
+    vout[0].data = outct;      vout[0].len = 3;
+    vout[1].data = outct + 3;  vout[1].len = 30;
+    vout[2].data = outct + 33; vout[2].len = sizeof(P) - 33;
+    if ((err = ocb3_init(&ocb, idx, K, sizeof(K), N, sizeof(N), 12)) != CRYPT_OK)  return err;
+    if ((err = ocb3_add_aad(&ocb, A, sizeof(A))) != CRYPT_OK)                      return err;
+    if ((err = ocb3_process_iov(&ocb, vin, 3, vout, 3, OCB3_ENCRYPT)) != CRYPT_OK) return err;
+    len = sizeof(outtag);
+    if ((err = ocb3_done(&ocb, outtag, &len)) != CRYPT_OK)                         return err;
+    if (compare_testvector(outct, sizeof(P), C, sizeof(C), "OCB3 iov CT", x))      return CRYPT_FAIL_TESTVECTOR;
+    if (compare_testvector(outtag, len, T, sizeof(T), "OCB3 iov Tag.enc", x))      return CRYPT_FAIL_TESTVECTOR;
+    /* decrypt in place */
+    if ((err = ocb3_init(&ocb, idx, K, sizeof(K), N, sizeof(N), 12)) != CRYPT_OK)  return err;
+    if ((err = ocb3_add_aad(&ocb, A, sizeof(A))) != CRYPT_OK)                      return err;
+    if ((err = ocb3_process_iov(&ocb, vout, 3, vout, 3, OCB3_DECRYPT)) != CRYPT_OK) return err;
+    len = sizeof(outtag);
+    if ((err = ocb3_done(&ocb, outtag, &len)) != CRYPT_OK)                         return err;
+    if (compare_testvector(outct, sizeof(C), P, sizeof(P), "OCB3 iov PT", x))      return CRYPT_FAIL_TESTVECTOR;
+    if (compare_testvector(outtag, len, T, sizeof(T), "OCB3 iov Tag.dec", x))      return CRYPT_FAIL_TESTVECTOR;
+
     return CRYPT_OK;
 #endif /* LTC_TEST */
 }
@@ -8,8 +8,19 @@
    Hash open files, Tom St Denis
 */
 
+struct hash_filehandle_ctx {
+    int hash;
+    hash_state md;
+};
+
+static int s_hash_filehandle_process(void *ctx, const unsigned char *in, unsigned long inlen)
+{
+    struct hash_filehandle_ctx *c = ctx;
+    return hash_descriptor[c->hash].process(&c->md, in, inlen);
+}
+
 /**
-  Hash data from an open file handle.
+  Hash data from an open file handle, starting at the current file pointer.
   @param hash   The index of the hash you want to use
   @param in     The FILE* handle of the file you want to hash
   @param out    [out] The destination of the digest
@@ -18,47 +29,36 @@
 */
 int hash_filehandle(int hash, FILE *in, unsigned char *out, unsigned long *outlen)
 {
-    hash_state md;
-    unsigned char *buf;
-    size_t x;
+    struct hash_filehandle_ctx c;
     int err;
 
     LTC_ARGCHK(out    != NULL);
     LTC_ARGCHK(outlen != NULL);
     LTC_ARGCHK(in     != NULL);
 
-    if ((buf = XMALLOC(LTC_FILE_READ_BUFSIZE)) == NULL) {
-        return CRYPT_MEM;
-    }
-
     if ((err = hash_is_valid(hash)) != CRYPT_OK) {
-        goto LBL_ERR;
+        return err;
     }
 
     if (*outlen < hash_descriptor[hash].hashsize) {
        *outlen = hash_descriptor[hash].hashsize;
-       err = CRYPT_BUFFER_OVERFLOW;
+       return CRYPT_BUFFER_OVERFLOW;
+    }
+    c.hash = hash;
+    if ((err = hash_descriptor[hash].init(&c.md)) != CRYPT_OK) {
        goto LBL_ERR;
     }
-    if ((err = hash_descriptor[hash].init(&md)) != CRYPT_OK) {
+    if ((err = crypt_file_process(in, s_hash_filehandle_process, &c)) != CRYPT_OK) {
        goto LBL_ERR;
     }
-
-    do {
-        x = fread(buf, 1, LTC_FILE_READ_BUFSIZE, in);
-        if ((err = hash_descriptor[hash].process(&md, buf, (unsigned long)x)) != CRYPT_OK) {
-           goto LBL_CLEANBUF;
-        }
-    } while (x == LTC_FILE_READ_BUFSIZE);
-    if ((err = hash_descriptor[hash].done(&md, out)) == CRYPT_OK) {
+    if ((err = hash_descriptor[hash].done(&c.md, out)) == CRYPT_OK) {
        *outlen = hash_descriptor[hash].hashsize;
     }
 
-LBL_CLEANBUF:
-    zeromem(buf, LTC_FILE_READ_BUFSIZE);
 LBL_ERR:
-    XFREE(buf);
+#ifdef LTC_CLEAN_STACK
+    zeromem(&c, sizeof(c));
+#endif
     return err;
 }
 #endif /* #ifndef LTC_NO_FILE */
-
@@ -299,6 +299,18 @@ typedef unsigned long ltc_mp_digit;
    #define LTC_ALIGN(n)
 #endif
 
+#if !defined(LTC_THREAD_LOCAL)
+   #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+      #define LTC_THREAD_LOCAL _Thread_local
+   #elif defined(__GNUC__) || defined(__clang__)
+      #define LTC_THREAD_LOCAL __thread
+   #elif defined(_MSC_VER)
+      #define LTC_THREAD_LOCAL __declspec(thread)
+   #elif defined(LTC_MPI_SCRATCH)
+      #error LTC_MPI_SCRATCH requires thread-local storage, please define LTC_THREAD_LOCAL
+   #endif
+#endif
+
 /* Choose Windows Vista as minimum Version if we're compiling with at least VS2019
  * This is done in order to test the bcrypt RNG and can still be overridden by the user. */
 #if defined(_MSC_VER) && _MSC_VER >= 1920
@@ -42,6 +42,13 @@ struct rijndael_key {
 };
 #endif
 
+#ifdef LTC_AES_CT
+struct aes_ct_key {
+   ulong64 sk[(14 + 1) * 8];
+   int Nr;
+};
+#endif
+
 #ifdef LTC_KSEED
 struct kseed_key {
     ulong32 K[32], dK[32];
@@ -217,6 +224,9 @@ typedef union Symmetric_key {
 #ifdef LTC_RIJNDAEL
    struct rijndael_key rijndael;
 #endif
+#ifdef LTC_AES_CT
+   struct aes_ct_key   aes_ct;
+#endif
 #ifdef LTC_XTEA
    struct xtea_key     xtea;
 #endif
@@ -329,6 +339,8 @@ typedef struct {
    unsigned char       ctr[MAXBLOCKSIZE];
    /** The pad used to encrypt/decrypt */
    unsigned char       pad[MAXBLOCKSIZE];
+   /** The counter of the first block, ctr_seek() counts from here */
+   unsigned char       ctr0[MAXBLOCKSIZE];
    /** The scheduled key */
    symmetric_key       key;
 
@@ -637,6 +649,23 @@ extern struct ltc_cipher_descriptor {
      int (*accel_xts_decrypt)(const unsigned char *ct, unsigned char *pt,
          unsigned long blocks, unsigned char *tweak,
          const symmetric_key *skey1, const symmetric_key *skey2);
+
+     /** Accelerated CBC-MAC, the chaining core of CMAC/OMAC and XCBC
+         @param in      The message blocks
+         @param blocks  The number of complete blocks to process
+         @param IV      [in/out] The chaining value, IV = E(IV ^ block) for every block
+         @param skey    The scheduled key context
+         @return CRYPT_OK if successful
+      */
+     int (*accel_cbc_mac)(const unsigned char *in, unsigned long blocks,
+         unsigned char *IV, const symmetric_key *skey);
+
+     /** Check whether accel_ecb_encrypt really is faster than single block calls,
+         for hooks which fall back to a block by block loop at run-time.
+         When NULL, a set accel_ecb_encrypt is taken to be fast.
+         @return 1 if it's worth batching blocks for accel_ecb_encrypt, 0 if not
+      */
+     int (*accel_ecb_is_fast)(void);
 } cipher_descriptor[];
 
 #ifdef LTC_BLOWFISH
@@ -711,11 +740,13 @@ extern const struct ltc_cipher_descriptor safer_k64_desc, safer_k128_desc, safer
 int aes_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey);
 int aes_ecb_encrypt(const unsigned char *pt, unsigned char *ct, const symmetric_key *skey);
 int aes_ecb_decrypt(const unsigned char *ct, unsigned char *pt, const symmetric_key *skey);
+int aes_cbc_mac(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey);
 int aes_test(void);
 void aes_done(symmetric_key *skey);
 int aes_keysize(int *keysize);
 int aes_enc_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey);
 int aes_enc_ecb_encrypt(const unsigned char *pt, unsigned char *ct, const symmetric_key *skey);
+int aes_enc_cbc_mac(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey);
 int aes_enc_test(void);
 void aes_enc_done(symmetric_key *skey);
 int aes_enc_keysize(int *keysize);
@@ -741,12 +772,36 @@ int aesni_is_supported(void);
 int aesni_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey);
 int aesni_ecb_encrypt(const unsigned char *pt, unsigned char *ct, const symmetric_key *skey);
 int aesni_ecb_decrypt(const unsigned char *ct, unsigned char *pt, const symmetric_key *skey);
+int aesni_ecb_encrypt_blocks(const unsigned char *pt, unsigned char *ct, unsigned long blocks, const symmetric_key *skey);
+int aesni_cbc_mac(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey);
+#ifdef LTC_CCM_MODE
+int aesni_ccm_memory(const unsigned char *key,    unsigned long keylen,
+                     symmetric_key       *uskey,
+                     const unsigned char *nonce,  unsigned long noncelen,
+                     const unsigned char *header, unsigned long headerlen,
+                           unsigned char *pt,     unsigned long ptlen,
+                           unsigned char *ct,
+                           unsigned char *tag,    unsigned long *taglen,
+                                     int  direction);
+#endif
 int aesni_test(void);
 void aesni_done(symmetric_key *skey);
 int aesni_keysize(int *keysize);
 extern const struct ltc_cipher_descriptor aesni_desc;
 #endif
 
+#if defined(LTC_AES_CT)
+int aes_ct_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey);
+int aes_ct_ecb_encrypt(const unsigned char *pt, unsigned char *ct, const symmetric_key *skey);
+int aes_ct_ecb_decrypt(const unsigned char *ct, unsigned char *pt, const symmetric_key *skey);
+int aes_ct_ecb_encrypt_blocks(const unsigned char *pt, unsigned char *ct, unsigned long blocks, const symmetric_key *skey);
+int aes_ct_ecb_decrypt_blocks(const unsigned char *ct, unsigned char *pt, unsigned long blocks, const symmetric_key *skey);
+int aes_ct_test(void);
+void aes_ct_done(symmetric_key *skey);
+int aes_ct_keysize(int *keysize);
+extern const struct ltc_cipher_descriptor aes_ct_desc;
+#endif
+
 #ifdef LTC_XTEA
 int xtea_setup(const unsigned char *key, int keylen, int num_rounds, symmetric_key *skey);
 int xtea_ecb_encrypt(const unsigned char *pt, unsigned char *ct, const symmetric_key *skey);
@@ -975,6 +1030,7 @@ int ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long len, s
 int ctr_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, symmetric_CTR *ctr);
 int ctr_getiv(unsigned char *IV, unsigned long *len, const symmetric_CTR *ctr);
 int ctr_setiv(const unsigned char *IV, unsigned long len, symmetric_CTR *ctr);
+int ctr_seek(ulong64 offset, symmetric_CTR *ctr);
 int ctr_done(symmetric_CTR *ctr);
 int ctr_test(void);
 #endif
@@ -1038,6 +1094,13 @@ int xts_decrypt(
          unsigned char *tweak,
    const symmetric_xts *xts);
 
+int xts_encrypt_sectors(const unsigned char *pt, unsigned char *ct,
+                        unsigned long sector_size, ulong64 sector, unsigned long nsectors,
+                        const symmetric_xts *xts);
+int xts_decrypt_sectors(const unsigned char *ct, unsigned char *pt,
+                        unsigned long sector_size, ulong64 sector, unsigned long nsectors,
+                        const symmetric_xts *xts);
+
 void xts_done(symmetric_xts *xts);
 int  xts_test(void);
 void xts_mult_x(unsigned char *I);
@@ -171,6 +171,15 @@
 /* GNU Multiple Precision Arithmetic Library */
 /* #define GMP_DESC */
 
+/* Cache released bignums per thread and hand them out again on the next init,
+ * so the temporaries of the PK operations don't go through the heap every time */
+/* #define LTC_MPI_SCRATCH */
+
+/* Use the fixed-window exponentiation of the library instead of the descriptor's exptmod for secret exponents.
+ * This only hides the operation sequence and the table accesses of the exponentiation itself, and is
+ * noticeably slower with GMP, so it's off by default */
+/* #define LTC_MPI_FIXED_WINDOW */
+
 #endif /* LTC_NO_MATH */
 
 /* ---> Symmetric Block Ciphers <--- */
@@ -182,6 +191,8 @@
 #define LTC_RC6
 #define LTC_SAFERP
 #define LTC_RIJNDAEL
+/* Use the constant-time bitsliced AES instead of the table based one when no AES-NI is available */
+/* #define LTC_AES_CT */
 #define LTC_XTEA
 /* _TABLES tells it to use tables during setup, _SMALL means to use the smaller scheduled key format
  * (saves 4KB of ram), _ALL_TABLES enables all tables during setup */
@@ -291,6 +302,8 @@
 #define LTC_POLY1305
 #define LTC_BLAKE2SMAC
 #define LTC_BLAKE2BMAC
+/* requires LTC_GCM_MODE */
+#define LTC_GMAC
 
 /* ---> Encrypt + Authenticate Modes <--- */
 
@@ -302,6 +315,8 @@
 #define LTC_GCM_MODE
 #define LTC_CHACHA20POLY1305_MODE
 #define LTC_SIV_MODE
+/* requires LTC_GCM_MODE */
+#define LTC_GCM_SIV_MODE
 
 /* Use 64KiB tables */
 #ifndef LTC_NO_TABLES
@@ -461,6 +476,11 @@
 
 #endif /* LTC_NO_PK */
 
+#if defined(LTC_MDH) && !defined(LTC_NO_DH_FIXED_BASE)
+/* Use lazily built fixed-base comb tables when generating keys of the built-in DH groups */
+#define LTC_DH_FIXED_BASE
+#endif  /* LTC_NO_DH_FIXED_BASE */
+
 #if defined(LTC_MRSA) && !defined(LTC_NO_RSA_BLINDING)
 /* Enable RSA blinding when doing private key operations by default */
 #define LTC_RSA_BLINDING
@@ -507,6 +527,11 @@
 #define LTC_BCRYPT_DEFAULT_ROUNDS 10
 #endif
 
+/* Memory-hard password hashing */
+#define LTC_ARGON2
+
+#define LTC_SCRYPT
+
 /* Keep LTC_NO_HKDF for compatibility reasons
  * superseeded by LTC_NO_MISC*/
 #ifndef LTC_NO_HKDF
@@ -514,6 +539,14 @@
 #define LTC_HKDF
 #endif /* LTC_NO_HKDF */
 
+/* Feed several hashes and MACs from a single pass over the input */
+#define LTC_DIGEST_FANOUT
+
+#ifndef LTC_DIGEST_FANOUT_CHUNK
+/* octets every consumer gets in turn, small enough to stay in the L1 cache */
+#define LTC_DIGEST_FANOUT_CHUNK 4096
+#endif
+
 #define LTC_ADLER32
 
 #define LTC_CRC32
@@ -575,6 +608,13 @@
    #ifndef LTC_FILE_READ_BUFSIZE
    #define LTC_FILE_READ_BUFSIZE 8192
    #endif
+   /* Let the hash and MAC file helpers map regular files instead of reading them, POSIX only.
+    * A file that is truncated by another process while it's mapped raises SIGBUS, see the manual. */
+   /* #define LTC_FILE_MMAP */
+   #if defined(LTC_FILE_MMAP) && !defined(LTC_FILE_MMAP_WINDOW)
+      /* how much of a file is mapped at once, a multiple of the page size */
+      #define LTC_FILE_MMAP_WINDOW (64UL * 1024UL * 1024UL)
+   #endif
 #endif
 
 #if defined(LTC_PEM)
@@ -612,6 +652,14 @@
       /* iterations limit for retry-loops */
       #define LTC_PK_MAX_RETRIES  20
    #endif
+
+   #if defined(LTC_MPI_SCRATCH) && !defined(LTC_MPI_SCRATCH_SLOTS)
+      /* number of bignums cached per thread */
+      #define LTC_MPI_SCRATCH_SLOTS  64
+   #endif
+#else
+   #undef LTC_MPI_SCRATCH
+   #undef LTC_MPI_FIXED_WINDOW
 #endif
 
 #ifdef LTC_MRSA
@@ -640,6 +688,10 @@
    #error LTC_PBES requires LTC_PKCS_12
 #endif
 
+#if defined(LTC_HKDF) && !defined(LTC_HMAC)
+   #error LTC_HKDF requires LTC_HMAC
+#endif
+
 #if defined(LTC_PKCS_5) && !defined(LTC_HMAC)
    #error LTC_PKCS_5 requires LTC_HMAC
 #endif
@@ -652,6 +704,10 @@
    #error Pelican-MAC requires LTC_RIJNDAEL
 #endif
 
+#if defined(LTC_AES_CT) && !defined(LTC_RIJNDAEL)
+   #error LTC_AES_CT requires LTC_RIJNDAEL
+#endif
+
 #if defined(LTC_EAX_MODE) && !(defined(LTC_CTR_MODE) && defined(LTC_OMAC))
    #error LTC_EAX_MODE requires CTR and LTC_OMAC mode
 #endif
@@ -672,6 +728,18 @@
    #error LTC_BCRYPT requires LTC_BLOWFISH
 #endif
 
+#if defined(LTC_ARGON2) && !defined(LTC_BLAKE2B)
+   #error LTC_ARGON2 requires LTC_BLAKE2B
+#endif
+
+#if defined(LTC_SCRYPT) && (!defined(LTC_SALSA20) || !defined(LTC_PKCS_5) || !defined(LTC_SHA256))
+   #error LTC_SCRYPT requires LTC_SALSA20 + LTC_PKCS_5 + LTC_SHA256
+#endif
+
+#if defined(LTC_GCM_SIV_MODE) && !defined(LTC_GCM_MODE)
+   #error LTC_GCM_SIV_MODE requires LTC_GCM_MODE
+#endif
+
 #if defined(LTC_CHACHA20POLY1305_MODE) && (!defined(LTC_CHACHA) || !defined(LTC_POLY1305))
    #error LTC_CHACHA20POLY1305_MODE requires LTC_CHACHA + LTC_POLY1305
 #endif
@@ -692,6 +760,10 @@
    #error LTC_SOBER128 requires LTC_SOBER128_STREAM
 #endif
 
+#if defined(LTC_GMAC) && !defined(LTC_GCM_MODE)
+   #error LTC_GMAC requires LTC_GCM_MODE
+#endif
+
 #if defined(LTC_BLAKE2SMAC) && !defined(LTC_BLAKE2S)
    #error LTC_BLAKE2SMAC requires LTC_BLAKE2S
 #endif
@@ -4,11 +4,20 @@
 #ifdef LTC_HMAC
 typedef struct Hmac_state {
      hash_state     md;
+     hash_state     outer;
      int            hash;
-     unsigned char  key[MAXBLOCKSIZE];
 } hmac_state;
 
+/** A precomputed HMAC key, holds the hash states after the ipad and opad blocks */
+typedef struct Hmac_key {
+     hash_state     inner;
+     hash_state     outer;
+     int            hash;
+} hmac_key;
+
 int hmac_init(hmac_state *hmac, int hash, const unsigned char *key, unsigned long keylen);
+int hmac_key_init(hmac_key *hkey, int hash, const unsigned char *key, unsigned long keylen);
+int hmac_init_from_key(hmac_state *hmac, const hmac_key *hkey);
 int hmac_process(hmac_state *hmac, const unsigned char *in, unsigned long inlen);
 int hmac_done(hmac_state *hmac, unsigned char *out, unsigned long *outlen);
 int hmac_test(void);
@@ -16,6 +25,9 @@ int hmac_memory(int hash,
                 const unsigned char *key, unsigned long keylen,
                 const unsigned char *in,  unsigned long inlen,
                       unsigned char *out, unsigned long *outlen);
+int hmac_memory_key(const hmac_key *hkey,
+                    const unsigned char *in,   unsigned long inlen,
+                          unsigned char *out,  unsigned long *outlen);
 int hmac_memory_multi(int hash,
                 const unsigned char *key,  unsigned long keylen,
                       unsigned char *out,  unsigned long *outlen,
@@ -247,6 +259,13 @@ int f9_test(void);
  * ENC+AUTH modes
  */
 
+/** One segment of a scatter-gather list, c.f. the *_process_iov() functions.
+    The data of an output segment is written to, so it has to point to writable memory. */
+typedef struct {
+   const unsigned char *data;
+   unsigned long        len;
+} ltc_iovec;
+
 #ifdef LTC_EAX_MODE
 
 #if !(defined(LTC_OMAC) && defined(LTC_CTR_MODE))
@@ -259,6 +278,9 @@ typedef struct {
    omac_state    headeromac, ctomac;
 } eax_state;
 
+#define EAX_ENCRYPT LTC_ENCRYPT
+#define EAX_DECRYPT LTC_DECRYPT
+
 int eax_init(eax_state *eax, int cipher, const unsigned char *key, unsigned long keylen,
              const unsigned char *nonce, unsigned long noncelen,
              const unsigned char *header, unsigned long headerlen);
@@ -266,6 +288,10 @@ int eax_init(eax_state *eax, int cipher, const unsigned char *key, unsigned long
 int eax_encrypt(eax_state *eax, const unsigned char *pt, unsigned char *ct, unsigned long length);
 int eax_decrypt(eax_state *eax, const unsigned char *ct, unsigned char *pt, unsigned long length);
 int eax_addheader(eax_state *eax, const unsigned char *header, unsigned long length);
+int eax_process_iov(eax_state *eax,
+                    const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    int direction);
 int eax_done(eax_state *eax, unsigned char *tag, unsigned long *taglen);
 
 int eax_encrypt_authenticate_memory(int cipher,
@@ -368,6 +394,9 @@ typedef struct {
                      block_len;               /* length of block */
 } ocb3_state;
 
+#define OCB3_ENCRYPT LTC_ENCRYPT
+#define OCB3_DECRYPT LTC_DECRYPT
+
 int ocb3_init(ocb3_state *ocb, int cipher,
              const unsigned char *key, unsigned long keylen,
              const unsigned char *nonce, unsigned long noncelen,
@@ -377,6 +406,10 @@ int ocb3_encrypt(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen,
 int ocb3_decrypt(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen, unsigned char *pt);
 int ocb3_encrypt_last(ocb3_state *ocb, const unsigned char *pt, unsigned long ptlen, unsigned char *ct);
 int ocb3_decrypt_last(ocb3_state *ocb, const unsigned char *ct, unsigned long ctlen, unsigned char *pt);
+int ocb3_process_iov(ocb3_state *ocb,
+                     const ltc_iovec *in,  unsigned long incnt,
+                     const ltc_iovec *out, unsigned long outcnt,
+                     int direction);
 int ocb3_add_aad(ocb3_state *ocb, const unsigned char *aad, unsigned long aadlen);
 int ocb3_done(ocb3_state *ocb, unsigned char *tag, unsigned long *taglen);
 
@@ -443,6 +476,11 @@ int ccm_process(ccm_state *ccm,
                 unsigned char *ct,
                 int direction);
 
+int ccm_process_iov(ccm_state *ccm,
+                    const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    int direction);
+
 int ccm_done(ccm_state *ccm,
              unsigned char *tag,    unsigned long *taglen);
 
@@ -479,12 +517,10 @@ extern const unsigned char gcm_shift_table[];
 #define LTC_GCM_MODE_AAD   1
 #define LTC_GCM_MODE_TEXT  2
 
+/** The part of GCM that only depends on the key, it is read-only after gcm_key_init()
+    and can be shared by any number of gcm_msg_state's */
 typedef struct {
-   unsigned char       H[16],        /* multiplier */
-                       X[16],        /* accumulator */
-                       Y[16],        /* counter */
-                       Y_0[16],      /* initial counter */
-                       buf[16];      /* buffer for stuff */
+   unsigned char       H[16];        /* multiplier */
 
 #ifdef LTC_GCM_TABLES
    unsigned char       PC[16][256][16];  /* 16 tables of 8x128 */
@@ -492,17 +528,58 @@ typedef struct {
 
    symmetric_key       K;
 
-   int                 cipher,       /* which cipher */
-                       ivmode,       /* Which mode is the IV in? */
+   int                 cipher;       /* which cipher */
+} gcm_key;
+
+/** The state of a single GCM message */
+typedef struct {
+   const gcm_key      *key;          /* the key the message is processed with */
+
+   unsigned char       X[16],        /* accumulator */
+                       Y[16],        /* counter */
+                       Y_0[16],      /* initial counter */
+                       buf[16];      /* buffer for stuff */
+
+   int                 ivmode,       /* Which mode is the IV in? */
                        mode,         /* mode the GCM code is in */
                        buflen;       /* length of data in buf */
 
    ulong64             totlen,       /* 64-bit counter used for IV and AAD */
                        pttotlen;     /* 64-bit counter for the PT */
+} gcm_msg_state;
+
+typedef struct {
+   gcm_key             key;
+   gcm_msg_state       msg;
 } gcm_state;
 
 void gcm_mult_h(const gcm_state *gcm, unsigned char *I);
 
+int gcm_key_init(gcm_key *key, int cipher,
+                 const unsigned char *K, int keylen);
+void gcm_key_done(gcm_key *key);
+
+int gcm_msg_init(gcm_msg_state *msg, const gcm_key *key);
+
+int gcm_msg_add_iv(gcm_msg_state *msg,
+                   const unsigned char *IV,     unsigned long IVlen);
+
+int gcm_msg_add_aad(gcm_msg_state *msg,
+                    const unsigned char *adata,  unsigned long adatalen);
+
+int gcm_msg_process(gcm_msg_state *msg,
+                          unsigned char *pt,     unsigned long ptlen,
+                          unsigned char *ct,
+                          int direction);
+
+int gcm_msg_process_iov(gcm_msg_state *msg,
+                        const ltc_iovec *in,  unsigned long incnt,
+                        const ltc_iovec *out, unsigned long outcnt,
+                        int direction);
+
+int gcm_msg_done(gcm_msg_state *msg,
+                       unsigned char *tag,    unsigned long *taglen);
+
 int gcm_init(gcm_state *gcm, int cipher,
              const unsigned char *key, int keylen);
 
@@ -519,6 +596,11 @@ int gcm_process(gcm_state *gcm,
                      unsigned char *ct,
                      int direction);
 
+int gcm_process_iov(gcm_state *gcm,
+                    const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    int direction);
+
 int gcm_done(gcm_state *gcm,
                      unsigned char *tag,    unsigned long *taglen);
 
@@ -534,6 +616,34 @@ int gcm_test(void);
 
 #endif /* LTC_GCM_MODE */
 
+#ifdef LTC_GMAC
+/** GMAC is GCM without plaintext, the state is the one of GCM */
+typedef gcm_state gmac_state;
+
+int gmac_init(gmac_state *gmac, int cipher,
+              const unsigned char *key, unsigned long keylen,
+              const unsigned char *IV,  unsigned long IVlen);
+int gmac_process(gmac_state *gmac, const unsigned char *in, unsigned long inlen);
+int gmac_done(gmac_state *gmac, unsigned char *out, unsigned long *outlen);
+int gmac_memory(int cipher,
+                const unsigned char *key, unsigned long keylen,
+                const unsigned char *IV,  unsigned long IVlen,
+                const unsigned char *in,  unsigned long inlen,
+                      unsigned char *out, unsigned long *outlen);
+int gmac_memory_multi(int cipher,
+                const unsigned char *key, unsigned long keylen,
+                const unsigned char *IV,  unsigned long IVlen,
+                      unsigned char *out, unsigned long *outlen,
+                const unsigned char *in,  unsigned long inlen, ...)
+                LTC_NULL_TERMINATED;
+int gmac_file(int cipher,
+              const unsigned char *key, unsigned long keylen,
+              const unsigned char *IV,  unsigned long IVlen,
+              const          char *filename,
+                    unsigned char *out, unsigned long *outlen);
+int gmac_test(void);
+#endif /* LTC_GMAC */
+
 #ifdef LTC_CHACHA20POLY1305_MODE
 
 typedef struct {
@@ -554,6 +664,10 @@ int chacha20poly1305_setiv_rfc7905(chacha20poly1305_state *st, const unsigned ch
 int chacha20poly1305_add_aad(chacha20poly1305_state *st, const unsigned char *in, unsigned long inlen);
 int chacha20poly1305_encrypt(chacha20poly1305_state *st, const unsigned char *in, unsigned long inlen, unsigned char *out);
 int chacha20poly1305_decrypt(chacha20poly1305_state *st, const unsigned char *in, unsigned long inlen, unsigned char *out);
+int chacha20poly1305_process_iov(chacha20poly1305_state *st,
+                                 const ltc_iovec *in,  unsigned long incnt,
+                                 const ltc_iovec *out, unsigned long outcnt,
+                                 int direction);
 int chacha20poly1305_done(chacha20poly1305_state *st, unsigned char *tag, unsigned long *taglen);
 int chacha20poly1305_memory(const unsigned char *key, unsigned long keylen,
                             const unsigned char *iv,  unsigned long ivlen,
@@ -586,3 +700,20 @@ int siv_test(void);
 
 #endif
 
+#ifdef LTC_GCM_SIV_MODE
+
+#define GCM_SIV_ENCRYPT LTC_ENCRYPT
+#define GCM_SIV_DECRYPT LTC_DECRYPT
+
+int gcm_siv_memory(      int           cipher,
+                   const unsigned char *key,    unsigned long keylen,
+                   const unsigned char *IV,     unsigned long IVlen,
+                   const unsigned char *adata,  unsigned long adatalen,
+                         unsigned char *pt,     unsigned long ptlen,
+                         unsigned char *ct,
+                         unsigned char *tag,    unsigned long *taglen,
+                                   int direction);
+int gcm_siv_test(void);
+
+#endif
+
@@ -498,6 +498,11 @@ typedef struct {
       @return CRYPT_OK on success
    */
    int (*rand)(void *a, int size);
+
+   /** Non-zero if montgomery_reduce() is a real Montgomery reduction,
+       zero if it's emulated, e.g. by a division.  Some algorithms only
+       build their own exponentiation on top of it when it's native. */
+   int montgomery_native;
 } ltc_math_descriptor;
 
 extern ltc_math_descriptor ltc_mp;
@@ -506,6 +511,10 @@ int ltc_init_multi(void **a, ...) LTC_NULL_TERMINATED;
 void ltc_deinit_multi(void *a, ...) LTC_NULL_TERMINATED;
 void ltc_cleanup_multi(void **a, ...) LTC_NULL_TERMINATED;
 
+#ifdef LTC_MPI_SCRATCH
+void ltc_mp_scratch_flush(void);
+#endif
+
 #ifdef LTM_DESC
 extern const ltc_math_descriptor ltm_desc;
 #endif
@@ -58,11 +58,59 @@ int bcrypt_pbkdf_openbsd(const          void *secret, unsigned long secret_len,
                          const unsigned char *salt,   unsigned long salt_len,
                                unsigned int  rounds,            int hash_idx,
                                unsigned char *out,    unsigned long *outlen);
+int bcrypt_hash(const          char *password, unsigned long password_len,
+                const unsigned char *salt,     unsigned int  cost,
+                               char *out,      unsigned long *outlen);
+int bcrypt_verify(const char *password, unsigned long password_len,
+                  const char *hash,     int *stat);
+#endif
+
+#ifdef LTC_ARGON2
+typedef enum {
+   LTC_ARGON2_D  = 0,
+   LTC_ARGON2_I  = 1,
+   LTC_ARGON2_ID = 2
+} argon2_type;
+
+typedef struct {
+   void          *memory;
+   unsigned long  size;
+} argon2_arena;
+
+int argon2_arena_init(argon2_arena *arena);
+void argon2_arena_free(argon2_arena *arena);
+int argon2_hash(argon2_type type, unsigned long t_cost, unsigned long m_cost, unsigned long parallelism,
+                const unsigned char *password, unsigned long password_len,
+                const unsigned char *salt,     unsigned long salt_len,
+                const unsigned char *secret,   unsigned long secret_len,
+                const unsigned char *ad,       unsigned long ad_len,
+                argon2_arena *arena,
+                unsigned char *out,            unsigned long outlen);
+#endif
+
+#ifdef LTC_SCRYPT
+int scrypt(const unsigned char *password, unsigned long password_len,
+           const unsigned char *salt,     unsigned long salt_len,
+           unsigned long N, unsigned long r, unsigned long p,
+           unsigned char *out,            unsigned long outlen);
 #endif
 
 /* ===> LTC_HKDF -- RFC5869 HMAC-based Key Derivation Function <=== */
 #ifdef LTC_HKDF
 
+typedef struct {
+   hmac_key prk;
+} hkdf_state;
+
+typedef struct {
+   const unsigned char *label;
+   unsigned long        labellen;
+   const unsigned char *context;
+   unsigned long        contextlen;
+   unsigned char       *out;
+   unsigned long        outlen;
+} hkdf_label;
+
 int hkdf_test(void);
 
 int hkdf_extract(int hash_idx,
@@ -81,8 +129,49 @@ int hkdf(int hash_idx,
          const unsigned char *in,   unsigned long inlen,
                unsigned char *out,  unsigned long outlen);
 
+int hkdf_init(hkdf_state *hkdf, int hash_idx, const unsigned char *prk, unsigned long prklen);
+int hkdf_expand_state(const hkdf_state *hkdf,
+                      const unsigned char *info, unsigned long infolen,
+                            unsigned char *out,  unsigned long outlen);
+int hkdf_expand_label(const hkdf_state *hkdf,
+                      const unsigned char *label,   unsigned long labellen,
+                      const unsigned char *context, unsigned long contextlen,
+                            unsigned char *out,     unsigned long outlen);
+int hkdf_expand_label_multi(const hkdf_state *hkdf, const hkdf_label *labels, unsigned long n);
+
 #endif  /* LTC_HKDF */
 
+/* ---- one pass over the input feeding several hashes and MACs ---- */
+#ifdef LTC_DIGEST_FANOUT
+typedef enum {
+   LTC_SINK_HASH = 0,
+   LTC_SINK_HMAC,
+   LTC_SINK_OMAC,
+   LTC_SINK_PMAC,
+   LTC_SINK_XCBC,
+   LTC_SINK_POLY1305,
+   LTC_SINK_BLAKE2SMAC,
+   LTC_SINK_BLAKE2BMAC,
+   LTC_SINK_GMAC
+} digest_sink_type;
+
+/** A consumer of a fan-out, its state is initialized and finished by the caller */
+typedef struct {
+   digest_sink_type  type;
+   /** the index of the hash, only used for LTC_SINK_HASH */
+   int               hash;
+   /** the hash_state, hmac_state, omac_state, ... matching type */
+   void             *state;
+} digest_sink;
+
+int digest_fanout_memory(const digest_sink *sinks, unsigned long nsinks,
+                         const unsigned char *in, unsigned long inlen);
+#ifndef LTC_NO_FILE
+int digest_fanout_filehandle(const digest_sink *sinks, unsigned long nsinks, FILE *in);
+#endif
+int digest_fanout_file(const digest_sink *sinks, unsigned long nsinks, const char *fname);
+#endif /* LTC_DIGEST_FANOUT */
+
 /* ---- MEM routines ---- */
 int mem_neq(const void *a, const void *b, size_t len);
 void zeromem(volatile void *out, size_t outlen);
@@ -140,6 +140,13 @@ int rsa_verify_hash_ex(const unsigned char *sig,            unsigned long  sigle
                              int            hash_idx,       unsigned long  saltlen,
                              int           *stat,     const rsa_key       *key);
 
+int rsa_verify_hash_batch(const unsigned char * const *sig,  const unsigned long *siglen,
+                          const unsigned char * const *hash, const unsigned long *hashlen,
+                                unsigned long          n,
+                                int                    padding,
+                                int                    hash_idx,   unsigned long  saltlen,
+                                int                   *stat, const rsa_key       *key);
+
 int rsa_sign_saltlen_get_max_ex(int padding, int hash_idx, const rsa_key *key);
 
 /* PKCS #1 import/export */
@@ -189,6 +196,9 @@ int dh_set_pg_groupsize(int groupsize, dh_key *key);
 
 int dh_set_key(const unsigned char *in, unsigned long inlen, int type, dh_key *key);
 int dh_generate_key(prng_state *prng, int wprng, dh_key *key);
+#ifdef LTC_DH_FIXED_BASE
+void dh_fixed_base_free(void);
+#endif
 
 int dh_shared_secret(const dh_key  *private_key, const dh_key  *public_key,
                      unsigned char *out,         unsigned long *outlen);
@@ -476,6 +486,18 @@ typedef struct {
    void *y;
 } dsa_key;
 
+/** DSA key with precomputed tables, see dsa_prepare_key() */
+typedef struct {
+   /** The key the tables were built for */
+   const dsa_key *key;
+
+   /** The montgomery constant of p */
+   void *mp;
+
+   /** The comb tables of g and y */
+   void *tables;
+} dsa_prepared_key;
+
 int dsa_make_key(prng_state *prng, int wprng, int group_size, int modulus_size, dsa_key *key);
 
 int dsa_set_pqg(const unsigned char *p,  unsigned long plen,
@@ -506,6 +528,23 @@ int dsa_verify_hash(const unsigned char *sig,        unsigned long  siglen,
                     const unsigned char *hash,       unsigned long  hashlen,
                           int           *stat, const dsa_key       *key);
 
+int dsa_prepare_key(const dsa_key *key, dsa_prepared_key *prep);
+void dsa_prepared_free(dsa_prepared_key *prep);
+
+int dsa_sign_hash_prepared(const unsigned char *in,  unsigned long inlen,
+                                 unsigned char *out, unsigned long *outlen,
+                                 prng_state *prng, int wprng, const dsa_prepared_key *prep);
+
+int dsa_verify_hash_prepared(const unsigned char *sig,        unsigned long  siglen,
+                             const unsigned char *hash,       unsigned long  hashlen,
+                                   int           *stat, const dsa_prepared_key *prep);
+
+int dsa_verify_hash_batch(const unsigned char * const *sig,  const unsigned long *siglen,
+                          const unsigned char * const *hash, const unsigned long *hashlen,
+                                unsigned long          n,
+                                int                   *stat,
+                          const dsa_prepared_key      *prep);
+
 int dsa_encrypt_key(const unsigned char *in,   unsigned long inlen,
                           unsigned char *out,  unsigned long *outlen,
                           prng_state    *prng, int wprng, int hash,
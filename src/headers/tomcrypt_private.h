@@ -111,6 +111,17 @@ typedef struct
 
 /* tomcrypt_cipher.h */
 
+/* the number of blocks the parallelisable modes hand to the cipher at once */
+#define LTC_ECB_BATCH_BLOCKS 8
+
+int cipher_ecb_blocks_accelerated(int cipher);
+int cipher_ecb_encrypt_blocks(int cipher, const unsigned char *pt, unsigned char *ct, unsigned long blocks,
+                              const symmetric_key *skey);
+int cipher_ecb_decrypt_blocks(int cipher, const unsigned char *ct, unsigned char *pt, unsigned long blocks,
+                              const symmetric_key *skey);
+int cipher_cbc_mac_blocks(int cipher, const unsigned char *in, unsigned long blocks, unsigned char *IV,
+                          const symmetric_key *skey);
+
 void blowfish_enc(ulong32 *data, unsigned long blocks, const symmetric_key *skey);
 int blowfish_expand(const unsigned char *key, int keylen,
                     const unsigned char *data, int datalen,
@@ -119,6 +130,10 @@ int blowfish_setup_with_data(const unsigned char *key, int keylen,
                              const unsigned char *data, int datalen,
                              symmetric_key *skey);
 
+#ifdef LTC_SALSA20
+void salsa20_core(ulong32 *out, const ulong32 *in, int rounds);
+#endif
+
 /* tomcrypt_hash.h */
 
 /* a simple macro for making hash "process" functions */
@@ -170,8 +185,59 @@ void ocb3_int_xor_blocks(unsigned char *out, const unsigned char *block_a, const
 
 int omac_vprocess(omac_state *omac, const unsigned char *in,  unsigned long inlen, va_list args);
 
+typedef int (*ltc_iov_process_fn)(void *st, const unsigned char *in, unsigned long inlen,
+                                  unsigned char *out, int direction);
+int ltc_iov_process(const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    unsigned long blocklen, ltc_iov_process_fn process, ltc_iov_process_fn last,
+                    void *st, int direction);
+
+#ifdef LTC_CCM_MODE
+int ccm_int_process_blocks(int cipher, const symmetric_key *skey, unsigned long L,
+                           unsigned char *ctr, unsigned char *CTRPAD, unsigned char *PAD, int pending,
+                           unsigned char *pt, unsigned char *ct, unsigned long blocks, int direction);
+#endif
+
+#ifdef LTC_GCM_MODE
+void gcm_key_mult_h(const gcm_key *key, unsigned char *I);
+#ifdef LTC_GCM_TABLES
+void gcm_key_init_tables(gcm_key *key);
+#endif
+#endif
+
+#ifdef LTC_CHACHA20POLY1305_MODE
+int chacha20poly1305_int_crypt(chacha20poly1305_state *st, const unsigned char *in, unsigned long inlen,
+                               unsigned char *out, int direction);
+#endif
+
 /* tomcrypt_math.h */
 
+#ifdef LTC_MPI_SCRATCH
+void *ltc_mp_scratch_get(void (*release)(void *a));
+int ltc_mp_scratch_put(void *a, void (*release)(void *a));
+#endif
+
+#ifdef LTC_MPI_FIXED_WINDOW
+int ltc_mp_fixed_window_exptmod(void *G, void *X, void *P, void *Y);
+#endif
+
+#if defined(LTC_DH_FIXED_BASE) || defined(LTC_MDSA)
+/* Lim-Lee comb table of a fixed base, c.f. src/math/fixed_base.c */
+typedef struct {
+   int            teeth, cols;
+   void         **T;
+   ulong64       *packed;      /* the entries as big-endian words, only for secret exponents */
+   unsigned long  words;       /* number of words per packed entry */
+   void         (*deinit)(void *a);
+} ltc_mp_comb;
+
+int ltc_mp_fixed_base_init(ltc_mp_comb *comb, const void *base, const void *modulus, void *mp,
+                           int teeth, unsigned long bits, int secret);
+void ltc_mp_fixed_base_free(ltc_mp_comb *comb);
+int ltc_mp_fixed_base_exptmod(const ltc_mp_comb *comb, const unsigned char * const *e, const unsigned long *elen,
+                              int n, const void *modulus, void *mp, void *y, int secret);
+#endif
+
 #if !defined(DESC_DEF_ONLY)
 
 #define MP_DIGIT_BIT                 ltc_mp.bits_per_digit
@@ -231,6 +297,12 @@ int omac_vprocess(omac_state *omac, const unsigned char *in,  unsigned long inle
 #define mp_montgomery_free(a)        ltc_mp.montgomery_deinit(a)
 
 #define mp_exptmod(a,b,c,d)          ltc_mp.exptmod(a,b,c,d)
+#ifdef LTC_MPI_FIXED_WINDOW
+/* exponentiation with a secret exponent */
+#define mp_exptmod_secret(a,b,c,d)   ltc_mp_fixed_window_exptmod(a,b,c,d)
+#else
+#define mp_exptmod_secret(a,b,c,d)   ltc_mp.exptmod(a,b,c,d)
+#endif
 #define mp_prime_is_prime(a, b, c)   ltc_mp.isprime(a, b, c)
 
 #define mp_iszero(a)                 (mp_cmp_d(a, 0) == LTC_MP_EQ ? LTC_MP_YES : LTC_MP_NO)
@@ -246,6 +318,13 @@ int omac_vprocess(omac_state *omac, const unsigned char *in,  unsigned long inle
 
 /* tomcrypt_misc.h */
 
+#ifndef LTC_NO_FILE
+/* the reader shared by the file helpers of the hashes and MACs */
+typedef int (*crypt_file_process_fn)(void *ctx, const unsigned char *in, unsigned long inlen);
+int crypt_file_process(FILE *in, crypt_file_process_fn process, void *ctx);
+int crypt_file_process_name(const char *fname, crypt_file_process_fn process, void *ctx);
+#endif
+
 typedef enum {
    /** Use `\r\n` as line separator */
    BASE64_PEM_CRLF = 1,
@@ -387,6 +466,9 @@ int pk_oid_num_to_str(const unsigned long *oid, unsigned long oidlen, char *OID,
 
 /* ---- DH Routines ---- */
 #ifdef LTC_MRSA
+int rsa_int_exptmod(const unsigned char *in,   unsigned long inlen,
+                          unsigned char *out,  unsigned long *outlen, int which,
+                    const rsa_key *key, void *mp);
 int rsa_init(rsa_key *key);
 void rsa_shrink_key(rsa_key *key);
 int rsa_make_key_bn_e(prng_state *prng, int wprng, int size, void *e,
@@ -402,6 +484,9 @@ extern const ltc_dh_set_type ltc_dh_sets[];
 int dh_init(dh_key *key);
 int dh_check_pubkey(const dh_key *key);
 int dh_import_pkcs8_asn1(ltc_asn1_list *alg_id, ltc_asn1_list *priv_key, dh_key *key);
+#ifdef LTC_DH_FIXED_BASE
+int dh_fixed_base_exptmod(const dh_key *key, const unsigned char *x, unsigned long xlen, void *y);
+#endif
 #endif /* LTC_MDH */
 
 /* ---- ECC Routines ---- */
@@ -483,6 +568,17 @@ int ltc_ecc_map(ecc_point *P, const void *modulus, void *mp);
 #endif /* LTC_MECC */
 
 #ifdef LTC_MDSA
+/* number of teeth of the comb tables of a prepared key, each table has 2^LTC_MDSA_COMB_TEETH entries */
+#define LTC_MDSA_COMB_TEETH    6
+
+int dsa_int_sign_hash_raw(const unsigned char *in,  unsigned long inlen,
+                                       void   *r,   void *s,
+                                   prng_state *prng, int wprng, const dsa_key *key,
+                       const dsa_prepared_key *prep);
+int dsa_int_verify_hash_raw(         void   *r,          void   *s,
+                        const unsigned char *hash, unsigned long hashlen,
+                                        int *stat, const dsa_key *key,
+                     const dsa_prepared_key *prep);
 int dsa_int_init(dsa_key *key);
 int dsa_int_validate(const dsa_key *key, int *stat);
 int dsa_int_validate_xy(const dsa_key *key, int *stat);
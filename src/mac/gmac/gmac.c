@@ -0,0 +1,107 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file gmac.c
+  GMAC, the authentication-only variant of GCM (NIST SP 800-38D)
+*/
+
+#ifdef LTC_GMAC
+
+/**
+   Initialize a GMAC state
+   @param gmac     The GMAC state
+   @param cipher   The index of the cipher desired (must have a 16 octet block)
+   @param key      The secret key
+   @param keylen   The length of the secret key (octets)
+   @param IV       The initialization vector, must be unique per key
+   @param IVlen    The length of the IV (octets, 12 is the fastest)
+   @return CRYPT_OK if successful
+*/
+int gmac_init(gmac_state *gmac, int cipher,
+              const unsigned char *key, unsigned long keylen,
+              const unsigned char *IV,  unsigned long IVlen)
+{
+   int err;
+
+   LTC_ARGCHK(gmac != NULL);
+   LTC_ARGCHK(key  != NULL);
+   LTC_ARGCHK(IV   != NULL);
+
+   if (IVlen == 0) {
+      return CRYPT_INVALID_ARG;
+   }
+   if ((err = gcm_init(gmac, cipher, key, (int)keylen)) != CRYPT_OK) {
+      return err;
+   }
+   if ((err = gcm_add_iv(gmac, IV, IVlen)) != CRYPT_OK) {
+      return err;
+   }
+   /* derive the initial counter now, everything after this is GHASH input */
+   return gcm_add_aad(gmac, NULL, 0);
+}
+
+/**
+   Process data through GMAC
+   @param gmac     The GMAC state
+   @param in       The data to authenticate
+   @param inlen    The length of the data (octets)
+   @return CRYPT_OK if successful
+*/
+int gmac_process(gmac_state *gmac, const unsigned char *in, unsigned long inlen)
+{
+   return gcm_add_aad(gmac, in, inlen);
+}
+
+/**
+   Terminate a GMAC state
+   @param gmac     The GMAC state
+   @param out      [out] The destination of the authentication tag
+   @param outlen   [in/out] The max size and resulting size of the authentication tag (octets)
+   @return CRYPT_OK if successful
+*/
+int gmac_done(gmac_state *gmac, unsigned char *out, unsigned long *outlen)
+{
+   gcm_msg_state *msg;
+   unsigned long x;
+   int err;
+
+   LTC_ARGCHK(gmac   != NULL);
+   LTC_ARGCHK(out    != NULL);
+   LTC_ARGCHK(outlen != NULL);
+
+   msg = &gmac->msg;
+   if (msg->mode != LTC_GCM_MODE_AAD || msg->buflen >= 16 || msg->buflen < 0) {
+      return CRYPT_INVALID_ARG;
+   }
+   if ((err = cipher_is_valid(gmac->key.cipher)) != CRYPT_OK) {
+      return err;
+   }
+
+   /* there is no ciphertext, so unlike gcm_done() no keystream block is ever generated */
+   if (msg->buflen) {
+      msg->totlen += msg->buflen * CONST64(8);
+      gcm_mult_h(gmac, msg->X);
+   }
+   STORE64H(msg->totlen, msg->buf);
+   zeromem(msg->buf + 8, 8);
+   for (x = 0; x < 16; x++) {
+       msg->X[x] ^= msg->buf[x];
+   }
+   gcm_mult_h(gmac, msg->X);
+
+   if ((err = cipher_descriptor[gmac->key.cipher].ecb_encrypt(msg->Y_0, msg->buf, &gmac->key.K)) != CRYPT_OK) {
+      return err;
+   }
+   for (x = 0; x < 16 && x < *outlen; x++) {
+       out[x] = msg->buf[x] ^ msg->X[x];
+   }
+   *outlen = x;
+
+   msg->mode = LTC_GCM_MODE_TEXT;
+   cipher_descriptor[gmac->key.cipher].done(&gmac->key.K);
+   return CRYPT_OK;
+}
+
+#endif
@@ -0,0 +1,87 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file gmac_file.c
+  GMAC, process a file
+*/
+
+#ifdef LTC_GMAC
+
+#ifndef LTC_NO_FILE
+static int s_gmac_file_process(void *ctx, const unsigned char *in, unsigned long inlen)
+{
+   return gmac_process((gmac_state *)ctx, in, inlen);
+}
+#endif
+
+/**
+   GMAC a file
+   @param cipher   The index of the cipher desired
+   @param key      The secret key
+   @param keylen   The length of the secret key (octets)
+   @param IV       The initialization vector
+   @param IVlen    The length of the IV (octets)
+   @param filename The name of the file you wish to GMAC
+   @param out      [out] Where the authentication tag is to be stored
+   @param outlen   [in/out] The max size and resulting size of the authentication tag
+   @return CRYPT_OK if successful, CRYPT_NOP if file support has been disabled
+*/
+int gmac_file(int cipher,
+              const unsigned char *key, unsigned long keylen,
+              const unsigned char *IV,  unsigned long IVlen,
+              const          char *filename,
+                    unsigned char *out, unsigned long *outlen)
+{
+#ifdef LTC_NO_FILE
+   LTC_UNUSED_PARAM(cipher);
+   LTC_UNUSED_PARAM(key);
+   LTC_UNUSED_PARAM(keylen);
+   LTC_UNUSED_PARAM(IV);
+   LTC_UNUSED_PARAM(IVlen);
+   LTC_UNUSED_PARAM(filename);
+   LTC_UNUSED_PARAM(out);
+   LTC_UNUSED_PARAM(outlen);
+   return CRYPT_NOP;
+#else
+   int err;
+   void *orig;
+   gmac_state *gmac;
+
+   LTC_ARGCHK(key      != NULL);
+   LTC_ARGCHK(IV       != NULL);
+   LTC_ARGCHK(filename != NULL);
+   LTC_ARGCHK(out      != NULL);
+   LTC_ARGCHK(outlen   != NULL);
+
+#ifndef LTC_GCM_TABLES_SSE2
+   orig = gmac = XMALLOC(sizeof(*gmac));
+#else
+   orig = gmac = XMALLOC(sizeof(*gmac) + 16);
+#endif
+   if (gmac == NULL) {
+      return CRYPT_MEM;
+   }
+#ifdef LTC_GCM_TABLES_SSE2
+   gmac = LTC_ALIGN_BUF(gmac, 16);
+#endif
+
+   if ((err = gmac_init(gmac, cipher, key, keylen, IV, IVlen)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   if ((err = crypt_file_process_name(filename, s_gmac_file_process, gmac)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   err = gmac_done(gmac, out, outlen);
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(gmac, sizeof(*gmac));
+#endif
+   XFREE(orig);
+   return err;
+#endif
+}
+
+#endif
@@ -0,0 +1,69 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file gmac_memory.c
+  GMAC, process a block of memory
+*/
+
+#ifdef LTC_GMAC
+
+/**
+   GMAC a block of memory
+   @param cipher    The index of the desired cipher
+   @param key       The secret key
+   @param keylen    The length of the secret key (octets)
+   @param IV        The initialization vector
+   @param IVlen     The length of the IV (octets)
+   @param in        The data to send through GMAC
+   @param inlen     The length of the data to send through GMAC (octets)
+   @param out       [out] The destination of the authentication tag
+   @param outlen    [in/out]  The max size and resulting size of the authentication tag (octets)
+   @return CRYPT_OK if successful
+*/
+int gmac_memory(int cipher,
+                const unsigned char *key, unsigned long keylen,
+                const unsigned char *IV,  unsigned long IVlen,
+                const unsigned char *in,  unsigned long inlen,
+                      unsigned char *out, unsigned long *outlen)
+{
+   void       *orig;
+   gmac_state *gmac;
+   int         err;
+
+   LTC_ARGCHK(key    != NULL);
+   LTC_ARGCHK(IV     != NULL);
+   LTC_ARGCHK(in     != NULL || inlen == 0);
+   LTC_ARGCHK(out    != NULL);
+   LTC_ARGCHK(outlen != NULL);
+
+#ifndef LTC_GCM_TABLES_SSE2
+   orig = gmac = XMALLOC(sizeof(*gmac));
+#else
+   orig = gmac = XMALLOC(sizeof(*gmac) + 16);
+#endif
+   if (gmac == NULL) {
+      return CRYPT_MEM;
+   }
+#ifdef LTC_GCM_TABLES_SSE2
+   gmac = LTC_ALIGN_BUF(gmac, 16);
+#endif
+
+   if ((err = gmac_init(gmac, cipher, key, keylen, IV, IVlen)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   if ((err = gmac_process(gmac, in, inlen)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   err = gmac_done(gmac, out, outlen);
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(gmac, sizeof(*gmac));
+#endif
+   XFREE(orig);
+   return err;
+}
+
+#endif
@@ -0,0 +1,86 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+#include <stdarg.h>
+
+/**
+  @file gmac_memory_multi.c
+  GMAC, process multiple blocks of memory
+*/
+
+#ifdef LTC_GMAC
+
+/**
+   GMAC multiple blocks of memory
+   @param cipher    The index of the desired cipher
+   @param key       The secret key
+   @param keylen    The length of the secret key (octets)
+   @param IV        The initialization vector
+   @param IVlen     The length of the IV (octets)
+   @param out       [out] The destination of the authentication tag
+   @param outlen    [in/out]  The max size and resulting size of the authentication tag (octets)
+   @param in        The data to send through GMAC
+   @param inlen     The length of the data to send through GMAC (octets)
+   @param ...       tuples of (data,len) pairs to GMAC, terminated with a (NULL,x) (x=don't care)
+   @return CRYPT_OK if successful
+*/
+int gmac_memory_multi(int cipher,
+                const unsigned char *key, unsigned long keylen,
+                const unsigned char *IV,  unsigned long IVlen,
+                      unsigned char *out, unsigned long *outlen,
+                const unsigned char *in,  unsigned long inlen, ...)
+{
+   void                *orig;
+   gmac_state          *gmac;
+   int                  err;
+   va_list              args;
+   const unsigned char *curptr;
+   unsigned long        curlen;
+
+   LTC_ARGCHK(key    != NULL);
+   LTC_ARGCHK(IV     != NULL);
+   LTC_ARGCHK(in     != NULL);
+   LTC_ARGCHK(out    != NULL);
+   LTC_ARGCHK(outlen != NULL);
+
+#ifndef LTC_GCM_TABLES_SSE2
+   orig = gmac = XMALLOC(sizeof(*gmac));
+#else
+   orig = gmac = XMALLOC(sizeof(*gmac) + 16);
+#endif
+   if (gmac == NULL) {
+      return CRYPT_MEM;
+   }
+#ifdef LTC_GCM_TABLES_SSE2
+   gmac = LTC_ALIGN_BUF(gmac, 16);
+#endif
+
+   va_start(args, inlen);
+   if ((err = gmac_init(gmac, cipher, key, keylen, IV, IVlen)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   curptr = in;
+   curlen = inlen;
+   for (;;) {
+      /* process buf */
+      if ((err = gmac_process(gmac, curptr, curlen)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+      /* step to next */
+      curptr = va_arg(args, const unsigned char*);
+      if (curptr == NULL) {
+         break;
+      }
+      curlen = va_arg(args, unsigned long);
+   }
+   err = gmac_done(gmac, out, outlen);
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(gmac, sizeof(*gmac));
+#endif
+   XFREE(orig);
+   va_end(args);
+   return err;
+}
+
+#endif
@@ -0,0 +1,89 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file gmac_test.c
+  GMAC, self-test
+*/
+
+#ifdef LTC_GMAC
+
+/**
+  Test the GMAC code
+  @return CRYPT_OK if successful, CRYPT_NOP if tests have been disabled
+*/
+int gmac_test(void)
+{
+#if !defined(LTC_TEST)
+   return CRYPT_NOP;
+#else
+   static const struct {
+      int keylen, ivlen, msglen;
+      unsigned char key[16], iv[12], msg[16], tag[16];
+   } tests[] = {
+   /* GCM test case 1 of the original GCM specification */
+   { 16, 12, 0,
+     { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+       0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+     { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+       0x00, 0x00, 0x00, 0x00 },
+     { 0x00 },
+     { 0x58, 0xe2, 0xfc, 0xce, 0xfa, 0x7e, 0x30, 0x61,
+       0x36, 0x7f, 0x1d, 0x57, 0xa4, 0xe7, 0x45, 0x5a }
+   },
+   /* NIST CAVS gcmEncryptExtIV128, PTlen = 0, AADlen = 128, Count = 0 */
+   { 16, 12, 16,
+     { 0x77, 0xbe, 0x63, 0x70, 0x89, 0x71, 0xc4, 0xe2,
+       0x40, 0xd1, 0xcb, 0x79, 0xe8, 0xd7, 0x7f, 0xeb },
+     { 0xe0, 0xe0, 0x0f, 0x19, 0xfe, 0xd7, 0xba, 0x01,
+       0x36, 0xa7, 0x97, 0xf3 },
+     { 0x7a, 0x43, 0xec, 0x1d, 0x9c, 0x0a, 0x5a, 0x78,
+       0xa0, 0xb1, 0x65, 0x33, 0xa6, 0x21, 0x3c, 0xab },
+     { 0x20, 0x9f, 0xcc, 0x8d, 0x36, 0x75, 0xed, 0x93,
+       0x8e, 0x9c, 0x71, 0x66, 0x70, 0x9d, 0xd9, 0x46 }
+   }
+   };
+   unsigned char out[16], out2[16], iv[60], msg[100];
+   unsigned long len, len2, x;
+   int err, idx;
+
+   /* AES can be under rijndael or aes... try to find it */
+   if ((idx = find_cipher("aes")) == -1) {
+      if ((idx = find_cipher("rijndael")) == -1) {
+         return CRYPT_NOP;
+      }
+   }
+
+   for (x = 0; x < sizeof(tests)/sizeof(tests[0]); x++) {
+      len = sizeof(out);
+      if ((err = gmac_memory(idx, tests[x].key, tests[x].keylen, tests[x].iv, tests[x].ivlen,
+                             tests[x].msg, tests[x].msglen, out, &len)) != CRYPT_OK) {
+         return err;
+      }
+      if (compare_testvector(out, len, tests[x].tag, sizeof(tests[x].tag), "GMAC", (int)x) != 0) {
+         return CRYPT_FAIL_TESTVECTOR;
+      }
+   }
+
+   /* a long IV and a message in pieces have to give the tag of GCM without plaintext */
+   for (x = 0; x < sizeof(iv); x++)  iv[x]  = (unsigned char)(x * 3);
+   for (x = 0; x < sizeof(msg); x++) msg[x] = (unsigned char)(x * 7 + 1);
+   len = sizeof(out);
+   if ((err = gcm_memory(idx, tests[1].key, 16, iv, sizeof(iv), msg, sizeof(msg),
+                         NULL, 0, NULL, out, &len, GCM_ENCRYPT)) != CRYPT_OK) {
+      return err;
+   }
+   len2 = sizeof(out2);
+   if ((err = gmac_memory_multi(idx, tests[1].key, 16, iv, sizeof(iv), out2, &len2,
+                                msg, 5uL, msg + 5, 43uL, msg + 48, 52uL, NULL)) != CRYPT_OK) {
+      return err;
+   }
+   if (compare_testvector(out2, len2, out, len, "GMAC long IV", 0) != 0) {
+      return CRYPT_FAIL_TESTVECTOR;
+   }
+   return CRYPT_OK;
+#endif
+}
+
+#endif
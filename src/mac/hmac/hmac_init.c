@@ -11,84 +11,134 @@
 
 #define LTC_HMAC_BLOCKSIZE hash_descriptor[hash].blocksize
 
-/**
-   Initialize an HMAC context.
-   @param hmac     The HMAC state
-   @param hash     The index of the hash you want to use
-   @param key      The secret key
-   @param keylen   The length of the secret key (octets)
-   @return CRYPT_OK if successful
-*/
-int hmac_init(hmac_state *hmac, int hash, const unsigned char *key, unsigned long keylen)
+/* hash the ipad and opad blocks of the key into inner and outer */
+static int s_hmac_midstates(int hash, const unsigned char *key, unsigned long keylen,
+                            hash_state *inner, hash_state *outer)
 {
-    unsigned char *buf;
+    unsigned char buf[MAXBLOCKSIZE];
     unsigned long hashsize;
-    unsigned long i, z;
+    unsigned long i;
     int err;
 
-    LTC_ARGCHK(hmac != NULL);
-    LTC_ARGCHK(key  != NULL);
-
     /* valid hash? */
     if ((err = hash_is_valid(hash)) != CRYPT_OK) {
         return err;
     }
-    hmac->hash = hash;
-    hashsize   = hash_descriptor[hash].hashsize;
+    hashsize = hash_descriptor[hash].hashsize;
 
     /* valid key length? */
     if (keylen == 0) {
         return CRYPT_INVALID_KEYSIZE;
     }
 
-    /* allocate ram for buf */
-    buf = XMALLOC(LTC_HMAC_BLOCKSIZE);
-    if (buf == NULL) {
-       return CRYPT_MEM;
-    }
-
     /* check hash block fits */
-    if (sizeof(hmac->key) < LTC_HMAC_BLOCKSIZE) {
-        err = CRYPT_BUFFER_OVERFLOW;
-        goto LBL_ERR;
+    if (sizeof(buf) < LTC_HMAC_BLOCKSIZE) {
+        return CRYPT_BUFFER_OVERFLOW;
     }
 
     /* (1) make sure we have a large enough key */
     if(keylen > LTC_HMAC_BLOCKSIZE) {
-        z = LTC_HMAC_BLOCKSIZE;
-        if ((err = hash_memory(hash, key, keylen, hmac->key, &z)) != CRYPT_OK) {
+        if ((err = hash_descriptor[hash].init(inner)) != CRYPT_OK) {
+           goto LBL_ERR;
+        }
+        if ((err = hash_descriptor[hash].process(inner, key, keylen)) != CRYPT_OK) {
+           goto LBL_ERR;
+        }
+        if ((err = hash_descriptor[hash].done(inner, buf)) != CRYPT_OK) {
            goto LBL_ERR;
         }
         keylen = hashsize;
     } else {
-        XMEMCPY(hmac->key, key, (size_t)keylen);
+        XMEMCPY(buf, key, (size_t)keylen);
     }
 
     if(keylen < LTC_HMAC_BLOCKSIZE) {
-       zeromem((hmac->key) + keylen, (size_t)(LTC_HMAC_BLOCKSIZE - keylen));
+       zeromem(buf + keylen, (size_t)(LTC_HMAC_BLOCKSIZE - keylen));
     }
 
     /* Create the initialization vector for step (3) */
     for(i=0; i < LTC_HMAC_BLOCKSIZE;   i++) {
-       buf[i] = hmac->key[i] ^ 0x36;
+       buf[i] ^= 0x36;
     }
 
     /* Pre-pend that to the hash data */
-    if ((err = hash_descriptor[hash].init(&hmac->md)) != CRYPT_OK) {
+    if ((err = hash_descriptor[hash].init(inner)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].process(inner, buf, LTC_HMAC_BLOCKSIZE)) != CRYPT_OK) {
        goto LBL_ERR;
     }
 
-    if ((err = hash_descriptor[hash].process(&hmac->md, buf, LTC_HMAC_BLOCKSIZE)) != CRYPT_OK) {
+    /* Create the second HMAC vector for step (6), the outer hash is prepared up to the inner digest */
+    for(i=0; i < LTC_HMAC_BLOCKSIZE;   i++) {
+       buf[i] ^= 0x36 ^ 0x5C;
+    }
+    if ((err = hash_descriptor[hash].init(outer)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+    if ((err = hash_descriptor[hash].process(outer, buf, LTC_HMAC_BLOCKSIZE)) != CRYPT_OK) {
        goto LBL_ERR;
     }
 
 LBL_ERR:
-#ifdef LTC_CLEAN_STACK
-   zeromem(buf, LTC_HMAC_BLOCKSIZE);
-#endif
-
-   XFREE(buf);
+   zeromem(buf, sizeof(buf));
    return err;
 }
 
+/**
+   Initialize an HMAC context.
+   @param hmac     The HMAC state
+   @param hash     The index of the hash you want to use
+   @param key      The secret key
+   @param keylen   The length of the secret key (octets)
+   @return CRYPT_OK if successful
+*/
+int hmac_init(hmac_state *hmac, int hash, const unsigned char *key, unsigned long keylen)
+{
+    LTC_ARGCHK(hmac != NULL);
+    LTC_ARGCHK(key  != NULL);
+
+    hmac->hash = hash;
+    return s_hmac_midstates(hash, key, keylen, &hmac->md, &hmac->outer);
+}
+
+/**
+   Precompute an HMAC key, so that it can be used for many messages with hmac_init_from_key().
+   @param hkey     [out] The HMAC key
+   @param hash     The index of the hash you want to use
+   @param key      The secret key
+   @param keylen   The length of the secret key (octets)
+   @return CRYPT_OK if successful
+*/
+int hmac_key_init(hmac_key *hkey, int hash, const unsigned char *key, unsigned long keylen)
+{
+    LTC_ARGCHK(hkey != NULL);
+    LTC_ARGCHK(key  != NULL);
+
+    hkey->hash = hash;
+    return s_hmac_midstates(hash, key, keylen, &hkey->inner, &hkey->outer);
+}
+
+/**
+   Initialize an HMAC context from a precomputed key.
+   @param hmac     The HMAC state
+   @param hkey     The HMAC key as set up by hmac_key_init()
+   @return CRYPT_OK if successful
+*/
+int hmac_init_from_key(hmac_state *hmac, const hmac_key *hkey)
+{
+    int err;
+
+    LTC_ARGCHK(hmac != NULL);
+    LTC_ARGCHK(hkey != NULL);
+
+    if ((err = hash_is_valid(hkey->hash)) != CRYPT_OK) {
+        return err;
+    }
+    hmac->hash  = hkey->hash;
+    hmac->md    = hkey->inner;
+    hmac->outer = hkey->outer;
+    return CRYPT_OK;
+}
+
 #endif
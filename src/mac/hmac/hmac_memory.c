@@ -25,8 +25,8 @@ int hmac_memory(int hash,
                 const unsigned char *in,   unsigned long inlen,
                       unsigned char *out,  unsigned long *outlen)
 {
-    hmac_state *hmac;
-    int         err;
+    hmac_state hmac;
+    int        err;
 
     LTC_ARGCHK(key    != NULL);
     LTC_ARGCHK(in     != NULL);
@@ -44,31 +44,63 @@ int hmac_memory(int hash,
     }
 
     /* nope, so call the hmac functions */
-    /* allocate ram for hmac state */
-    hmac = XMALLOC(sizeof(hmac_state));
-    if (hmac == NULL) {
-       return CRYPT_MEM;
+    if ((err = hmac_init(&hmac, hash, key, keylen)) != CRYPT_OK) {
+       goto LBL_ERR;
     }
 
-    if ((err = hmac_init(hmac, hash, key, keylen)) != CRYPT_OK) {
+    if ((err = hmac_process(&hmac, in, inlen)) != CRYPT_OK) {
        goto LBL_ERR;
     }
 
-    if ((err = hmac_process(hmac, in, inlen)) != CRYPT_OK) {
+    if ((err = hmac_done(&hmac, out, outlen)) != CRYPT_OK) {
        goto LBL_ERR;
     }
 
-    if ((err = hmac_done(hmac, out, outlen)) != CRYPT_OK) {
+   err = CRYPT_OK;
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(&hmac, sizeof(hmac_state));
+#endif
+
+   return err;
+}
+
+/**
+   HMAC a block of memory with a precomputed key
+   @param hkey      The HMAC key as set up by hmac_key_init()
+   @param in        The data to HMAC
+   @param inlen     The length of the data to HMAC (octets)
+   @param out       [out] Destination of the authentication tag
+   @param outlen    [in/out] Max size and resulting size of authentication tag
+   @return CRYPT_OK if successful
+*/
+int hmac_memory_key(const hmac_key *hkey,
+                    const unsigned char *in,   unsigned long inlen,
+                          unsigned char *out,  unsigned long *outlen)
+{
+    hmac_state hmac;
+    int        err;
+
+    LTC_ARGCHK(hkey   != NULL);
+    LTC_ARGCHK(in     != NULL);
+    LTC_ARGCHK(out    != NULL);
+    LTC_ARGCHK(outlen != NULL);
+
+    if ((err = hmac_init_from_key(&hmac, hkey)) != CRYPT_OK) {
        goto LBL_ERR;
     }
 
-   err = CRYPT_OK;
+    if ((err = hmac_process(&hmac, in, inlen)) != CRYPT_OK) {
+       goto LBL_ERR;
+    }
+
+    err = hmac_done(&hmac, out, outlen);
+
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
-   zeromem(hmac, sizeof(hmac_state));
+   zeromem(&hmac, sizeof(hmac_state));
 #endif
 
-   XFREE(hmac);
    return err;
 }
 
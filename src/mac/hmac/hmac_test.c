@@ -585,7 +585,8 @@ int hmac_test(void)
     };
 
     unsigned long outlen;
-    int err;
+    hmac_key hkey;
+    int err, j;
     int tested=0,failed=0;
     for(i=0; i < (int)(sizeof(cases) / sizeof(cases[0])); i++) {
         int hash = find_hash(cases[i].algo);
@@ -602,6 +603,20 @@ int hmac_test(void)
         if(compare_testvector(digest, outlen, cases[i].digest, (size_t)hash_descriptor[hash].hashsize, cases[i].num, i)) {
             failed++;
         }
+
+        /* the same with a precomputed key, used twice */
+        if((err = hmac_key_init(&hkey, hash, cases[i].key, cases[i].keylen)) != CRYPT_OK) {
+            return err;
+        }
+        for (j = 0; j < 2; j++) {
+            outlen = sizeof(digest);
+            if((err = hmac_memory_key(&hkey, cases[i].data, cases[i].datalen, digest, &outlen)) != CRYPT_OK) {
+                return err;
+            }
+            if(compare_testvector(digest, outlen, cases[i].digest, (size_t)hash_descriptor[hash].hashsize, cases[i].num, i)) {
+                failed++;
+            }
+        }
     }
 
     if (failed != 0) {
@@ -19,7 +19,7 @@
 */
 int omac_process(omac_state *omac, const unsigned char *in, unsigned long inlen)
 {
-   unsigned long n, x;
+   unsigned long n, blklen;
    int           err;
 
    LTC_ARGCHK(omac  != NULL);
@@ -32,49 +32,41 @@ int omac_process(omac_state *omac, const unsigned char *in, unsigned long inlen)
        (omac->blklen > (int)sizeof(omac->block)) || (omac->buflen > omac->blklen)) {
       return CRYPT_INVALID_ARG;
    }
-
-#ifdef LTC_FAST
-   {
-     unsigned long blklen = cipher_descriptor[omac->cipher_idx].block_length;
-
-     if (omac->buflen == 0 && inlen > blklen) {
-        unsigned long y;
-        for (x = 0; x < (inlen - blklen); x += blklen) {
-            for (y = 0; y < blklen; y += sizeof(LTC_FAST_TYPE)) {
-                *(LTC_FAST_TYPE_PTR_CAST(&omac->prev[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&in[y]));
-            }
-            in += blklen;
-            if ((err = cipher_descriptor[omac->cipher_idx].ecb_encrypt(omac->prev, omac->prev, &omac->key)) != CRYPT_OK) {
-               return err;
-            }
-        }
-        inlen -= x;
-     }
+   if (inlen == 0) {
+      return CRYPT_OK;
    }
-#endif
+   blklen = (unsigned long)omac->blklen;
 
-   while (inlen != 0) {
-       /* ok if the block is full we xor in prev, encrypt and replace prev */
-       if (omac->buflen == omac->blklen) {
-          for (x = 0; x < (unsigned long)omac->blklen; x++) {
-              omac->block[x] ^= omac->prev[x];
-          }
-          if ((err = cipher_descriptor[omac->cipher_idx].ecb_encrypt(omac->block, omac->prev, &omac->key)) != CRYPT_OK) {
-             return err;
-          }
-          omac->buflen = 0;
-       }
+   /* top up a pending block, it is only chained once more data follows since the last block is special */
+   if (omac->buflen != 0) {
+      n = MIN(inlen, blklen - (unsigned long)omac->buflen);
+      XMEMCPY(omac->block + omac->buflen, in, n);
+      omac->buflen += n;
+      inlen        -= n;
+      in           += n;
+      if (inlen == 0) {
+         return CRYPT_OK;
+      }
+      if ((err = cipher_cbc_mac_blocks(omac->cipher_idx, omac->block, 1, omac->prev, &omac->key)) != CRYPT_OK) {
+         return err;
+      }
+      omac->buflen = 0;
+   }
 
-       /* add bytes */
-       n = MIN(inlen, (unsigned long)(omac->blklen - omac->buflen));
-       XMEMCPY(omac->block + omac->buflen, in, n);
-       omac->buflen  += n;
-       inlen         -= n;
-       in            += n;
+   /* chain all whole blocks but the last one straight from the input */
+   if (inlen > blklen) {
+      n = (inlen - 1) / blklen;
+      if ((err = cipher_cbc_mac_blocks(omac->cipher_idx, in, n, omac->prev, &omac->key)) != CRYPT_OK) {
+         return err;
+      }
+      in    += n * blklen;
+      inlen -= n * blklen;
    }
 
+   XMEMCPY(omac->block, in, inlen);
+   omac->buflen = (int)inlen;
+
    return CRYPT_OK;
 }
 
 #endif
-
@@ -10,6 +10,32 @@
 
 #ifdef LTC_PMAC
 
+/* process full blocks, the offsets of a run are computed first and the run is encrypted in one go */
+static int s_pmac_blocks(pmac_state *pmac, const unsigned char *in, unsigned long blocks, unsigned char *Z)
+{
+   unsigned long i, n, x, y;
+   int err;
+
+   for (i = 0; i < blocks; i += n) {
+      n = MIN(blocks - i, LTC_ECB_BATCH_BLOCKS);
+      for (x = 0; x < n; x++) {
+         pmac_shift_xor(pmac);
+         for (y = 0; y < (unsigned long)pmac->block_len; y++) {
+            Z[x * pmac->block_len + y] = pmac->Li[y] ^ in[(i + x) * pmac->block_len + y];
+         }
+      }
+      if ((err = cipher_ecb_encrypt_blocks(pmac->cipher_idx, Z, Z, n, &pmac->key)) != CRYPT_OK) {
+         return err;
+      }
+      for (x = 0; x < n; x++) {
+         for (y = 0; y < (unsigned long)pmac->block_len; y++) {
+            pmac->checksum[y] ^= Z[x * pmac->block_len + y];
+         }
+      }
+   }
+   return CRYPT_OK;
+}
+
 /**
   Process data in a PMAC stream
   @param pmac     The PMAC state
@@ -20,8 +46,8 @@
 int pmac_process(pmac_state *pmac, const unsigned char *in, unsigned long inlen)
 {
    int err, n;
-   unsigned long x;
-   unsigned char Z[MAXBLOCKSIZE];
+   unsigned long blocks;
+   unsigned char Z[LTC_ECB_BATCH_BLOCKS * MAXBLOCKSIZE];
 
    LTC_ARGCHK(pmac != NULL);
    LTC_ARGCHK(in   != NULL);
@@ -34,42 +60,25 @@ int pmac_process(pmac_state *pmac, const unsigned char *in, unsigned long inlen)
       return CRYPT_INVALID_ARG;
    }
 
-#ifdef LTC_FAST
-   if (pmac->buflen == 0 && inlen > 16) {
-      unsigned long y;
-      for (x = 0; x < (inlen - 16); x += 16) {
-          pmac_shift_xor(pmac);
-          for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-              *(LTC_FAST_TYPE_PTR_CAST(&Z[y])) = *(LTC_FAST_TYPE_PTR_CAST(&in[y])) ^ *(LTC_FAST_TYPE_PTR_CAST(&pmac->Li[y]));
-          }
-          if ((err = cipher_descriptor[pmac->cipher_idx].ecb_encrypt(Z, Z, &pmac->key)) != CRYPT_OK) {
-             return err;
-          }
-          for (y = 0; y < 16; y += sizeof(LTC_FAST_TYPE)) {
-              *(LTC_FAST_TYPE_PTR_CAST(&pmac->checksum[y])) ^= *(LTC_FAST_TYPE_PTR_CAST(&Z[y]));
-          }
-          in += 16;
-      }
-      inlen -= x;
-   }
-#endif
-
    while (inlen != 0) {
        /* ok if the block is full we xor in prev, encrypt and replace prev */
        if (pmac->buflen == pmac->block_len) {
-          pmac_shift_xor(pmac);
-          for (x = 0; x < (unsigned long)pmac->block_len; x++) {
-               Z[x] = pmac->Li[x] ^ pmac->block[x];
-          }
-          if ((err = cipher_descriptor[pmac->cipher_idx].ecb_encrypt(Z, Z, &pmac->key)) != CRYPT_OK) {
-             return err;
-           }
-          for (x = 0; x < (unsigned long)pmac->block_len; x++) {
-              pmac->checksum[x] ^= Z[x];
+          if ((err = s_pmac_blocks(pmac, pmac->block, 1, Z)) != CRYPT_OK) {
+             goto LBL_ERR;
           }
           pmac->buflen = 0;
        }
 
+       /* whole blocks straight from the input, the last block always goes to the buffer */
+       if (pmac->buflen == 0 && inlen > (unsigned long)pmac->block_len) {
+          blocks = (inlen - 1) / pmac->block_len;
+          if ((err = s_pmac_blocks(pmac, in, blocks, Z)) != CRYPT_OK) {
+             goto LBL_ERR;
+          }
+          in    += blocks * pmac->block_len;
+          inlen -= blocks * pmac->block_len;
+       }
+
        /* add bytes */
        n = MIN(inlen, (unsigned long)(pmac->block_len - pmac->buflen));
        XMEMCPY(pmac->block + pmac->buflen, in, n);
@@ -77,12 +86,14 @@ int pmac_process(pmac_state *pmac, const unsigned char *in, unsigned long inlen)
        inlen         -= n;
        in            += n;
    }
+   err = CRYPT_OK;
 
+LBL_ERR:
 #ifdef LTC_CLEAN_STACK
    zeromem(Z, sizeof(Z));
 #endif
 
-   return CRYPT_OK;
+   return err;
 }
 
 #endif
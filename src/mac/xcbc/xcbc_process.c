@@ -17,10 +17,8 @@
 */
 int xcbc_process(xcbc_state *xcbc, const unsigned char *in, unsigned long inlen)
 {
+   unsigned long n, blocksize;
    int err;
-#ifdef LTC_FAST
-   int x;
-#endif
 
    LTC_ARGCHK(xcbc != NULL);
    LTC_ARGCHK(in   != NULL);
@@ -34,25 +32,34 @@ int xcbc_process(xcbc_state *xcbc, const unsigned char *in, unsigned long inlen)
        (xcbc->buflen > xcbc->blocksize) || (xcbc->buflen < 0)) {
       return CRYPT_INVALID_ARG;
    }
+   blocksize = (unsigned long)xcbc->blocksize;
 
-#ifdef LTC_FAST
-   if (xcbc->buflen == 0) {
-       while (inlen > (unsigned long)xcbc->blocksize) {
-           for (x = 0; x < xcbc->blocksize; x += sizeof(LTC_FAST_TYPE)) {
-              *(LTC_FAST_TYPE_PTR_CAST(&(xcbc->IV[x]))) ^= *(LTC_FAST_TYPE_PTR_CAST(&(in[x])));
-           }
-           cipher_descriptor[xcbc->cipher].ecb_encrypt(xcbc->IV, xcbc->IV, &xcbc->key);
-           in    += xcbc->blocksize;
-           inlen -= xcbc->blocksize;
-       }
+   /* top up a pending block, the input is xor'ed straight into the chaining value */
+   while (inlen != 0 && xcbc->buflen != 0 && xcbc->buflen < xcbc->blocksize) {
+      xcbc->IV[xcbc->buflen++] ^= *in++;
+      --inlen;
+   }
+   if (inlen == 0) {
+      return CRYPT_OK;
+   }
+   if (xcbc->buflen == xcbc->blocksize) {
+      if ((err = cipher_descriptor[xcbc->cipher].ecb_encrypt(xcbc->IV, xcbc->IV, &xcbc->key)) != CRYPT_OK) {
+         return err;
+      }
+      xcbc->buflen = 0;
    }
-#endif
 
-   while (inlen) {
-      if (xcbc->buflen == xcbc->blocksize) {
-         cipher_descriptor[xcbc->cipher].ecb_encrypt(xcbc->IV, xcbc->IV, &xcbc->key);
-         xcbc->buflen = 0;
+   /* chain all whole blocks but the last one, which xcbc_done() has to finish */
+   if (inlen > blocksize) {
+      n = (inlen - 1) / blocksize;
+      if ((err = cipher_cbc_mac_blocks(xcbc->cipher, in, n, xcbc->IV, &xcbc->key)) != CRYPT_OK) {
+         return err;
       }
+      in    += n * blocksize;
+      inlen -= n * blocksize;
+   }
+
+   while (inlen != 0) {
       xcbc->IV[xcbc->buflen++] ^= *in++;
       --inlen;
    }
@@ -60,4 +67,3 @@ int xcbc_process(xcbc_state *xcbc, const unsigned char *in, unsigned long inlen)
 }
 
 #endif
-
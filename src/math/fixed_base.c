@@ -0,0 +1,273 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file fixed_base.c
+  Fixed-base modular exponentiation with Lim-Lee comb tables
+*/
+
+#if defined(LTC_DH_FIXED_BASE) || defined(LTC_MDSA)
+
+/**
+  Build the comb table of a base
+  @param comb      [out] The table to build
+  @param base      The fixed base
+  @param modulus   The modulus
+  @param mp        The "b" value from montgomery_setup() of modulus
+  @param teeth     The number of teeth of the comb, the table has 2^teeth entries
+  @param bits      The maximum size of the exponents in bits
+  @param secret    Non-zero if the table will be used with secret exponents, it then also keeps
+                   a packed copy of the entries so they can be looked up in constant time
+  @return CRYPT_OK if successful
+*/
+int ltc_mp_fixed_base_init(ltc_mp_comb *comb, const void *base, const void *modulus, void *mp,
+                           int teeth, unsigned long bits, int secret)
+{
+   unsigned long  i, j, w, size;
+   unsigned char *buf;
+   int            k, err;
+
+   LTC_ARGCHK(comb    != NULL);
+   LTC_ARGCHK(base    != NULL);
+   LTC_ARGCHK(modulus != NULL);
+   LTC_ARGCHK(teeth >= 1 && teeth <= 12);
+   LTC_ARGCHK(bits > 0);
+
+   XMEMSET(comb, 0, sizeof(*comb));
+   size         = 1UL << teeth;
+   comb->teeth  = teeth;
+   comb->cols   = (int)((bits + (unsigned long)teeth - 1) / (unsigned long)teeth);
+   comb->deinit = ltc_mp.deinit;
+   comb->T      = XCALLOC(size, sizeof(void *));
+   if (comb->T == NULL) {
+      return CRYPT_MEM;
+   }
+   for (j = 0; j < size; j++) {
+      if ((err = mp_init(&comb->T[j])) != CRYPT_OK)                                           { goto error; }
+   }
+
+   /* T[0] is "1" and T[1] is the base, both in montgomery form */
+   if ((err = mp_montgomery_normalization(comb->T[0], modulus)) != CRYPT_OK)                  { goto error; }
+   if ((err = mp_mulmod(base, comb->T[0], modulus, comb->T[1])) != CRYPT_OK)                  { goto error; }
+
+   /* T[2^i] = base^(2^(i*cols)) */
+   for (i = 1; i < (unsigned long)teeth; i++) {
+      if ((err = mp_copy(comb->T[1UL << (i - 1)], comb->T[1UL << i])) != CRYPT_OK)            { goto error; }
+      for (k = 0; k < comb->cols; k++) {
+         if ((err = mp_sqr(comb->T[1UL << i], comb->T[1UL << i])) != CRYPT_OK)                { goto error; }
+         if ((err = mp_montgomery_reduce(comb->T[1UL << i], modulus, mp)) != CRYPT_OK)        { goto error; }
+      }
+   }
+
+   /* all the other entries are the product of their lowest power of two and the remainder */
+   for (j = 3; j < size; j++) {
+      if ((j & (j - 1)) == 0) {
+         continue;
+      }
+      if ((err = mp_mul(comb->T[j & (j - 1)], comb->T[j & (~j + 1)], comb->T[j])) != CRYPT_OK) { goto error; }
+      if ((err = mp_montgomery_reduce(comb->T[j], modulus, mp)) != CRYPT_OK)                  { goto error; }
+   }
+
+   if (secret) {
+      /* all entries are < modulus, store them as fixed size big-endian words */
+      comb->words  = ((unsigned long)mp_unsigned_bin_size(modulus) + 7) / 8;
+      comb->packed = XCALLOC(size * comb->words, sizeof(ulong64));
+      buf          = XMALLOC(comb->words * 8);
+      if (comb->packed == NULL || buf == NULL) {
+         if (buf != NULL) {
+            XFREE(buf);
+         }
+         err = CRYPT_MEM;
+         goto error;
+      }
+      for (j = 0; j < size; j++) {
+         zeromem(buf, comb->words * 8);
+         err = mp_to_unsigned_bin(comb->T[j], buf + comb->words * 8 - (unsigned long)mp_unsigned_bin_size(comb->T[j]));
+         if (err != CRYPT_OK) {
+            XFREE(buf);
+            goto error;
+         }
+         for (w = 0; w < comb->words; w++) {
+            LOAD64H(comb->packed[j * comb->words + w], buf + 8 * w);
+         }
+      }
+      XFREE(buf);
+   }
+
+   return CRYPT_OK;
+
+error:
+   ltc_mp_fixed_base_free(comb);
+   return err;
+}
+
+/**
+  Free a comb table
+  @param comb   The table to free
+*/
+void ltc_mp_fixed_base_free(ltc_mp_comb *comb)
+{
+   unsigned long j;
+
+   LTC_ARGCHKVD(comb != NULL);
+
+   if (comb->T != NULL) {
+      for (j = 0; j < (1UL << comb->teeth); j++) {
+         if (comb->T[j] != NULL) {
+            comb->deinit(comb->T[j]);
+         }
+      }
+      XFREE(comb->T);
+   }
+   if (comb->packed != NULL) {
+      zeromem(comb->packed, (comb->words << comb->teeth) * sizeof(ulong64));
+      XFREE(comb->packed);
+   }
+   zeromem(comb, sizeof(*comb));
+}
+
+/* collect bit `col` of every tooth of the exponent e */
+static LTC_INLINE unsigned long s_comb_column(const ltc_mp_comb *comb, const unsigned char *e, unsigned long elen, int col)
+{
+   unsigned long bit, tooth = 0;
+   int i;
+
+   for (i = comb->teeth - 1; i >= 0; i--) {
+      bit = (unsigned long)i * (unsigned long)comb->cols + (unsigned long)col;
+      tooth <<= 1;
+      if (bit < elen * 8) {
+         tooth |= (e[elen - 1 - bit / 8] >> (bit % 8)) & 1;
+      }
+   }
+   return tooth;
+}
+
+/* read the entry `tooth` of a packed table without a secret dependent memory access */
+static void s_comb_gather(const ltc_mp_comb *comb, unsigned long tooth, ulong64 *acc)
+{
+   unsigned long j, w, d;
+   ulong64       mask;
+
+   for (w = 0; w < comb->words; w++) {
+      acc[w] = 0;
+   }
+   for (j = 0; j < (1UL << comb->teeth); j++) {
+      d    = j ^ tooth;
+      /* all ones if j == tooth, zero otherwise */
+      mask = (ulong64)(((d | (0UL - d)) >> (sizeof(d) * 8 - 1)) ^ 1);
+      mask = (ulong64)0 - mask;
+      for (w = 0; w < comb->words; w++) {
+         acc[w] |= comb->packed[j * comb->words + w] & mask;
+      }
+   }
+}
+
+/**
+  Simultaneous fixed-base exponentiation, y = prod(base[i]^e[i]) mod modulus
+
+  All tables must have been built for the same modulus and with the same number of teeth and columns,
+  so that all of them share one squaring per column.
+  With secret exponents, tables built for them are read in constant time and multiplied in for every column,
+  a zero column multiplies by T[0], the montgomery form of one.  Public exponents always use the plain lookup.
+  @param comb      The comb tables of the bases
+  @param e         The exponents as big-endian octets
+  @param elen      The lengths of the exponents
+  @param n         The number of tables and exponents
+  @param modulus   The modulus
+  @param mp        The "b" value from montgomery_setup() of modulus
+  @param y         [out] The result
+  @param secret    Non-zero if the exponents are secret
+  @return CRYPT_OK if successful, CRYPT_INVALID_ARG if an exponent is too large for its table
+*/
+int ltc_mp_fixed_base_exptmod(const ltc_mp_comb *comb, const unsigned char * const *e, const unsigned long *elen,
+                              int n, const void *modulus, void *mp, void *y, int secret)
+{
+   void          *t, *g = NULL;
+   unsigned long  tooth, w, words = 0;
+   unsigned char *buf = NULL;
+   ulong64       *acc = NULL;
+   int            i, col, err;
+
+   LTC_ARGCHK(comb    != NULL);
+   LTC_ARGCHK(e       != NULL);
+   LTC_ARGCHK(elen    != NULL);
+   LTC_ARGCHK(modulus != NULL);
+   LTC_ARGCHK(y       != NULL);
+   LTC_ARGCHK(n > 0);
+
+   for (i = 0; i < n; i++) {
+      if (comb[i].teeth != comb[0].teeth || comb[i].cols != comb[0].cols) {
+         return CRYPT_INVALID_ARG;
+      }
+      /* all bits outside of the table must be zero */
+      for (tooth = (unsigned long)comb[i].teeth * (unsigned long)comb[i].cols; tooth < elen[i] * 8; tooth++) {
+         if ((e[i][elen[i] - 1 - tooth / 8] >> (tooth % 8)) & 1) {
+            return CRYPT_INVALID_ARG;
+         }
+      }
+   }
+
+   for (i = 0; secret && i < n; i++) {
+      if (comb[i].packed != NULL) {
+         words = MAX(words, comb[i].words);
+      }
+   }
+   if (words > 0) {
+      acc = XMALLOC(words * sizeof(ulong64));
+      buf = XMALLOC(words * 8);
+      if (acc == NULL || buf == NULL) {
+         err = CRYPT_MEM;
+         goto free_buf;
+      }
+      if ((err = mp_init(&g)) != CRYPT_OK) {
+         goto free_buf;
+      }
+   }
+
+   if ((err = mp_init_copy(&t, comb[0].T[0])) != CRYPT_OK) {
+      goto free_buf;
+   }
+
+   for (col = comb[0].cols - 1; col >= 0; col--) {
+      if ((err = mp_sqr(t, t)) != CRYPT_OK)                                      { goto done; }
+      if ((err = mp_montgomery_reduce(t, modulus, mp)) != CRYPT_OK)              { goto done; }
+      for (i = 0; i < n; i++) {
+         tooth = s_comb_column(&comb[i], e[i], elen[i], col);
+         if (secret && comb[i].packed != NULL) {
+            s_comb_gather(&comb[i], tooth, acc);
+            for (w = 0; w < comb[i].words; w++) {
+               STORE64H(acc[w], buf + 8 * w);
+            }
+            if ((err = mp_read_unsigned_bin(g, buf, comb[i].words * 8)) != CRYPT_OK) { goto done; }
+            if ((err = mp_mul(t, g, t)) != CRYPT_OK)                                 { goto done; }
+            if ((err = mp_montgomery_reduce(t, modulus, mp)) != CRYPT_OK)            { goto done; }
+         } else if (tooth != 0) {
+            if ((err = mp_mul(t, comb[i].T[tooth], t)) != CRYPT_OK)              { goto done; }
+            if ((err = mp_montgomery_reduce(t, modulus, mp)) != CRYPT_OK)        { goto done; }
+         }
+      }
+   }
+
+   /* leave montgomery form */
+   if ((err = mp_montgomery_reduce(t, modulus, mp)) != CRYPT_OK)                 { goto done; }
+   err = mp_copy(t, y);
+
+done:
+   mp_clear(t);
+free_buf:
+   if (g != NULL) {
+      mp_clear(g);
+   }
+   if (acc != NULL) {
+      zeromem(acc, words * sizeof(ulong64));
+      XFREE(acc);
+   }
+   if (buf != NULL) {
+      zeromem(buf, words * 8);
+      XFREE(buf);
+   }
+   return err;
+}
+
+#endif
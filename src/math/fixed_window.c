@@ -0,0 +1,170 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file fixed_window.c
+  Fixed-window modular exponentiation for secret exponents
+*/
+
+#ifdef LTC_MPI_FIXED_WINDOW
+
+/* the window size, 6 bits pay off for exponents of more than 1536 bits */
+static int s_window_size(unsigned long bits)
+{
+   return bits > 1536 ? 6 : 5;
+}
+
+/* store a into column `idx` of the interleaved table, so that all entries share the same cache lines */
+static int s_scatter(unsigned long *tbl, unsigned char *buf, unsigned long size, unsigned long entries,
+                     unsigned long idx, void *a)
+{
+   unsigned long j, len;
+   int err;
+
+   len = mp_unsigned_bin_size(a);
+   if (len > size) {
+      return CRYPT_BUFFER_OVERFLOW;
+   }
+   zeromem(buf, size - len);
+   if ((err = mp_to_unsigned_bin(a, buf + size - len)) != CRYPT_OK) {
+      return err;
+   }
+   for (j = 0; j < size / sizeof(unsigned long); j++) {
+      XMEMCPY(&tbl[j * entries + idx], buf + j * sizeof(unsigned long), sizeof(unsigned long));
+   }
+   return CRYPT_OK;
+}
+
+/* load entry `idx` of the table into a, every entry is read regardless of idx */
+static int s_gather(const unsigned long *tbl, unsigned char *buf, unsigned long size, unsigned long entries,
+                    unsigned long idx, void *a)
+{
+   unsigned long mask[64], acc, i, j;
+
+   for (i = 0; i < entries; i++) {
+      /* all ones if i == idx, 0 otherwise */
+      mask[i] = 0UL - (((i ^ idx) - 1UL) >> (sizeof(unsigned long) * CHAR_BIT - 1));
+   }
+   for (j = 0; j < size / sizeof(unsigned long); j++) {
+      acc = 0;
+      for (i = 0; i < entries; i++) {
+         acc |= tbl[j * entries + i] & mask[i];
+      }
+      XMEMCPY(buf + j * sizeof(unsigned long), &acc, sizeof(unsigned long));
+   }
+   return mp_read_unsigned_bin(a, buf, size);
+}
+
+/* the `w` bits of the exponent starting at bit `bit` */
+static unsigned long s_window(const unsigned char *e, unsigned long elen, unsigned long bit, int w)
+{
+   unsigned long win = 0, b;
+   int i;
+
+   for (i = w - 1; i >= 0; i--) {
+      b = bit + (unsigned long)i;
+      win <<= 1;
+      if (b < elen * 8) {
+         win |= (e[elen - 1 - b / 8] >> (b % 8)) & 1;
+      }
+   }
+   return win;
+}
+
+/**
+  Compute Y = G^X mod P with a fixed window, for secret exponents
+
+  Every window costs the same number of squarings and one multiplication, and the
+  precomputed powers are read in full for every window, so neither the operation
+  sequence nor the table accesses depend on the bits of the exponent.
+  The arithmetic itself is done by the math descriptor, which is not constant time.
+  @param G   The base
+  @param X   The exponent, must be non-negative
+  @param P   The modulus
+  @param Y   [out] The result
+  @return CRYPT_OK if successful
+*/
+int ltc_mp_fixed_window_exptmod(void *G, void *X, void *P, void *Y)
+{
+   void          *a, *g, *mp;
+   unsigned long *tbl;
+   unsigned char *buf, *e;
+   unsigned long  size, elen, entries, bits, i, win, alloc;
+   int            w, k, err;
+
+   LTC_ARGCHK(G != NULL);
+   LTC_ARGCHK(X != NULL);
+   LTC_ARGCHK(P != NULL);
+   LTC_ARGCHK(Y != NULL);
+
+   /* montgomery needs an odd modulus, and a zero exponent is nothing to hide */
+   if (mp_isodd(P) != LTC_MP_YES || mp_iszero(X) == LTC_MP_YES || mp_cmp_d(P, 1) != LTC_MP_GT) {
+      return mp_exptmod(G, X, P, Y);
+   }
+
+   /* the entries are padded to whole words */
+   size    = mp_unsigned_bin_size(P);
+   size    = (size + sizeof(unsigned long) - 1) & ~(sizeof(unsigned long) - 1);
+   elen    = mp_unsigned_bin_size(X);
+   w       = s_window_size(elen * 8);
+   entries = 1UL << w;
+   bits    = ((elen * 8 + (unsigned long)w - 1) / (unsigned long)w) * (unsigned long)w;
+
+   alloc = size * entries + size + elen;
+   tbl = XMALLOC(alloc);
+   if (tbl == NULL) {
+      return CRYPT_MEM;
+   }
+   buf = (unsigned char *)tbl + size * entries;
+   e   = buf + size;
+
+   if ((err = mp_to_unsigned_bin(X, e)) != CRYPT_OK)                                   { goto LBL_ERRBUF; }
+   if ((err = mp_montgomery_setup(P, &mp)) != CRYPT_OK)                                { goto LBL_ERRBUF; }
+   if ((err = mp_init_multi(&a, &g, LTC_NULL)) != CRYPT_OK)                            { goto LBL_ERRMP; }
+
+   /* the powers 0 .. entries-1 of G in montgomery form */
+   if ((err = mp_montgomery_normalization(a, P)) != CRYPT_OK)                          { goto LBL_ERR; }
+   if ((err = s_scatter(tbl, buf, size, entries, 0, a)) != CRYPT_OK)                   { goto LBL_ERR; }
+   if ((err = mp_mulmod(G, a, P, g)) != CRYPT_OK)                                      { goto LBL_ERR; }
+   if ((err = s_scatter(tbl, buf, size, entries, 1, g)) != CRYPT_OK)                   { goto LBL_ERR; }
+   if ((err = mp_copy(g, a)) != CRYPT_OK)                                              { goto LBL_ERR; }
+   for (i = 2; i < entries; i++) {
+      if ((err = mp_mul(a, g, a)) != CRYPT_OK)                                         { goto LBL_ERR; }
+      if ((err = mp_montgomery_reduce(a, P, mp)) != CRYPT_OK)                          { goto LBL_ERR; }
+      if ((err = s_scatter(tbl, buf, size, entries, i, a)) != CRYPT_OK)                { goto LBL_ERR; }
+   }
+
+   /* the top window initializes the result */
+   bits -= (unsigned long)w;
+   win = s_window(e, elen, bits, w);
+   if ((err = s_gather(tbl, buf, size, entries, win, a)) != CRYPT_OK)                  { goto LBL_ERR; }
+
+   while (bits > 0) {
+      bits -= (unsigned long)w;
+      for (k = 0; k < w; k++) {
+         if ((err = mp_sqr(a, a)) != CRYPT_OK)                                         { goto LBL_ERR; }
+         if ((err = mp_montgomery_reduce(a, P, mp)) != CRYPT_OK)                       { goto LBL_ERR; }
+      }
+      /* always multiply, an all-zero window multiplies by "1" */
+      win = s_window(e, elen, bits, w);
+      if ((err = s_gather(tbl, buf, size, entries, win, g)) != CRYPT_OK)               { goto LBL_ERR; }
+      if ((err = mp_mul(a, g, a)) != CRYPT_OK)                                         { goto LBL_ERR; }
+      if ((err = mp_montgomery_reduce(a, P, mp)) != CRYPT_OK)                          { goto LBL_ERR; }
+   }
+
+   /* leave montgomery form */
+   if ((err = mp_montgomery_reduce(a, P, mp)) != CRYPT_OK)                             { goto LBL_ERR; }
+   err = mp_copy(a, Y);
+
+LBL_ERR:
+   mp_clear_multi(a, g, LTC_NULL);
+LBL_ERRMP:
+   mp_montgomery_free(mp);
+LBL_ERRBUF:
+   zeromem(tbl, alloc);
+   XFREE(tbl);
+   return err;
+}
+
+#endif /* LTC_MPI_FIXED_WINDOW */
@@ -9,10 +9,21 @@
 #include <stdio.h>
 #include <gmp.h>
 
+static void release(void *a)
+{
+   mpz_clear(a);
+   XFREE(a);
+}
+
 static int init(void **a)
 {
    LTC_ARGCHK(a != NULL);
 
+#ifdef LTC_MPI_SCRATCH
+   if ((*a = ltc_mp_scratch_get(release)) != NULL) {
+      return CRYPT_OK;
+   }
+#endif
    *a = XCALLOC(1, sizeof(__mpz_struct));
    if (*a == NULL) {
       return CRYPT_MEM;
@@ -24,8 +35,15 @@ static int init(void **a)
 static void deinit(void *a)
 {
    LTC_ARGCHKVD(a != NULL);
-   mpz_clear(a);
-   XFREE(a);
+#ifdef LTC_MPI_SCRATCH
+   /* wipe all allocated limbs before handing the number out again */
+   zeromem(((__mpz_struct *)a)->_mp_d, ((__mpz_struct *)a)->_mp_alloc * sizeof(mp_limb_t));
+   mpz_set_ui(a, 0);
+   if (ltc_mp_scratch_put(a, release) == CRYPT_OK) {
+      return;
+   }
+#endif
+   release(a);
 }
 
 static int neg(const void *a, void *b)
@@ -652,6 +670,7 @@ const ltc_math_descriptor gmp_desc = {
 
    &set_rand,
 
+   0
 };
 
 
@@ -53,12 +53,23 @@ static int init_mpi(void **a)
    }
 }
 
+static void release(void *a)
+{
+   mp_clear(a);
+   XFREE(a);
+}
+
 static int init(void **a)
 {
    int err;
 
    LTC_ARGCHK(a != NULL);
 
+#ifdef LTC_MPI_SCRATCH
+   if ((*a = ltc_mp_scratch_get(release)) != NULL) {
+      return CRYPT_OK;
+   }
+#endif
    if ((err = init_mpi(a)) != CRYPT_OK) {
       return err;
    }
@@ -71,8 +82,14 @@ static int init(void **a)
 static void deinit(void *a)
 {
    LTC_ARGCHKVD(a != NULL);
-   mp_clear(a);
-   XFREE(a);
+#ifdef LTC_MPI_SCRATCH
+   /* mp_zero() also wipes all allocated digits */
+   mp_zero(a);
+   if (ltc_mp_scratch_put(a, release) == CRYPT_OK) {
+      return;
+   }
+#endif
+   release(a);
 }
 
 static int neg(const void *a, void *b)
@@ -94,6 +111,16 @@ static int init_copy(void **a, const void *b)
    int err;
    LTC_ARGCHK(a  != NULL);
    LTC_ARGCHK(b  != NULL);
+#ifdef LTC_MPI_SCRATCH
+   if ((*a = ltc_mp_scratch_get(release)) != NULL) {
+      if ((err = mpi_to_ltc_error(mp_copy(b, *a))) != CRYPT_OK) {
+         /* the callers don't clean up after a failed init, mp_clear() also wipes what was copied */
+         release(*a);
+         *a = NULL;
+      }
+      return err;
+   }
+#endif
    if ((err = init_mpi(a)) != CRYPT_OK) return err;
    return mpi_to_ltc_error(mp_init_copy(*a, b));
 }
@@ -554,6 +581,7 @@ const ltc_math_descriptor ltm_desc = {
 
    &set_rand,
 
+   1
 };
 
 
@@ -0,0 +1,79 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file scratch.c
+  Per-thread cache of released bignums, so temporaries in the PK routines
+  don't cost a round trip through the heap on every mp_init()/mp_clear().
+*/
+
+#ifdef LTC_MPI_SCRATCH
+
+typedef struct {
+   /* the deinit() of the math descriptor which owns the cached bignums */
+   void (*release)(void *a);
+   int    used;
+   void  *slot[LTC_MPI_SCRATCH_SLOTS];
+} ltc_mp_scratch;
+
+static LTC_THREAD_LOCAL ltc_mp_scratch s_scratch;
+
+static void s_scratch_drain(void)
+{
+   while (s_scratch.used > 0) {
+      s_scratch.used--;
+      s_scratch.release(s_scratch.slot[s_scratch.used]);
+      s_scratch.slot[s_scratch.used] = NULL;
+   }
+}
+
+/**
+   Fetch a cached bignum
+   @param release   The deinit() function of the calling math descriptor
+   @return A zero-valued, initialized bignum or NULL if none is cached
+*/
+void *ltc_mp_scratch_get(void (*release)(void *a))
+{
+   if (s_scratch.release != release || s_scratch.used == 0) {
+      return NULL;
+   }
+   s_scratch.used--;
+   return s_scratch.slot[s_scratch.used];
+}
+
+/**
+   Put a bignum into the cache
+   @param a         The bignum, it must already be wiped and set to zero
+   @param release   The deinit() function of the calling math descriptor
+   @return CRYPT_OK if the bignum was cached, CRYPT_MEM if the cache is full
+*/
+int ltc_mp_scratch_put(void *a, void (*release)(void *a))
+{
+   if (s_scratch.release != release) {
+      /* the math provider was switched, don't mix up bignums of different types */
+      if (s_scratch.release != NULL) {
+         s_scratch_drain();
+      }
+      s_scratch.release = release;
+   }
+   if (s_scratch.used == LTC_MPI_SCRATCH_SLOTS) {
+      return CRYPT_MEM;
+   }
+   s_scratch.slot[s_scratch.used++] = a;
+   return CRYPT_OK;
+}
+
+/**
+   Release all bignums cached by the calling thread,
+   call this before a thread exits or before unloading the math provider.
+*/
+void ltc_mp_scratch_flush(void)
+{
+   if (s_scratch.release != NULL) {
+      s_scratch_drain();
+      s_scratch.release = NULL;
+   }
+}
+
+#endif
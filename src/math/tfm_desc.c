@@ -47,10 +47,20 @@ static int tfm_to_ltc_error(int err)
    return CRYPT_ERROR;
 }
 
+static void release(void *a)
+{
+   XFREE(a);
+}
+
 static int init(void **a)
 {
    LTC_ARGCHK(a != NULL);
 
+#ifdef LTC_MPI_SCRATCH
+   if ((*a = ltc_mp_scratch_get(release)) != NULL) {
+      return CRYPT_OK;
+   }
+#endif
    *a = XCALLOC(1, sizeof(fp_int));
    if (*a == NULL) {
       return CRYPT_MEM;
@@ -62,7 +72,14 @@ static int init(void **a)
 static void deinit(void *a)
 {
    LTC_ARGCHKVD(a != NULL);
-   XFREE(a);
+#ifdef LTC_MPI_SCRATCH
+   /* fp_init() wipes the whole fp_int */
+   fp_init(a);
+   if (ltc_mp_scratch_put(a, release) == CRYPT_OK) {
+      return;
+   }
+#endif
+   release(a);
 }
 
 static int neg(const void *a, void *b)
@@ -869,6 +886,7 @@ const ltc_math_descriptor tfm_desc = {
 
    set_rand,
 
+   1
 };
 
 
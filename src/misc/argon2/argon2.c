@@ -0,0 +1,424 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+   @file argon2.c
+   Argon2 memory-hard password hashing, RFC 9106
+*/
+#ifdef LTC_ARGON2
+
+#define ARGON2_VERSION        0x13
+#define ARGON2_BLOCK_WORDS    128
+#define ARGON2_BLOCK_SIZE     (ARGON2_BLOCK_WORDS * 8)
+#define ARGON2_SYNC_POINTS    4
+#define ARGON2_PREHASH_LEN    64
+
+typedef struct {
+   ulong64 v[ARGON2_BLOCK_WORDS];
+} argon2_block;
+
+/* the instance parameters as derived from the inputs */
+struct argon2_instance {
+   argon2_block *memory;
+   ulong64 blocks;
+   ulong64 lanes;
+   ulong64 lane_length;
+   ulong64 segment_length;
+   ulong64 passes;
+   argon2_type type;
+};
+
+#define ARGON2_FBLAMKA(x, y) ((x) + (y) + 2 * ((x) & CONST64(0xFFFFFFFF)) * ((y) & CONST64(0xFFFFFFFF)))
+
+#define ARGON2_GB(a, b, c, d)                 \
+   do {                                       \
+      a = ARGON2_FBLAMKA(a, b);               \
+      d = ROR64(d ^ a, 32);                   \
+      c = ARGON2_FBLAMKA(c, d);               \
+      b = ROR64(b ^ c, 24);                   \
+      a = ARGON2_FBLAMKA(a, b);               \
+      d = ROR64(d ^ a, 16);                   \
+      c = ARGON2_FBLAMKA(c, d);               \
+      b = ROR64(b ^ c, 63);                   \
+   } while (0)
+
+#define ARGON2_ROUND(v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15) \
+   do {                                       \
+      ARGON2_GB(v0, v4, v8, v12);             \
+      ARGON2_GB(v1, v5, v9, v13);             \
+      ARGON2_GB(v2, v6, v10, v14);            \
+      ARGON2_GB(v3, v7, v11, v15);            \
+      ARGON2_GB(v0, v5, v10, v15);            \
+      ARGON2_GB(v1, v6, v11, v12);            \
+      ARGON2_GB(v2, v7, v8, v13);             \
+      ARGON2_GB(v3, v4, v9, v14);             \
+   } while (0)
+
+/* next = G(prev, ref), or next ^= G(prev, ref) if with_xor is set */
+static void s_argon2_fill_block(const argon2_block *prev, const argon2_block *ref, argon2_block *next, int with_xor)
+{
+   argon2_block r, tmp;
+   ulong64 *v;
+   int i;
+
+   for (i = 0; i < ARGON2_BLOCK_WORDS; ++i) {
+      r.v[i] = prev->v[i] ^ ref->v[i];
+      tmp.v[i] = with_xor ? r.v[i] ^ next->v[i] : r.v[i];
+   }
+
+   v = r.v;
+   /* the rows of 16 words */
+   for (i = 0; i < 8; ++i) {
+      ARGON2_ROUND(v[16 * i],      v[16 * i + 1],  v[16 * i + 2],  v[16 * i + 3],
+                   v[16 * i + 4],  v[16 * i + 5],  v[16 * i + 6],  v[16 * i + 7],
+                   v[16 * i + 8],  v[16 * i + 9],  v[16 * i + 10], v[16 * i + 11],
+                   v[16 * i + 12], v[16 * i + 13], v[16 * i + 14], v[16 * i + 15]);
+   }
+   /* the columns of 8 pairs of words */
+   for (i = 0; i < 8; ++i) {
+      ARGON2_ROUND(v[2 * i],       v[2 * i + 1],   v[2 * i + 16],  v[2 * i + 17],
+                   v[2 * i + 32],  v[2 * i + 33],  v[2 * i + 48],  v[2 * i + 49],
+                   v[2 * i + 64],  v[2 * i + 65],  v[2 * i + 80],  v[2 * i + 81],
+                   v[2 * i + 96],  v[2 * i + 97],  v[2 * i + 112], v[2 * i + 113]);
+   }
+
+   for (i = 0; i < ARGON2_BLOCK_WORDS; ++i) {
+      next->v[i] = tmp.v[i] ^ r.v[i];
+   }
+}
+
+/* the variable-length hash function H' */
+static int s_argon2_hprime(unsigned char *out, unsigned long outlen, const unsigned char *in, unsigned long inlen)
+{
+   hash_state md;
+   unsigned char buf[4], v[64];
+   unsigned long toproduce;
+   int err;
+
+   STORE32L(outlen, buf);
+   if ((err = blake2b_init(&md, MIN(outlen, 64), NULL, 0)) != CRYPT_OK)        { goto LBL_ERR; }
+   if ((err = blake2b_process(&md, buf, 4)) != CRYPT_OK)                        { goto LBL_ERR; }
+   if ((err = blake2b_process(&md, in, inlen)) != CRYPT_OK)                     { goto LBL_ERR; }
+   if (outlen <= 64) {
+      err = blake2b_done(&md, out);
+      goto LBL_ERR;
+   }
+   if ((err = blake2b_done(&md, v)) != CRYPT_OK)                                { goto LBL_ERR; }
+
+   /* emit the first half of each intermediate hash, the last one in full */
+   XMEMCPY(out, v, 32);
+   out += 32;
+   toproduce = outlen - 32;
+   while (toproduce > 64) {
+      if ((err = blake2b_init(&md, 64, NULL, 0)) != CRYPT_OK)                   { goto LBL_ERR; }
+      if ((err = blake2b_process(&md, v, 64)) != CRYPT_OK)                      { goto LBL_ERR; }
+      if ((err = blake2b_done(&md, v)) != CRYPT_OK)                             { goto LBL_ERR; }
+      XMEMCPY(out, v, 32);
+      out += 32;
+      toproduce -= 32;
+   }
+   if ((err = blake2b_init(&md, toproduce, NULL, 0)) != CRYPT_OK)               { goto LBL_ERR; }
+   if ((err = blake2b_process(&md, v, 64)) != CRYPT_OK)                         { goto LBL_ERR; }
+   err = blake2b_done(&md, out);
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(&md, sizeof(md));
+   zeromem(v, sizeof(v));
+#endif
+   return err;
+}
+
+static int s_argon2_process_le32(hash_state *md, unsigned long x)
+{
+   unsigned char buf[4];
+   STORE32L(x, buf);
+   return blake2b_process(md, buf, 4);
+}
+
+static int s_argon2_process_data(hash_state *md, const unsigned char *in, unsigned long inlen)
+{
+   int err;
+   if ((err = s_argon2_process_le32(md, inlen)) != CRYPT_OK) {
+      return err;
+   }
+   if (inlen == 0) {
+      return CRYPT_OK;
+   }
+   return blake2b_process(md, in, inlen);
+}
+
+/* generate the next block of pseudo-random reference positions for data-independent addressing */
+static void s_argon2_next_addresses(argon2_block *address, argon2_block *input, const argon2_block *zero)
+{
+   input->v[6]++;
+   s_argon2_fill_block(zero, input, address, 0);
+   s_argon2_fill_block(zero, address, address, 0);
+}
+
+/* map the pseudo-random value to the index of the reference block within its lane */
+static ulong64 s_argon2_index_alpha(const struct argon2_instance *inst, ulong64 pass, ulong64 slice, ulong64 index,
+                                    ulong64 pseudo_rand, int same_lane)
+{
+   ulong64 area, rel, start;
+
+   if (pass == 0) {
+      if (slice == 0) {
+         area = index - 1;
+      } else if (same_lane) {
+         area = slice * inst->segment_length + index - 1;
+      } else {
+         area = slice * inst->segment_length - (index == 0 ? 1 : 0);
+      }
+   } else {
+      if (same_lane) {
+         area = inst->lane_length - inst->segment_length + index - 1;
+      } else {
+         area = inst->lane_length - inst->segment_length - (index == 0 ? 1 : 0);
+      }
+   }
+
+   rel = pseudo_rand & CONST64(0xFFFFFFFF);
+   rel = (rel * rel) >> 32;
+   rel = area - 1 - ((area * rel) >> 32);
+
+   start = 0;
+   if (pass != 0 && slice != ARGON2_SYNC_POINTS - 1) {
+      start = (slice + 1) * inst->segment_length;
+   }
+   return (start + rel) % inst->lane_length;
+}
+
+static void s_argon2_fill_segment(const struct argon2_instance *inst, ulong64 pass, ulong64 lane, ulong64 slice,
+                                  argon2_block *scratch)
+{
+   argon2_block *address = &scratch[0], *input = &scratch[1], *zero = &scratch[2];
+   ulong64 i, start, cur, prev, pseudo_rand, ref_lane, ref_index;
+   int data_independent;
+
+   data_independent = (inst->type == LTC_ARGON2_I)
+                   || (inst->type == LTC_ARGON2_ID && pass == 0 && slice < ARGON2_SYNC_POINTS / 2);
+
+   if (data_independent) {
+      zeromem(zero, sizeof(*zero));
+      zeromem(input, sizeof(*input));
+      input->v[0] = pass;
+      input->v[1] = lane;
+      input->v[2] = slice;
+      input->v[3] = inst->blocks;
+      input->v[4] = inst->passes;
+      input->v[5] = (ulong64)inst->type;
+   }
+
+   start = 0;
+   if (pass == 0 && slice == 0) {
+      /* the first two blocks of each lane are already computed */
+      start = 2;
+      if (data_independent) {
+         s_argon2_next_addresses(address, input, zero);
+      }
+   }
+
+   cur = lane * inst->lane_length + slice * inst->segment_length + start;
+   prev = (cur % inst->lane_length == 0) ? cur + inst->lane_length - 1 : cur - 1;
+
+   for (i = start; i < inst->segment_length; ++i, ++cur, ++prev) {
+      if (cur % inst->lane_length == 1) {
+         prev = cur - 1;
+      }
+      if (data_independent) {
+         if (i % ARGON2_BLOCK_WORDS == 0) {
+            s_argon2_next_addresses(address, input, zero);
+         }
+         pseudo_rand = address->v[i % ARGON2_BLOCK_WORDS];
+      } else {
+         pseudo_rand = inst->memory[prev].v[0];
+      }
+
+      ref_lane = (pseudo_rand >> 32) % inst->lanes;
+      if (pass == 0 && slice == 0) {
+         ref_lane = lane;
+      }
+      ref_index = s_argon2_index_alpha(inst, pass, slice, i, pseudo_rand, ref_lane == lane);
+
+      s_argon2_fill_block(&inst->memory[prev], &inst->memory[inst->lane_length * ref_lane + ref_index],
+                          &inst->memory[cur], pass != 0);
+   }
+}
+
+/**
+   Initialize an Argon2 memory arena, which can be reused by several calls of argon2_hash()
+   @param arena   [out] The arena
+   @return CRYPT_OK if successful
+*/
+int argon2_arena_init(argon2_arena *arena)
+{
+   LTC_ARGCHK(arena != NULL);
+
+   arena->memory = NULL;
+   arena->size = 0;
+   return CRYPT_OK;
+}
+
+/**
+   Release the memory of an Argon2 arena
+   @param arena   The arena
+*/
+void argon2_arena_free(argon2_arena *arena)
+{
+   LTC_ARGCHKVD(arena != NULL);
+
+   if (arena->memory != NULL) {
+      zeromem(arena->memory, arena->size);
+      XFREE(arena->memory);
+   }
+   arena->memory = NULL;
+   arena->size = 0;
+}
+
+/**
+   Argon2 password hashing, RFC 9106
+   @param type              The variant, LTC_ARGON2_D, LTC_ARGON2_I or LTC_ARGON2_ID
+   @param t_cost            The number of passes over the memory
+   @param m_cost            The memory size in KiB, at least 8 * parallelism
+   @param parallelism       The number of lanes
+   @param password          The password
+   @param password_len      The length of the password (octets)
+   @param salt              The salt
+   @param salt_len          The length of the salt (octets), at least 8
+   @param secret            The optional secret value (can be NULL)
+   @param secret_len        The length of the secret value (octets)
+   @param ad                The optional associated data (can be NULL)
+   @param ad_len            The length of the associated data (octets)
+   @param arena             The memory arena to use (can be NULL)
+   @param out               [out] The destination for the tag
+   @param outlen            The desired length of the tag (octets), at least 4
+   @return CRYPT_OK if successful
+*/
+int argon2_hash(argon2_type type, unsigned long t_cost, unsigned long m_cost, unsigned long parallelism,
+                const unsigned char *password, unsigned long password_len,
+                const unsigned char *salt,     unsigned long salt_len,
+                const unsigned char *secret,   unsigned long secret_len,
+                const unsigned char *ad,       unsigned long ad_len,
+                argon2_arena *arena,
+                unsigned char *out,            unsigned long outlen)
+{
+   struct argon2_instance inst;
+   argon2_block *scratch;
+   hash_state md;
+   unsigned char h0[ARGON2_PREHASH_LEN + 8], blk[ARGON2_BLOCK_SIZE];
+   unsigned long size, n, w;
+   ulong64 pass, slice, lane;
+   int err;
+
+   LTC_ARGCHK(password != NULL || password_len == 0);
+   LTC_ARGCHK(salt     != NULL);
+   LTC_ARGCHK(secret   != NULL || secret_len == 0);
+   LTC_ARGCHK(ad       != NULL || ad_len == 0);
+   LTC_ARGCHK(out      != NULL);
+
+   if (type != LTC_ARGON2_D && type != LTC_ARGON2_I && type != LTC_ARGON2_ID) {
+      return CRYPT_INVALID_ARG;
+   }
+   if (t_cost == 0 || parallelism == 0 || parallelism > 0xFFFFFFUL || outlen < 4 || salt_len < 8) {
+      return CRYPT_INVALID_ARG;
+   }
+   /* everything that goes into H0 is encoded with 32 bits */
+   if ((ulong64)t_cost > CONST64(0xFFFFFFFF) || (ulong64)m_cost > CONST64(0xFFFFFFFF) ||
+       (ulong64)outlen > CONST64(0xFFFFFFFF) || (ulong64)password_len > CONST64(0xFFFFFFFF) ||
+       (ulong64)salt_len > CONST64(0xFFFFFFFF) || (ulong64)secret_len > CONST64(0xFFFFFFFF) ||
+       (ulong64)ad_len > CONST64(0xFFFFFFFF)) {
+      return CRYPT_INVALID_ARG;
+   }
+   if (m_cost < 8 * parallelism) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   inst.type           = type;
+   inst.passes         = t_cost;
+   inst.lanes          = parallelism;
+   inst.segment_length = m_cost / (parallelism * ARGON2_SYNC_POINTS);
+   inst.lane_length    = inst.segment_length * ARGON2_SYNC_POINTS;
+   inst.blocks         = inst.lane_length * inst.lanes;
+
+   /* the blocks plus three scratch blocks for the address generation */
+   if (inst.blocks + 3 > ((unsigned long)-1) / sizeof(argon2_block)) {
+      return CRYPT_OVERFLOW;
+   }
+   size = (unsigned long)(inst.blocks + 3) * sizeof(argon2_block);
+
+   if (arena != NULL) {
+      if (arena->size < size) {
+         argon2_arena_free(arena);
+         if ((arena->memory = XMALLOC(size)) == NULL) {
+            return CRYPT_MEM;
+         }
+         arena->size = size;
+      }
+      inst.memory = arena->memory;
+   } else if ((inst.memory = XMALLOC(size)) == NULL) {
+      return CRYPT_MEM;
+   }
+   scratch = &inst.memory[inst.blocks];
+
+   /* H0 */
+   if ((err = blake2b_init(&md, ARGON2_PREHASH_LEN, NULL, 0)) != CRYPT_OK)      { goto LBL_ERR; }
+   if ((err = s_argon2_process_le32(&md, parallelism)) != CRYPT_OK)             { goto LBL_ERR; }
+   if ((err = s_argon2_process_le32(&md, outlen)) != CRYPT_OK)                  { goto LBL_ERR; }
+   if ((err = s_argon2_process_le32(&md, m_cost)) != CRYPT_OK)                  { goto LBL_ERR; }
+   if ((err = s_argon2_process_le32(&md, t_cost)) != CRYPT_OK)                  { goto LBL_ERR; }
+   if ((err = s_argon2_process_le32(&md, ARGON2_VERSION)) != CRYPT_OK)          { goto LBL_ERR; }
+   if ((err = s_argon2_process_le32(&md, (unsigned long)type)) != CRYPT_OK)     { goto LBL_ERR; }
+   if ((err = s_argon2_process_data(&md, password, password_len)) != CRYPT_OK)  { goto LBL_ERR; }
+   if ((err = s_argon2_process_data(&md, salt, salt_len)) != CRYPT_OK)          { goto LBL_ERR; }
+   if ((err = s_argon2_process_data(&md, secret, secret_len)) != CRYPT_OK)      { goto LBL_ERR; }
+   if ((err = s_argon2_process_data(&md, ad, ad_len)) != CRYPT_OK)              { goto LBL_ERR; }
+   if ((err = blake2b_done(&md, h0)) != CRYPT_OK)                               { goto LBL_ERR; }
+
+   /* the first two blocks of each lane */
+   for (lane = 0; lane < inst.lanes; ++lane) {
+      STORE32L(lane, h0 + ARGON2_PREHASH_LEN + 4);
+      for (n = 0; n < 2; ++n) {
+         STORE32L(n, h0 + ARGON2_PREHASH_LEN);
+         if ((err = s_argon2_hprime(blk, sizeof(blk), h0, sizeof(h0))) != CRYPT_OK) { goto LBL_ERR; }
+         for (w = 0; w < ARGON2_BLOCK_WORDS; ++w) {
+            LOAD64L(inst.memory[lane * inst.lane_length + n].v[w], blk + 8 * w);
+         }
+      }
+   }
+
+   /* the lanes of a slice are independent of each other, they are processed one after another */
+   for (pass = 0; pass < inst.passes; ++pass) {
+      for (slice = 0; slice < ARGON2_SYNC_POINTS; ++slice) {
+         for (lane = 0; lane < inst.lanes; ++lane) {
+            s_argon2_fill_segment(&inst, pass, lane, slice, scratch);
+         }
+      }
+   }
+
+   /* the final block is the XOR of the last block of each lane */
+   for (lane = 1; lane < inst.lanes; ++lane) {
+      for (n = 0; n < ARGON2_BLOCK_WORDS; ++n) {
+         inst.memory[inst.lane_length - 1].v[n] ^= inst.memory[lane * inst.lane_length + inst.lane_length - 1].v[n];
+      }
+   }
+   for (n = 0; n < ARGON2_BLOCK_WORDS; ++n) {
+      STORE64L(inst.memory[inst.lane_length - 1].v[n], blk + 8 * n);
+   }
+   err = s_argon2_hprime(out, outlen, blk, sizeof(blk));
+
+LBL_ERR:
+   zeromem(inst.memory, size);
+   zeromem(h0, sizeof(h0));
+   zeromem(blk, sizeof(blk));
+#ifdef LTC_CLEAN_STACK
+   zeromem(&md, sizeof(md));
+#endif
+   if (arena == NULL) {
+      XFREE(inst.memory);
+   }
+   return err;
+}
+
+#endif
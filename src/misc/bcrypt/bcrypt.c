@@ -11,55 +11,50 @@
 #define BCRYPT_WORDS 8
 #define BCRYPT_HASHSIZE (BCRYPT_WORDS * 4)
 
-static int s_bcrypt_hash(const unsigned char *pt,
-                        const unsigned char *pass, unsigned long passlen,
-                        const unsigned char *salt, unsigned long saltlen,
-                              unsigned char *out,  unsigned long *outlen)
-{
+/* everything a call of bcrypt_pbkdf_openbsd() works on, allocated once per call */
+struct bcrypt_arena {
    symmetric_key key;
+   hash_state    md;
+   ulong32       ct[BCRYPT_WORDS];
+   unsigned char hashed_pass[MAXBLOCKSIZE];
+   unsigned char salt[MAXBLOCKSIZE];
+   unsigned char tmp[BCRYPT_HASHSIZE];
+   unsigned char res[BCRYPT_HASHSIZE];
+};
+
+/* the bcrypt core of the pbkdf, hash a.salt with a.hashed_pass into a.tmp */
+static int s_bcrypt_pbkdf_hash(struct bcrypt_arena *a, unsigned long passlen, unsigned long saltlen)
+{
+   const unsigned char pt[] = "OxychromaticBlowfishSwatDynamite";
    int err, n;
-   ulong32 ct[BCRYPT_WORDS];
 
-   if ((err = blowfish_setup_with_data(pass, passlen, salt, saltlen, &key)) != CRYPT_OK) {
+   if ((err = blowfish_setup_with_data(a->hashed_pass, passlen, a->salt, saltlen, &a->key)) != CRYPT_OK) {
       return err;
    }
    for (n = 0; n < 64; ++n) {
-      if ((err = blowfish_expand(salt, saltlen, NULL, 0, &key)) != CRYPT_OK) {
+      if ((err = blowfish_expand(a->salt, saltlen, NULL, 0, &a->key)) != CRYPT_OK) {
          return err;
       }
-      if ((err = blowfish_expand(pass, passlen, NULL, 0, &key)) != CRYPT_OK) {
+      if ((err = blowfish_expand(a->hashed_pass, passlen, NULL, 0, &a->key)) != CRYPT_OK) {
          return err;
       }
    }
 
    for (n = 0; n < BCRYPT_WORDS; ++n) {
-      LOAD32H(ct[n], &pt[n*4]);
+      LOAD32H(a->ct[n], &pt[n*4]);
    }
 
    for (n = 0; n < 64; ++n) {
-      blowfish_enc(ct, BCRYPT_WORDS/2, &key);
+      blowfish_enc(a->ct, BCRYPT_WORDS/2, &a->key);
    }
 
    for (n = 0; n < BCRYPT_WORDS; ++n) {
-      STORE32L(ct[n], &out[4 * n]);
+      STORE32L(a->ct[n], &a->tmp[4 * n]);
    }
-   *outlen = sizeof(ct);
-#ifdef LTC_CLEAN_STACK
-   zeromem(&key, sizeof(key));
-   zeromem(ct, sizeof(ct));
-#endif
 
    return CRYPT_OK;
 }
 
-static int s_bcrypt_pbkdf_hash(const unsigned char *pass, unsigned long passlen,
-                         const unsigned char *salt, unsigned long saltlen,
-                               unsigned char *out,  unsigned long *outlen)
-{
-   const unsigned char pt[] = "OxychromaticBlowfishSwatDynamite";
-   return s_bcrypt_hash(pt, pass, passlen, salt, saltlen, out, outlen);
-}
-
 /**
    Compatible to bcrypt_pbkdf() as provided in OpenBSD
    @param password          The input password (or key)
@@ -79,9 +74,10 @@ int bcrypt_pbkdf_openbsd(const          void *secret, unsigned long secret_len,
 {
    int err;
    ulong32 blkno;
-   unsigned long left, itts, x, y, hashed_pass_len, step_size, steps, dest, used_rounds;
-   unsigned char *buf[3], blkbuf[4];
-   unsigned char *hashed_pass;
+   unsigned long left, itts, x, y, hashed_pass_len, salt_hash_len, step_size, steps, dest, used_rounds;
+   unsigned char blkbuf[4];
+   const struct ltc_hash_descriptor *hash;
+   struct bcrypt_arena *a;
 
    LTC_ARGCHK(secret != NULL);
    LTC_ARGCHK(salt   != NULL);
@@ -95,6 +91,7 @@ int bcrypt_pbkdf_openbsd(const          void *secret, unsigned long secret_len,
    if ((err = hash_is_valid(hash_idx)) != CRYPT_OK) {
       return err;
    }
+   hash = &hash_descriptor[hash_idx];
    /* set default value for rounds if not given */
    if (rounds == 0) {
       used_rounds = LTC_BCRYPT_DEFAULT_ROUNDS;
@@ -102,28 +99,18 @@ int bcrypt_pbkdf_openbsd(const          void *secret, unsigned long secret_len,
       used_rounds = rounds;
    }
 
-   buf[0]      = XMALLOC(MAXBLOCKSIZE * 3);
-   hashed_pass = XMALLOC(MAXBLOCKSIZE);
-   if (buf[0] == NULL || hashed_pass == NULL) {
-      if (hashed_pass != NULL) {
-         XFREE(hashed_pass);
-      }
-      if (buf[0] != NULL) {
-         XFREE(buf[0]);
-      }
+   a = XMALLOC(sizeof(*a));
+   if (a == NULL) {
       return CRYPT_MEM;
    }
-   /* buf[1] points to the second block of MAXBLOCKSIZE bytes */
-   buf[1] = buf[0] + MAXBLOCKSIZE;
-   buf[2] = buf[1] + MAXBLOCKSIZE;
 
    step_size = (*outlen + BCRYPT_HASHSIZE - 1) / BCRYPT_HASHSIZE;
    steps = (*outlen + step_size - 1) / step_size;
 
-   hashed_pass_len = MAXBLOCKSIZE;
-   if ((err = hash_memory(hash_idx, (unsigned char*)secret, secret_len, hashed_pass, &hashed_pass_len)) != CRYPT_OK) {
-      goto LBL_ERR;
-   }
+   hashed_pass_len = salt_hash_len = hash->hashsize;
+   if ((err = hash->init(&a->md)) != CRYPT_OK)                                  { goto LBL_ERR; }
+   if ((err = hash->process(&a->md, secret, secret_len)) != CRYPT_OK)           { goto LBL_ERR; }
+   if ((err = hash->done(&a->md, a->hashed_pass)) != CRYPT_OK)                  { goto LBL_ERR; }
 
    left   = *outlen;
    blkno  = 0;
@@ -133,43 +120,35 @@ int bcrypt_pbkdf_openbsd(const          void *secret, unsigned long secret_len,
        STORE32H(blkno, blkbuf);
 
        /* process block number blkno */
-       zeromem(buf[0], MAXBLOCKSIZE*2);
-
-       x = MAXBLOCKSIZE;
-       if ((err = hash_memory_multi(hash_idx, buf[0], &x,
-                                    salt, salt_len,
-                                    blkbuf, 4uL,
-                                    LTC_NULL)) != CRYPT_OK) {
+       if ((err = hash->init(&a->md)) != CRYPT_OK)                              { goto LBL_ERR; }
+       if ((err = hash->process(&a->md, salt, salt_len)) != CRYPT_OK)           { goto LBL_ERR; }
+       if ((err = hash->process(&a->md, blkbuf, 4uL)) != CRYPT_OK)              { goto LBL_ERR; }
+       if ((err = hash->done(&a->md, a->salt)) != CRYPT_OK)                     { goto LBL_ERR; }
+       if ((err = s_bcrypt_pbkdf_hash(a, hashed_pass_len, salt_hash_len)) != CRYPT_OK) {
           goto LBL_ERR;
        }
-       y = MAXBLOCKSIZE;
-       if ((err = s_bcrypt_pbkdf_hash(hashed_pass, hashed_pass_len, buf[0], x, buf[1], &y)) != CRYPT_OK) {
-          goto LBL_ERR;
-       }
-       XMEMCPY(buf[2], buf[1], y);
+       XMEMCPY(a->res, a->tmp, BCRYPT_HASHSIZE);
 
-       /* now compute repeated and XOR it in buf[2] */
+       /* now compute repeated and XOR it in a->res */
        for (itts = 1; itts < used_rounds; ++itts) {
-          x = MAXBLOCKSIZE;
-          if ((err = hash_memory(hash_idx, buf[1], y, buf[0], &x)) != CRYPT_OK) {
-             goto LBL_ERR;
-          }
-          y = MAXBLOCKSIZE;
-          if ((err = s_bcrypt_pbkdf_hash(hashed_pass, hashed_pass_len, buf[0], x, buf[1], &y)) != CRYPT_OK) {
+          if ((err = hash->init(&a->md)) != CRYPT_OK)                           { goto LBL_ERR; }
+          if ((err = hash->process(&a->md, a->tmp, BCRYPT_HASHSIZE)) != CRYPT_OK) { goto LBL_ERR; }
+          if ((err = hash->done(&a->md, a->salt)) != CRYPT_OK)                  { goto LBL_ERR; }
+          if ((err = s_bcrypt_pbkdf_hash(a, hashed_pass_len, salt_hash_len)) != CRYPT_OK) {
              goto LBL_ERR;
           }
-          for (x = 0; x < y; x++) {
-             buf[2][x] ^= buf[1][x];
+          for (x = 0; x < BCRYPT_HASHSIZE; x++) {
+             a->res[x] ^= a->tmp[x];
           }
        }
 
-       /* now emit upto `steps` bytes of buf[2] to output */
+       /* now emit upto `steps` bytes of a->res to output */
        steps = MIN(steps, left);
        for (y = 0; y < steps; ++y) {
           dest = y * step_size + (blkno - 1);
           if (dest >= *outlen)
              break;
-          out[dest] = buf[2][y];
+          out[dest] = a->res[y];
        }
        left -= y;
    }
@@ -177,15 +156,12 @@ int bcrypt_pbkdf_openbsd(const          void *secret, unsigned long secret_len,
    err = CRYPT_OK;
 LBL_ERR:
 #ifdef LTC_CLEAN_STACK
-   zeromem(buf[0], MAXBLOCKSIZE*3);
-   zeromem(hashed_pass, MAXBLOCKSIZE);
+   zeromem(a, sizeof(*a));
 #endif
 
-   XFREE(hashed_pass);
-   XFREE(buf[0]);
+   XFREE(a);
 
    return err;
 }
 
 #endif
-
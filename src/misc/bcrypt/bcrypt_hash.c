@@ -0,0 +1,238 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+   @file bcrypt_hash.c
+   bcrypt password hashing in the modular crypt format "$2b$"
+*/
+#ifdef LTC_BCRYPT
+
+#define BCRYPT_SALTLEN     16
+#define BCRYPT_KEYLEN      72
+#define BCRYPT_CT_WORDS    6
+/* the last octet of the ciphertext is not part of the encoding */
+#define BCRYPT_RAWLEN      (BCRYPT_CT_WORDS * 4 - 1)
+#define BCRYPT_SALT_CHARS  22
+#define BCRYPT_HASH_CHARS  31
+/* "$2b$" || 2 digits cost || "$" || salt || hash */
+#define BCRYPT_PREFIX_LEN  7
+#define BCRYPT_STRING_LEN  (BCRYPT_PREFIX_LEN + BCRYPT_SALT_CHARS + BCRYPT_HASH_CHARS)
+
+static const char * const s_bcrypt_codes =
+"./ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+/* everything a single bcrypt evaluation works on */
+struct bcrypt_2b_arena {
+   symmetric_key key;
+   ulong32       ct[BCRYPT_CT_WORDS];
+   unsigned char pass[BCRYPT_KEYLEN + 1];
+   unsigned char raw[BCRYPT_CT_WORDS * 4];
+   char          enc[BCRYPT_HASH_CHARS + 1];
+};
+
+/* base64 with the bcrypt alphabet and without padding */
+static void s_bcrypt_encode(const unsigned char *in, unsigned long inlen, char *out)
+{
+   unsigned long i;
+   ulong32 c;
+   int bits = 0;
+
+   c = 0;
+   for (i = 0; i < inlen; ++i) {
+      c = (c << 8) | in[i];
+      bits += 8;
+      while (bits >= 6) {
+         bits -= 6;
+         *out++ = s_bcrypt_codes[(c >> bits) & 0x3F];
+      }
+   }
+   if (bits > 0) {
+      *out++ = s_bcrypt_codes[(c << (6 - bits)) & 0x3F];
+   }
+   *out = '\0';
+}
+
+static int s_bcrypt_decode(const char *in, unsigned long outlen, unsigned char *out)
+{
+   unsigned long n;
+   ulong32 c, v;
+   int bits = 0;
+
+   c = 0;
+   n = 0;
+   while (n < outlen) {
+      for (v = 0; v < 64; ++v) {
+         if (s_bcrypt_codes[v] == *in) break;
+      }
+      if (*in == '\0' || v == 64) {
+         return CRYPT_INVALID_PACKET;
+      }
+      ++in;
+      c = (c << 6) | v;
+      bits += 6;
+      if (bits >= 8) {
+         bits -= 8;
+         out[n++] = (unsigned char)(c >> bits);
+      }
+   }
+   return CRYPT_OK;
+}
+
+/* EksBlowfish with 2^cost rounds, followed by the 64-fold encryption of the magic value */
+static int s_bcrypt_2b_raw(struct bcrypt_2b_arena *a,
+                           const char *password, unsigned long password_len,
+                           const unsigned char *salt, unsigned int cost)
+{
+   const unsigned char ctext[] = "OrpheanBeholderScryDoubt";
+   unsigned long keylen;
+   ulong32 r, rounds;
+   int err, n;
+
+   /* the key is the password including its terminating NUL, limited to 72 octets */
+   keylen = MIN(password_len, BCRYPT_KEYLEN);
+   if (keylen > 0) {
+      XMEMCPY(a->pass, password, keylen);
+   }
+   a->pass[keylen] = 0;
+   keylen = MIN(password_len + 1, BCRYPT_KEYLEN);
+
+   if ((err = blowfish_setup_with_data(a->pass, (int)keylen, salt, BCRYPT_SALTLEN, &a->key)) != CRYPT_OK) {
+      return err;
+   }
+   rounds = (ulong32)1 << cost;
+   for (r = 0; r < rounds; ++r) {
+      if ((err = blowfish_expand(a->pass, (int)keylen, NULL, 0, &a->key)) != CRYPT_OK) {
+         return err;
+      }
+      if ((err = blowfish_expand(salt, BCRYPT_SALTLEN, NULL, 0, &a->key)) != CRYPT_OK) {
+         return err;
+      }
+   }
+
+   for (n = 0; n < BCRYPT_CT_WORDS; ++n) {
+      LOAD32H(a->ct[n], &ctext[n*4]);
+   }
+   for (n = 0; n < 64; ++n) {
+      blowfish_enc(a->ct, BCRYPT_CT_WORDS/2, &a->key);
+   }
+   for (n = 0; n < BCRYPT_CT_WORDS; ++n) {
+      STORE32H(a->ct[n], &a->raw[4 * n]);
+   }
+   s_bcrypt_encode(a->raw, BCRYPT_RAWLEN, a->enc);
+
+   return CRYPT_OK;
+}
+
+/**
+   Hash a password with bcrypt into the "$2b$" modular crypt format
+   @param password          The password
+   @param password_len      The length of the password (octets), only the first 72 octets are used
+   @param salt              The random salt (16 octets)
+   @param cost              The logarithmic work factor, 4 .. 31
+   @param out               [out] The NUL-terminated hash string (60 characters)
+   @param outlen            [in/out] The max size and resulting size of the hash string (without the NUL)
+   @return CRYPT_OK if successful
+*/
+int bcrypt_hash(const          char *password, unsigned long password_len,
+                const unsigned char *salt,     unsigned int  cost,
+                               char *out,      unsigned long *outlen)
+{
+   struct bcrypt_2b_arena *a;
+   int err;
+
+   LTC_ARGCHK(password != NULL || password_len == 0);
+   LTC_ARGCHK(salt     != NULL);
+   LTC_ARGCHK(out      != NULL);
+   LTC_ARGCHK(outlen   != NULL);
+
+   if (cost < 4 || cost > 31) {
+      return CRYPT_INVALID_ROUNDS;
+   }
+   if (*outlen < BCRYPT_STRING_LEN + 1) {
+      *outlen = BCRYPT_STRING_LEN + 1;
+      return CRYPT_BUFFER_OVERFLOW;
+   }
+
+   a = XMALLOC(sizeof(*a));
+   if (a == NULL) {
+      return CRYPT_MEM;
+   }
+
+   if ((err = s_bcrypt_2b_raw(a, password, password_len, salt, cost)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+
+   XMEMCPY(out, "$2b$", 4);
+   out[4] = (char)('0' + cost / 10);
+   out[5] = (char)('0' + cost % 10);
+   out[6] = '$';
+   s_bcrypt_encode(salt, BCRYPT_SALTLEN, out + BCRYPT_PREFIX_LEN);
+   XMEMCPY(out + BCRYPT_PREFIX_LEN + BCRYPT_SALT_CHARS, a->enc, BCRYPT_HASH_CHARS + 1);
+   *outlen = BCRYPT_STRING_LEN;
+
+LBL_ERR:
+   zeromem(a, sizeof(*a));
+   XFREE(a);
+
+   return err;
+}
+
+/**
+   Verify a password against a bcrypt hash string
+   "$2a$", "$2b$" and "$2y$" hashes are accepted, they all are computed the same way.
+   @param password          The password
+   @param password_len      The length of the password (octets)
+   @param hash              The NUL-terminated hash string
+   @param stat              [out] 1 if the password matches, 0 if not
+   @return CRYPT_OK if the hash string could be processed (check stat for the result)
+*/
+int bcrypt_verify(const char *password, unsigned long password_len,
+                  const char *hash,     int *stat)
+{
+   struct bcrypt_2b_arena *a;
+   unsigned char salt[BCRYPT_SALTLEN];
+   unsigned int cost;
+   int err;
+
+   LTC_ARGCHK(password != NULL || password_len == 0);
+   LTC_ARGCHK(hash     != NULL);
+   LTC_ARGCHK(stat     != NULL);
+
+   *stat = 0;
+
+   if (XSTRLEN(hash) != BCRYPT_STRING_LEN
+       || hash[0] != '$' || hash[1] != '2' || hash[3] != '$' || hash[6] != '$'
+       || (hash[2] != 'a' && hash[2] != 'b' && hash[2] != 'y')
+       || hash[4] < '0' || hash[4] > '9' || hash[5] < '0' || hash[5] > '9') {
+      return CRYPT_INVALID_PACKET;
+   }
+   cost = (unsigned int)(hash[4] - '0') * 10 + (unsigned int)(hash[5] - '0');
+   if (cost < 4 || cost > 31) {
+      return CRYPT_INVALID_ROUNDS;
+   }
+   if ((err = s_bcrypt_decode(hash + BCRYPT_PREFIX_LEN, BCRYPT_SALTLEN, salt)) != CRYPT_OK) {
+      return err;
+   }
+
+   a = XMALLOC(sizeof(*a));
+   if (a == NULL) {
+      return CRYPT_MEM;
+   }
+
+   if ((err = s_bcrypt_2b_raw(a, password, password_len, salt, cost)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   if (XMEM_NEQ(a->enc, hash + BCRYPT_PREFIX_LEN + BCRYPT_SALT_CHARS, BCRYPT_HASH_CHARS) == 0) {
+      *stat = 1;
+   }
+
+LBL_ERR:
+   zeromem(a, sizeof(*a));
+   zeromem(salt, sizeof(salt));
+   XFREE(a);
+
+   return err;
+}
+
+#endif
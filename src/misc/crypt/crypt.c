@@ -276,6 +276,9 @@ const char *crypt_build_settings =
 #if defined(LTC_BLAKE2BMAC)
     "   BLAKE2B MAC\n"
 #endif
+#if defined(LTC_GMAC)
+    "   GMAC\n"
+#endif
 
     "\nENC + AUTH modes:\n"
 #if defined(LTC_EAX_MODE)
@@ -306,6 +309,9 @@ const char *crypt_build_settings =
 #if defined(LTC_SIV_MODE)
     "   SIV\n"
 #endif
+#if defined(LTC_GCM_SIV_MODE)
+    "   GCM-SIV\n"
+#endif
 
     "\nPRNG:\n"
 #if defined(LTC_YARROW)
@@ -352,7 +358,11 @@ const char *crypt_build_settings =
     "\n"
 #endif
 #if defined(LTC_MDH)
-    "   DH\n"
+    "   DH"
+#if defined(LTC_DH_FIXED_BASE)
+    " (with fixed-base tables)"
+#endif
+    "\n"
 #endif
 #if defined(LTC_MECC)
     "   ECC"
@@ -392,6 +402,13 @@ const char *crypt_build_settings =
 #if defined(LTC_MILLER_RABIN_REPS)
     "   "NAME_VALUE(LTC_MILLER_RABIN_REPS)"\n"
 #endif
+#if defined(LTC_MPI_SCRATCH)
+    "   LTC_MPI_SCRATCH\n"
+    "   "NAME_VALUE(LTC_MPI_SCRATCH_SLOTS)"\n"
+#endif
+#if defined(LTC_MPI_FIXED_WINDOW)
+    "   LTC_MPI_FIXED_WINDOW\n"
+#endif
 
     "\nCompiler:\n"
 #if defined(_WIN64)
@@ -433,6 +450,9 @@ const char *crypt_build_settings =
 #if defined(LTC_AES_NI)
     " AES-NI "
 #endif
+#if defined(LTC_AES_CT)
+    " AES-CT "
+#endif
 #if defined(LTC_BASE64)
     " BASE64 "
 #endif
@@ -449,6 +469,12 @@ const char *crypt_build_settings =
     " BCRYPT "
     " " NAME_VALUE(LTC_BCRYPT_DEFAULT_ROUNDS) " "
 #endif
+#if defined(LTC_ARGON2)
+    " ARGON2 "
+#endif
+#if defined(LTC_SCRYPT)
+    " SCRYPT "
+#endif
 #if defined(LTC_CRC32)
     " CRC32 "
 #endif
@@ -474,6 +500,10 @@ const char *crypt_build_settings =
 #if defined(LTC_HKDF)
     " HKDF "
 #endif
+#if defined(LTC_DIGEST_FANOUT)
+    " DIGEST_FANOUT "
+    " " NAME_VALUE(LTC_DIGEST_FANOUT_CHUNK) " "
+#endif
 #if defined(LTC_PBES)
     " PBES1 "
     " PBES2 "
@@ -528,6 +558,10 @@ const char *crypt_build_settings =
 #if defined(LTC_FILE_READ_BUFSIZE)
     " " NAME_VALUE(LTC_FILE_READ_BUFSIZE) " "
 #endif
+#if defined(LTC_FILE_MMAP)
+    " LTC_FILE_MMAP "
+    " " NAME_VALUE(LTC_FILE_MMAP_WINDOW) " "
+#endif
 #if defined(LTC_FAST)
     " LTC_FAST "
 #endif
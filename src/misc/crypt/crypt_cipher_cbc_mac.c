@@ -0,0 +1,45 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file crypt_cipher_cbc_mac.c
+  Run the CBC-MAC chain of a cipher descriptor over whole blocks
+*/
+
+/*
+   Chain whole blocks into a CBC-MAC value, through the accelerator of the descriptor if it has one
+   @param cipher   The index of the cipher
+   @param in       The message blocks
+   @param blocks   The number of blocks
+   @param IV       [in/out] The chaining value, IV = E(IV ^ block) for every block
+   @param skey     The scheduled key
+   @return CRYPT_OK if successful
+*/
+int cipher_cbc_mac_blocks(int cipher, const unsigned char *in, unsigned long blocks, unsigned char *IV,
+                          const symmetric_key *skey)
+{
+   unsigned long x, bl;
+   int err;
+
+   if (cipher_descriptor[cipher].accel_cbc_mac != NULL) {
+      return cipher_descriptor[cipher].accel_cbc_mac(in, blocks, IV, skey);
+   }
+   bl = (unsigned long)cipher_descriptor[cipher].block_length;
+   while (blocks-- > 0) {
+#ifdef LTC_FAST
+      for (x = 0; x < bl; x += sizeof(LTC_FAST_TYPE)) {
+         *(LTC_FAST_TYPE_PTR_CAST(&IV[x])) ^= *(LTC_FAST_TYPE_PTR_CAST(&in[x]));
+      }
+#else
+      for (x = 0; x < bl; x++) {
+         IV[x] ^= in[x];
+      }
+#endif
+      if ((err = cipher_descriptor[cipher].ecb_encrypt(IV, IV, skey)) != CRYPT_OK) {
+         return err;
+      }
+      in += bl;
+   }
+   return CRYPT_OK;
+}
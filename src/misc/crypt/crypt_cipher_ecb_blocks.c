@@ -0,0 +1,80 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file crypt_cipher_ecb_blocks.c
+  Encrypt or decrypt several independent blocks with a cipher descriptor
+*/
+
+/* the accelerators take a non-const key for historical reasons, none of them modifies it */
+
+/*
+   Check whether the descriptor has a block hook that is faster than single block calls
+   @param cipher   The index of the cipher
+   @return 1 if the accelerator is worth batching blocks for, 0 if not
+*/
+int cipher_ecb_blocks_accelerated(int cipher)
+{
+   if (cipher_descriptor[cipher].accel_ecb_encrypt == NULL) {
+      return 0;
+   }
+   if (cipher_descriptor[cipher].accel_ecb_is_fast != NULL) {
+      return cipher_descriptor[cipher].accel_ecb_is_fast();
+   }
+   return 1;
+}
+
+/*
+   Encrypt consecutive blocks in ECB fashion, through the accelerator of the descriptor if it has one
+   @param cipher   The index of the cipher
+   @param pt       The plaintext
+   @param ct       [out] The ciphertext, may equal pt
+   @param blocks   The number of blocks
+   @param skey     The scheduled key
+   @return CRYPT_OK if successful
+*/
+int cipher_ecb_encrypt_blocks(int cipher, const unsigned char *pt, unsigned char *ct, unsigned long blocks,
+                              const symmetric_key *skey)
+{
+   unsigned long x, bl;
+   int err;
+
+   if (cipher_descriptor[cipher].accel_ecb_encrypt != NULL) {
+      return cipher_descriptor[cipher].accel_ecb_encrypt(pt, ct, blocks, (symmetric_key *)skey);
+   }
+   bl = (unsigned long)cipher_descriptor[cipher].block_length;
+   for (x = 0; x < blocks; x++) {
+      if ((err = cipher_descriptor[cipher].ecb_encrypt(pt + x * bl, ct + x * bl, skey)) != CRYPT_OK) {
+         return err;
+      }
+   }
+   return CRYPT_OK;
+}
+
+/*
+   Decrypt consecutive blocks in ECB fashion, through the accelerator of the descriptor if it has one
+   @param cipher   The index of the cipher
+   @param ct       The ciphertext
+   @param pt       [out] The plaintext, may equal ct
+   @param blocks   The number of blocks
+   @param skey     The scheduled key
+   @return CRYPT_OK if successful
+*/
+int cipher_ecb_decrypt_blocks(int cipher, const unsigned char *ct, unsigned char *pt, unsigned long blocks,
+                              const symmetric_key *skey)
+{
+   unsigned long x, bl;
+   int err;
+
+   if (cipher_descriptor[cipher].accel_ecb_decrypt != NULL) {
+      return cipher_descriptor[cipher].accel_ecb_decrypt(ct, pt, blocks, (symmetric_key *)skey);
+   }
+   bl = (unsigned long)cipher_descriptor[cipher].block_length;
+   for (x = 0; x < blocks; x++) {
+      if ((err = cipher_descriptor[cipher].ecb_decrypt(ct + x * bl, pt + x * bl, skey)) != CRYPT_OK) {
+         return err;
+      }
+   }
+   return CRYPT_OK;
+}
@@ -0,0 +1,137 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file crypt_file_process.c
+  The file reader behind the hash and MAC file helpers
+*/
+
+#ifndef LTC_NO_FILE
+
+#ifdef LTC_FILE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* map a regular file window by window, CRYPT_NOP if it can't be mapped at all */
+static int s_file_process_mmap(FILE *in, crypt_file_process_fn process, void *ctx)
+{
+   struct stat st;
+   off_t pos, base;
+   size_t maplen;
+   long page;
+   void *map;
+   int fd, err, mapped;
+
+   /* the mapping bypasses the stdio buffer, so pending writes have to reach the file first */
+   if (fflush(in) != 0) {
+      return CRYPT_NOP;
+   }
+   fd = fileno(in);
+   if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+      return CRYPT_NOP;
+   }
+   if ((pos = ftello(in)) < 0 || pos >= st.st_size) {
+      return CRYPT_NOP;
+   }
+   if ((page = sysconf(_SC_PAGESIZE)) <= 0 || LTC_FILE_MMAP_WINDOW % (unsigned long)page != 0) {
+      return CRYPT_NOP;
+   }
+
+   /* the file pointer may be anywhere, but a mapping has to start on a page */
+   base = pos - pos % page;
+   err = CRYPT_OK;
+   mapped = 0;
+   while (base < st.st_size) {
+      maplen = (size_t)MIN((off_t)LTC_FILE_MMAP_WINDOW, st.st_size - base);
+      map = mmap(NULL, maplen, PROT_READ, MAP_PRIVATE, fd, base);
+      if (map == MAP_FAILED) {
+         return mapped ? CRYPT_ERROR : CRYPT_NOP;
+      }
+      mapped = 1;
+      (void)posix_madvise(map, maplen, POSIX_MADV_SEQUENTIAL);
+      err = process(ctx, (const unsigned char *)map + (pos - base), (unsigned long)(maplen - (size_t)(pos - base)));
+      munmap(map, maplen);
+      if (err != CRYPT_OK) {
+         return err;
+      }
+      base += (off_t)maplen;
+      pos   = base;
+   }
+
+   /* leave the file pointer at the end, as reading it would have */
+   if (fseeko(in, st.st_size, SEEK_SET) != 0) {
+      return CRYPT_ERROR;
+   }
+   return CRYPT_OK;
+}
+#endif
+
+/*
+   Process the rest of an open file, starting at the current file pointer
+   @param in       The FILE* handle of the file
+   @param process  The function the data is handed to
+   @param ctx      The first argument of process
+   @return CRYPT_OK if successful
+*/
+int crypt_file_process(FILE *in, crypt_file_process_fn process, void *ctx)
+{
+   unsigned char *buf;
+   size_t x;
+   int err;
+
+   LTC_ARGCHK(in      != NULL);
+   LTC_ARGCHK(process != NULL);
+
+#ifdef LTC_FILE_MMAP
+   if ((err = s_file_process_mmap(in, process, ctx)) != CRYPT_NOP) {
+      return err;
+   }
+#endif
+
+   if ((buf = XMALLOC(LTC_FILE_READ_BUFSIZE)) == NULL) {
+      return CRYPT_MEM;
+   }
+   do {
+      x = fread(buf, 1, LTC_FILE_READ_BUFSIZE, in);
+      if ((err = process(ctx, buf, (unsigned long)x)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+   } while (x == LTC_FILE_READ_BUFSIZE);
+   if (ferror(in)) {
+      err = CRYPT_ERROR;
+   }
+
+LBL_ERR:
+   zeromem(buf, LTC_FILE_READ_BUFSIZE);
+   XFREE(buf);
+   return err;
+}
+
+/*
+   Process a whole file
+   @param fname    The name of the file
+   @param process  The function the data is handed to
+   @param ctx      The first argument of process
+   @return CRYPT_OK if successful
+*/
+int crypt_file_process_name(const char *fname, crypt_file_process_fn process, void *ctx)
+{
+   FILE *in;
+   int err;
+
+   LTC_ARGCHK(fname != NULL);
+
+   in = fopen(fname, "rb");
+   if (in == NULL) {
+      return CRYPT_FILE_NOTFOUND;
+   }
+   err = crypt_file_process(in, process, ctx);
+   if (fclose(in) != 0 && err == CRYPT_OK) {
+      err = CRYPT_ERROR;
+   }
+   return err;
+}
+
+#endif /* LTC_NO_FILE */
@@ -0,0 +1,172 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file crypt_iov_process.c
+  Drive a streaming encryption function over scatter-gather lists
+*/
+
+#if defined(LTC_EAX_MODE) || defined(LTC_OCB3_MODE) || defined(LTC_CCM_MODE) || \
+    defined(LTC_GCM_MODE) || defined(LTC_CHACHA20POLY1305_MODE)
+
+typedef struct {
+   const ltc_iovec *v;
+   unsigned long    cnt, idx, off;
+} s_iov_cursor;
+
+/* the number of octets left in the current segment, empty segments are skipped */
+static unsigned long s_iov_avail(s_iov_cursor *c)
+{
+   while (c->idx < c->cnt && c->off == c->v[c->idx].len) {
+      c->idx++;
+      c->off = 0;
+   }
+   return c->idx < c->cnt ? c->v[c->idx].len - c->off : 0;
+}
+
+/* the current position of an output cursor, the caller provides writable memory there */
+static unsigned char *s_iov_wr(const s_iov_cursor *c)
+{
+   return (unsigned char *)c->v[c->idx].data + c->off;
+}
+
+static void s_iov_gather(s_iov_cursor *c, unsigned char *buf, unsigned long len)
+{
+   unsigned long n;
+
+   while (len > 0) {
+      n = s_iov_avail(c);
+      n = MIN(n, len);
+      XMEMCPY(buf, c->v[c->idx].data + c->off, n);
+      c->off += n;
+      buf    += n;
+      len    -= n;
+   }
+}
+
+static void s_iov_scatter(s_iov_cursor *c, const unsigned char *buf, unsigned long len)
+{
+   unsigned long n;
+
+   while (len > 0) {
+      n = s_iov_avail(c);
+      n = MIN(n, len);
+      XMEMCPY(s_iov_wr(c), buf, n);
+      c->off += n;
+      buf    += n;
+      len    -= n;
+   }
+}
+
+static int s_iov_total(const ltc_iovec *v, unsigned long cnt, unsigned long *total)
+{
+   unsigned long x;
+
+   *total = 0;
+   for (x = 0; x < cnt; x++) {
+      if (v[x].len == 0) {
+         continue;
+      }
+      LTC_ARGCHK(v[x].data != NULL);
+      if (*total + v[x].len < *total) {
+         return CRYPT_OVERFLOW;
+      }
+      *total += v[x].len;
+   }
+   return CRYPT_OK;
+}
+
+/*
+   Process the concatenation of the input segments into the output segments
+   As long as an input and an output segment overlap by at least a block, the data is
+   processed where it is. Only blocks that straddle a segment boundary go through
+   a buffer of one block.
+   @param in         The input segments
+   @param incnt      The number of input segments
+   @param out        The output segments, same total length as the input, may describe the same memory
+   @param outcnt     The number of output segments
+   @param blocklen   The granularity process() accepts, 1 for stream-like modes
+   @param process    Called for the whole multiple of blocklen
+   @param last       Called once with the remaining less than blocklen octets (may be NULL if blocklen is 1)
+   @param st         The state handed to process() and last()
+   @param direction  Handed to process() and last()
+   @return CRYPT_OK if successful
+*/
+int ltc_iov_process(const ltc_iovec *in,  unsigned long incnt,
+                    const ltc_iovec *out, unsigned long outcnt,
+                    unsigned long blocklen, ltc_iov_process_fn process, ltc_iov_process_fn last,
+                    void *st, int direction)
+{
+   s_iov_cursor ci, co;
+   unsigned char buf[MAXBLOCKSIZE];
+   unsigned long total, outtotal, full, n, m;
+   int err;
+
+   LTC_ARGCHK(process != NULL);
+   LTC_ARGCHK(blocklen >= 1 && blocklen <= sizeof(buf));
+   LTC_ARGCHK(blocklen == 1 || last != NULL);
+   if (incnt > 0) {
+      LTC_ARGCHK(in != NULL);
+   }
+   if (outcnt > 0) {
+      LTC_ARGCHK(out != NULL);
+   }
+
+   if ((err = s_iov_total(in, incnt, &total)) != CRYPT_OK) {
+      return err;
+   }
+   if ((err = s_iov_total(out, outcnt, &outtotal)) != CRYPT_OK) {
+      return err;
+   }
+   if (total != outtotal) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   ci.v = in;
+   ci.cnt = incnt;
+   co.v = out;
+   co.cnt = outcnt;
+   ci.idx = ci.off = co.idx = co.off = 0;
+
+   full = total - total % blocklen;
+   while (full > 0) {
+      n = s_iov_avail(&ci);
+      m = s_iov_avail(&co);
+      n = MIN(MIN(n, m), full);
+      n -= n % blocklen;
+      if (n > 0) {
+         err = process(st, ci.v[ci.idx].data + ci.off, n, s_iov_wr(&co), direction);
+         ci.off += n;
+         co.off += n;
+      } else {
+         /* a block straddles a segment boundary */
+         n = blocklen;
+         s_iov_gather(&ci, buf, n);
+         err = process(st, buf, n, buf, direction);
+         s_iov_scatter(&co, buf, n);
+      }
+      if (err != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+      full -= n;
+   }
+
+   if (last != NULL) {
+      n = total % blocklen;
+      s_iov_gather(&ci, buf, n);
+      if ((err = last(st, buf, n, buf, direction)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+      s_iov_scatter(&co, buf, n);
+   }
+   err = CRYPT_OK;
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(buf, sizeof(buf));
+#endif
+   return err;
+}
+
+#endif
@@ -193,6 +193,7 @@ static const crypt_size s_crypt_sizes[] = {
     /* MAC sizes            -- no states for ccm, lrw */
 #ifdef LTC_HMAC
     SZ_STRINGIFY_T(hmac_state),
+    SZ_STRINGIFY_T(hmac_key),
 #endif
 #ifdef LTC_OMAC
     SZ_STRINGIFY_T(omac_state),
@@ -203,6 +204,7 @@ static const crypt_size s_crypt_sizes[] = {
 #ifdef LTC_POLY1305
     SZ_STRINGIFY_T(poly1305_state),
 #endif
+    SZ_STRINGIFY_T(ltc_iovec),
 #ifdef LTC_EAX_MODE
     SZ_STRINGIFY_T(eax_state),
 #endif
@@ -216,6 +218,8 @@ static const crypt_size s_crypt_sizes[] = {
     SZ_STRINGIFY_T(ccm_state),
 #endif
 #ifdef LTC_GCM_MODE
+    SZ_STRINGIFY_T(gcm_key),
+    SZ_STRINGIFY_T(gcm_msg_state),
     SZ_STRINGIFY_T(gcm_state),
 #endif
 #ifdef LTC_PELICAN
@@ -281,6 +285,10 @@ static const crypt_size s_crypt_sizes[] = {
 #ifdef LTC_CRC32
     SZ_STRINGIFY_T(crc32_state),
 #endif
+#ifdef LTC_HKDF
+    SZ_STRINGIFY_T(hkdf_state),
+    SZ_STRINGIFY_T(hkdf_label),
+#endif
 
     SZ_STRINGIFY_T(ltc_mp_digit),
     SZ_STRINGIFY_T(ltc_math_descriptor)
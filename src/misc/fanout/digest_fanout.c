@@ -0,0 +1,192 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file digest_fanout.c
+  Feed several hashes and MACs from a single pass over the input
+*/
+
+#ifdef LTC_DIGEST_FANOUT
+
+static int s_sink_process(const digest_sink *sink, const unsigned char *in, unsigned long inlen)
+{
+   switch (sink->type) {
+      case LTC_SINK_HASH:
+         return hash_descriptor[sink->hash].process((hash_state *)sink->state, in, inlen);
+#ifdef LTC_HMAC
+      case LTC_SINK_HMAC:
+         return hmac_process((hmac_state *)sink->state, in, inlen);
+#endif
+#ifdef LTC_OMAC
+      case LTC_SINK_OMAC:
+         return omac_process((omac_state *)sink->state, in, inlen);
+#endif
+#ifdef LTC_PMAC
+      case LTC_SINK_PMAC:
+         return pmac_process((pmac_state *)sink->state, in, inlen);
+#endif
+#ifdef LTC_XCBC
+      case LTC_SINK_XCBC:
+         return xcbc_process((xcbc_state *)sink->state, in, inlen);
+#endif
+#ifdef LTC_POLY1305
+      case LTC_SINK_POLY1305:
+         return poly1305_process((poly1305_state *)sink->state, in, inlen);
+#endif
+#ifdef LTC_BLAKE2SMAC
+      case LTC_SINK_BLAKE2SMAC:
+         return blake2smac_process((blake2smac_state *)sink->state, in, inlen);
+#endif
+#ifdef LTC_BLAKE2BMAC
+      case LTC_SINK_BLAKE2BMAC:
+         return blake2bmac_process((blake2bmac_state *)sink->state, in, inlen);
+#endif
+#ifdef LTC_GMAC
+      case LTC_SINK_GMAC:
+         return gmac_process((gmac_state *)sink->state, in, inlen);
+#endif
+      default:
+         return CRYPT_INVALID_ARG;
+   }
+}
+
+static int s_sinks_check(const digest_sink *sinks, unsigned long nsinks)
+{
+   unsigned long n;
+   int err;
+
+   for (n = 0; n < nsinks; ++n) {
+      if (sinks[n].state == NULL) {
+         return CRYPT_INVALID_ARG;
+      }
+      if (sinks[n].type == LTC_SINK_HASH && (err = hash_is_valid(sinks[n].hash)) != CRYPT_OK) {
+         return err;
+      }
+   }
+   return CRYPT_OK;
+}
+
+/* one chunk to every consumer in turn, while it is still in the cache */
+static int s_sinks_process(const digest_sink *sinks, unsigned long nsinks, const unsigned char *in, unsigned long inlen)
+{
+   unsigned long n;
+   int err;
+
+   for (n = 0; n < nsinks; ++n) {
+      if ((err = s_sink_process(&sinks[n], in, inlen)) != CRYPT_OK) {
+         return err;
+      }
+   }
+   return CRYPT_OK;
+}
+
+/* the input is cut into chunks small enough to stay in the cache */
+static int s_sinks_process_chunked(const digest_sink *sinks, unsigned long nsinks,
+                                   const unsigned char *in, unsigned long inlen)
+{
+   unsigned long n;
+   int err;
+
+   while (inlen > 0) {
+      n = MIN(inlen, LTC_DIGEST_FANOUT_CHUNK);
+      if ((err = s_sinks_process(sinks, nsinks, in, n)) != CRYPT_OK) {
+         return err;
+      }
+      in    += n;
+      inlen -= n;
+   }
+   return CRYPT_OK;
+}
+
+/**
+   Process a block of memory through several hash and MAC states
+   The states have to be initialized before and finished afterwards by the caller,
+   this function only replaces the individual process() calls.
+   @param sinks    The consumers
+   @param nsinks   The number of consumers
+   @param in       The data
+   @param inlen    The length of the data (octets)
+   @return CRYPT_OK if successful
+*/
+int digest_fanout_memory(const digest_sink *sinks, unsigned long nsinks,
+                         const unsigned char *in, unsigned long inlen)
+{
+   int err;
+
+   LTC_ARGCHK(sinks != NULL || nsinks == 0);
+   LTC_ARGCHK(in    != NULL || inlen == 0);
+
+   if ((err = s_sinks_check(sinks, nsinks)) != CRYPT_OK) {
+      return err;
+   }
+   return s_sinks_process_chunked(sinks, nsinks, in, inlen);
+}
+
+#ifndef LTC_NO_FILE
+struct digest_fanout_ctx {
+   const digest_sink *sinks;
+   unsigned long nsinks;
+};
+
+static int s_digest_fanout_process(void *ctx, const unsigned char *in, unsigned long inlen)
+{
+   const struct digest_fanout_ctx *c = ctx;
+   return s_sinks_process_chunked(c->sinks, c->nsinks, in, inlen);
+}
+
+/**
+   Process the rest of an open file through several hash and MAC states, the file is read once
+   @param sinks    The consumers
+   @param nsinks   The number of consumers
+   @param in       The FILE* handle of the file
+   @return CRYPT_OK if successful
+*/
+int digest_fanout_filehandle(const digest_sink *sinks, unsigned long nsinks, FILE *in)
+{
+   struct digest_fanout_ctx c;
+   int err;
+
+   LTC_ARGCHK(sinks != NULL || nsinks == 0);
+   LTC_ARGCHK(in    != NULL);
+
+   if ((err = s_sinks_check(sinks, nsinks)) != CRYPT_OK) {
+      return err;
+   }
+   c.sinks  = sinks;
+   c.nsinks = nsinks;
+   return crypt_file_process(in, s_digest_fanout_process, &c);
+}
+#endif
+
+/**
+   Process a file through several hash and MAC states, the file is read once
+   @param sinks    The consumers
+   @param nsinks   The number of consumers
+   @param fname    The name of the file
+   @return CRYPT_OK if successful, CRYPT_NOP if file support has been disabled
+*/
+int digest_fanout_file(const digest_sink *sinks, unsigned long nsinks, const char *fname)
+{
+#ifdef LTC_NO_FILE
+   LTC_UNUSED_PARAM(sinks);
+   LTC_UNUSED_PARAM(nsinks);
+   LTC_UNUSED_PARAM(fname);
+   return CRYPT_NOP;
+#else
+   struct digest_fanout_ctx c;
+   int err;
+
+   LTC_ARGCHK(sinks != NULL || nsinks == 0);
+   LTC_ARGCHK(fname != NULL);
+
+   if ((err = s_sinks_check(sinks, nsinks)) != CRYPT_OK) {
+      return err;
+   }
+   c.sinks  = sinks;
+   c.nsinks = nsinks;
+   return crypt_file_process_name(fname, s_digest_fanout_process, &c);
+#endif
+}
+
+#endif
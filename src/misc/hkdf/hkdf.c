@@ -28,76 +28,190 @@ int hkdf_extract(int hash_idx, const unsigned char *salt, unsigned long  saltlen
    return hmac_memory(hash_idx, salt, saltlen, in, inlen, out, outlen);
 }
 
-int hkdf_expand(int hash_idx, const unsigned char *info, unsigned long infolen,
-                              const unsigned char *in,   unsigned long inlen,
-                                    unsigned char *out,  unsigned long outlen)
+/* T(N) = HMAC-Hash(PRK, T(N-1) | info | N), the info is passed in several parts */
+static int s_hkdf_expand(const hkdf_state *hkdf,
+                         const unsigned char * const *info, const unsigned long *infolen, int parts,
+                         unsigned char *out, unsigned long outlen)
 {
-   unsigned long hashsize;
-   int err;
+   hmac_state hmac;
+   unsigned char T[MAXBLOCKSIZE];
+   unsigned long Tlen, n;
    unsigned char N;
-   unsigned long Noutlen, outoff;
+   int err, i;
+
+   LTC_ARGCHK(out != NULL);
 
-   unsigned char *T,  *dat;
-   unsigned long Tlen, datlen;
+   if (outlen > hash_descriptor[hkdf->prk.hash].hashsize * 255) {
+      return CRYPT_INVALID_ARG;
+   }
+   for (i = 0; i < parts; ++i) {
+      if (info[i] == NULL && infolen[i] != 0) {
+         return CRYPT_INVALID_ARG;
+      }
+   }
+
+   /* HMAC data T(1) doesn't include a previous hash value */
+   Tlen = 0;
+   N = 0;
+   while (outlen != 0) {
+      ++N;
+      if ((err = hmac_init_from_key(&hmac, &hkdf->prk)) != CRYPT_OK)      { goto LBL_ERR; }
+      if (Tlen != 0) {
+         if ((err = hmac_process(&hmac, T, Tlen)) != CRYPT_OK)            { goto LBL_ERR; }
+      }
+      for (i = 0; i < parts; ++i) {
+         if (infolen[i] == 0) {
+            continue;
+         }
+         if ((err = hmac_process(&hmac, info[i], infolen[i])) != CRYPT_OK) { goto LBL_ERR; }
+      }
+      if ((err = hmac_process(&hmac, &N, 1)) != CRYPT_OK)                 { goto LBL_ERR; }
+      Tlen = sizeof(T);
+      if ((err = hmac_done(&hmac, T, &Tlen)) != CRYPT_OK)                 { goto LBL_ERR; }
+
+      n = MIN(Tlen, outlen);
+      XMEMCPY(out, T, n);
+      out    += n;
+      outlen -= n;
+   }
+   err = CRYPT_OK;
+
+LBL_ERR:
+   zeromem(T, sizeof(T));
+#ifdef LTC_CLEAN_STACK
+   zeromem(&hmac, sizeof(hmac));
+#endif
+   return err;
+}
+
+/**
+   Key the HMAC of HKDF-Expand with a PRK once, for several calls of hkdf_expand_state() or hkdf_expand_label()
+   @param hkdf      [out] The HKDF state
+   @param hash_idx  The index of the hash desired
+   @param prk       The pseudorandom key, e.g. the output of hkdf_extract()
+   @param prklen    The length of the PRK (octets), at least the hash size
+   @return CRYPT_OK if successful
+*/
+int hkdf_init(hkdf_state *hkdf, int hash_idx, const unsigned char *prk, unsigned long prklen)
+{
+   int err;
+
+   LTC_ARGCHK(hkdf != NULL);
+   LTC_ARGCHK(prk  != NULL);
 
    /* make sure hash descriptor is valid */
    if ((err = hash_is_valid(hash_idx)) != CRYPT_OK) {
       return err;
    }
-
-   hashsize = hash_descriptor[hash_idx].hashsize;
-
    /* RFC5869 parameter restrictions */
-   if (inlen < hashsize || outlen > hashsize * 255) {
+   if (prklen < hash_descriptor[hash_idx].hashsize) {
       return CRYPT_INVALID_ARG;
    }
-   if (info == NULL && infolen != 0) {
+   return hmac_key_init(&hkdf->prk, hash_idx, prk, prklen);
+}
+
+/**
+   HKDF-Expand with a keyed HKDF state
+   @param hkdf      The HKDF state as set up by hkdf_init()
+   @param info      The optional context and application specific information (can be NULL)
+   @param infolen   The length of the info (octets)
+   @param out       [out] The output keying material
+   @param outlen    The desired length of the output (octets)
+   @return CRYPT_OK if successful
+*/
+int hkdf_expand_state(const hkdf_state *hkdf,
+                      const unsigned char *info, unsigned long infolen,
+                            unsigned char *out,  unsigned long outlen)
+{
+   LTC_ARGCHK(hkdf != NULL);
+
+   return s_hkdf_expand(hkdf, &info, &infolen, 1, out, outlen);
+}
+
+/**
+   HKDF-Expand-Label as defined for TLS 1.3 in RFC 8446, section 7.1
+   @param hkdf        The HKDF state as set up by hkdf_init() with the secret
+   @param label       The label without the "tls13 " prefix
+   @param labellen    The length of the label (octets), at most 249
+   @param context     The context, e.g. a transcript hash (can be NULL)
+   @param contextlen  The length of the context (octets), at most 255
+   @param out         [out] The output keying material
+   @param outlen      The desired length of the output (octets)
+   @return CRYPT_OK if successful
+*/
+int hkdf_expand_label(const hkdf_state *hkdf,
+                      const unsigned char *label,   unsigned long labellen,
+                      const unsigned char *context, unsigned long contextlen,
+                            unsigned char *out,     unsigned long outlen)
+{
+   static const unsigned char prefix[] = { 't', 'l', 's', '1', '3', ' ' };
+   const unsigned char *info[5];
+   unsigned long infolen[5];
+   unsigned char hdr[3], ctxlen[1];
+
+   LTC_ARGCHK(hkdf  != NULL);
+   LTC_ARGCHK(label != NULL);
+
+   if (labellen + sizeof(prefix) > 255 || contextlen > 255 || outlen > 0xFFFFUL) {
       return CRYPT_INVALID_ARG;
    }
-   LTC_ARGCHK(out != NULL);
 
-   Tlen = hashsize + infolen + 1;
-   T = XMALLOC(Tlen); /* Replace with static buffer? */
-   if (T == NULL) {
-      return CRYPT_MEM;
-   }
-   if (info != NULL) {
-      XMEMCPY(T + hashsize, info, infolen);
-   }
+   /* struct { uint16 length; opaque label<7..255>; opaque context<0..255>; } HkdfLabel; */
+   hdr[0] = (unsigned char)(outlen >> 8);
+   hdr[1] = (unsigned char)(outlen & 255);
+   hdr[2] = (unsigned char)(labellen + sizeof(prefix));
+   ctxlen[0] = (unsigned char)contextlen;
 
-   /* HMAC data T(1) doesn't include a previous hash value */
-   dat    = T    + hashsize;
-   datlen = Tlen - hashsize;
+   info[0] = hdr;     infolen[0] = sizeof(hdr);
+   info[1] = prefix;  infolen[1] = sizeof(prefix);
+   info[2] = label;   infolen[2] = labellen;
+   info[3] = ctxlen;  infolen[3] = sizeof(ctxlen);
+   info[4] = context; infolen[4] = contextlen;
 
-   N = 0;
-   outoff = 0; /* offset in out to write to */
-   while (1) { /* an exit condition breaks mid-loop */
-      Noutlen = MIN(hashsize, outlen - outoff);
-      T[Tlen - 1] = ++N;
-      if ((err = hmac_memory(hash_idx, in, inlen, dat, datlen,
-                             out + outoff, &Noutlen)) != CRYPT_OK) {
-         zeromem(T, Tlen);
-         XFREE(T);
-         return err;
-      }
-      outoff += Noutlen;
+   return s_hkdf_expand(hkdf, info, infolen, 5, out, outlen);
+}
 
-      if (outoff >= outlen) { /* loop exit condition */
-         break;
-      }
+/**
+   HKDF-Expand-Label for several labels with the same secret
+   @param hkdf      The HKDF state as set up by hkdf_init() with the secret
+   @param labels    The labels, contexts and output buffers
+   @param n         The number of entries in labels
+   @return CRYPT_OK if successful
+*/
+int hkdf_expand_label_multi(const hkdf_state *hkdf, const hkdf_label *labels, unsigned long n)
+{
+   unsigned long i;
+   int err;
 
-      /* All subsequent HMAC data T(N) DOES include the previous hash value */
-      XMEMCPY(T, out + hashsize * (N-1), hashsize);
-      if (N == 1) {
-         dat = T;
-         datlen = Tlen;
+   LTC_ARGCHK(hkdf   != NULL);
+   LTC_ARGCHK(labels != NULL || n == 0);
+
+   for (i = 0; i < n; ++i) {
+      if ((err = hkdf_expand_label(hkdf, labels[i].label, labels[i].labellen,
+                                   labels[i].context, labels[i].contextlen,
+                                   labels[i].out, labels[i].outlen)) != CRYPT_OK) {
+         return err;
       }
    }
-   zeromem(T, Tlen);
-   XFREE(T);
    return CRYPT_OK;
 }
 
+int hkdf_expand(int hash_idx, const unsigned char *info, unsigned long infolen,
+                              const unsigned char *in,   unsigned long inlen,
+                                    unsigned char *out,  unsigned long outlen)
+{
+   hkdf_state hkdf;
+   int err;
+
+   /* the PRK keys all the HMAC invocations */
+   if ((err = hkdf_init(&hkdf, hash_idx, in, inlen)) != CRYPT_OK) {
+      return err;
+   }
+   err = s_hkdf_expand(&hkdf, &info, &infolen, 1, out, outlen);
+   zeromem(&hkdf, sizeof(hkdf));
+   return err;
+}
+
 /* all in one step */
 int hkdf(int hash_idx, const unsigned char *salt, unsigned long saltlen,
                        const unsigned char *info, unsigned long infolen,
@@ -106,27 +220,20 @@ int hkdf(int hash_idx, const unsigned char *salt, unsigned long saltlen,
 {
    unsigned long hashsize;
    int err;
-   unsigned char *extracted;
+   unsigned char extracted[MAXBLOCKSIZE];
 
    /* make sure hash descriptor is valid */
    if ((err = hash_is_valid(hash_idx)) != CRYPT_OK) {
       return err;
    }
 
-   hashsize = hash_descriptor[hash_idx].hashsize;
-
-   extracted = XMALLOC(hashsize); /* replace with static buffer? */
-   if (extracted == NULL) {
-      return CRYPT_MEM;
-   }
+   hashsize = sizeof(extracted);
    if ((err = hkdf_extract(hash_idx, salt, saltlen, in, inlen, extracted, &hashsize)) != 0) {
-      zeromem(extracted, hashsize);
-      XFREE(extracted);
+      zeromem(extracted, sizeof(extracted));
       return err;
    }
    err = hkdf_expand(hash_idx, info, infolen, extracted, hashsize, out, outlen);
-   zeromem(extracted, hashsize);
-   XFREE(extracted);
+   zeromem(extracted, sizeof(extracted));
    return err;
 }
 #endif /* LTC_HKDF */
@@ -20,6 +20,87 @@ ISSN: 2070-1721                                                    Nokia
 Appendix A. Test Vectors
 */
 
+#if defined(LTC_TEST) && defined(LTC_SHA256)
+/* the TLS 1.3 key schedule of RFC 8448, section 3 */
+static int s_hkdf_label_test(int hash)
+{
+   /* HKDF-Extract(0, 0) */
+   static const unsigned char early_secret[32] = {
+      0x33, 0xad, 0x0a, 0x1c, 0x60, 0x7e, 0xc0, 0x3b, 0x09, 0xe6, 0xcd, 0x98, 0x93, 0x68, 0x0c, 0xe2,
+      0x10, 0xad, 0xf3, 0x00, 0xaa, 0x1f, 0x26, 0x60, 0xe1, 0xb2, 0x2e, 0x10, 0xf1, 0x70, 0xf9, 0x2a
+   };
+   /* Derive-Secret(early_secret, "derived", "") */
+   static const unsigned char derived[32] = {
+      0x6f, 0x26, 0x15, 0xa1, 0x08, 0xc7, 0x02, 0xc5, 0x67, 0x8f, 0x54, 0xfc, 0x9d, 0xba, 0xb6, 0x97,
+      0x16, 0xc0, 0x76, 0x18, 0x9c, 0x48, 0x25, 0x0c, 0xeb, 0xea, 0xc3, 0x57, 0x6c, 0x36, 0x11, 0xba
+   };
+   /* SHA-256("") */
+   static const unsigned char empty_hash[32] = {
+      0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+      0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55
+   };
+   static const unsigned char info[] = {
+      0x00, 0x10, 0x09, 't', 'l', 's', '1', '3', ' ', 'k', 'e', 'y', 0x00
+   };
+   unsigned char zero[32], buf[32], key[16], iv[12], key2[16], iv2[12];
+   unsigned long len;
+   hkdf_state hkdf;
+   hkdf_label labels[2];
+   int err;
+
+   XMEMSET(zero, 0, sizeof(zero));
+   len = sizeof(buf);
+   if ((err = hkdf_extract(hash, zero, sizeof(zero), zero, sizeof(zero), buf, &len)) != CRYPT_OK) {
+      return err;
+   }
+   if (compare_testvector(buf, len, early_secret, sizeof(early_secret), "HKDF early secret", 0)) {
+      return CRYPT_FAIL_TESTVECTOR;
+   }
+
+   if ((err = hkdf_init(&hkdf, hash, early_secret, sizeof(early_secret))) != CRYPT_OK) {
+      return err;
+   }
+   if ((err = hkdf_expand_label(&hkdf, (const unsigned char*)"derived", 7, empty_hash, sizeof(empty_hash),
+                                buf, sizeof(buf))) != CRYPT_OK) {
+      return err;
+   }
+   if (compare_testvector(buf, sizeof(buf), derived, sizeof(derived), "HKDF-Expand-Label", 0)) {
+      return CRYPT_FAIL_TESTVECTOR;
+   }
+
+   /* the batch gives the same as the single calls and as hkdf_expand() with the encoded HkdfLabel */
+   labels[0].label = (const unsigned char*)"key";
+   labels[0].labellen = 3;
+   labels[0].context = NULL;
+   labels[0].contextlen = 0;
+   labels[0].out = key;
+   labels[0].outlen = sizeof(key);
+   labels[1] = labels[0];
+   labels[1].label = (const unsigned char*)"iv";
+   labels[1].labellen = 2;
+   labels[1].out = iv;
+   labels[1].outlen = sizeof(iv);
+   if ((err = hkdf_expand_label_multi(&hkdf, labels, 2)) != CRYPT_OK) {
+      return err;
+   }
+   if ((err = hkdf_expand_label(&hkdf, (const unsigned char*)"iv", 2, NULL, 0, iv2, sizeof(iv2))) != CRYPT_OK) {
+      return err;
+   }
+   if (compare_testvector(iv, sizeof(iv), iv2, sizeof(iv2), "HKDF-Expand-Label multi", 1)) {
+      return CRYPT_FAIL_TESTVECTOR;
+   }
+   if ((err = hkdf_expand(hash, info, sizeof(info), early_secret, sizeof(early_secret), key2, sizeof(key2))) != CRYPT_OK) {
+      return err;
+   }
+   if (compare_testvector(key, sizeof(key), key2, sizeof(key2), "HKDF-Expand-Label multi", 0)) {
+      return CRYPT_FAIL_TESTVECTOR;
+   }
+
+   zeromem(&hkdf, sizeof(hkdf));
+   return CRYPT_OK;
+}
+#endif
+
 /**
   LTC_HKDF self-test
   @return CRYPT_OK if successful, CRYPT_NOP if tests have been disabled.
@@ -273,6 +354,13 @@ int hkdf_test(void)
     if (failed != 0) {
         return CRYPT_FAIL_TESTVECTOR;
     }
+#ifdef LTC_SHA256
+    if ((i = find_hash("sha256")) != -1) {
+        if ((err = s_hkdf_label_test(i)) != CRYPT_OK) {
+            return err;
+        }
+    }
+#endif
     if (tested == 0) {
         return CRYPT_NOP;
     }
@@ -8,6 +8,45 @@
 */
 #ifdef LTC_PKCS_5
 
+/* compute one block of the output, U_1 ^ U_2 ^ ... ^ U_c, into t */
+static int s_pkcs_5_alg2_block(const hmac_key *hkey, hash_state *md,
+                               const unsigned char *salt, unsigned long salt_len,
+                               ulong32 blkno, int iteration_count,
+                               unsigned char *u, unsigned char *t)
+{
+   const struct ltc_hash_descriptor *hash = &hash_descriptor[hkey->hash];
+   unsigned char blk[4];
+   unsigned long hashsize, y;
+   int err, itts;
+
+   hashsize = hash->hashsize;
+   STORE32H(blkno, blk);
+
+   /* U_1 = PRF(P, S||int(blkno)) */
+   *md = hkey->inner;
+   if ((err = hash->process(md, salt, salt_len)) != CRYPT_OK)               { return err; }
+   if ((err = hash->process(md, blk, 4)) != CRYPT_OK)                       { return err; }
+   if ((err = hash->done(md, u)) != CRYPT_OK)                               { return err; }
+   *md = hkey->outer;
+   if ((err = hash->process(md, u, hashsize)) != CRYPT_OK)                  { return err; }
+   if ((err = hash->done(md, u)) != CRYPT_OK)                               { return err; }
+   XMEMCPY(t, u, hashsize);
+
+   /* U_i = PRF(P, U_{i-1}), both HMAC passes start from the precomputed midstates of the password */
+   for (itts = 1; itts < iteration_count; ++itts) {
+      *md = hkey->inner;
+      if ((err = hash->process(md, u, hashsize)) != CRYPT_OK)               { return err; }
+      if ((err = hash->done(md, u)) != CRYPT_OK)                            { return err; }
+      *md = hkey->outer;
+      if ((err = hash->process(md, u, hashsize)) != CRYPT_OK)               { return err; }
+      if ((err = hash->done(md, u)) != CRYPT_OK)                            { return err; }
+      for (y = 0; y < hashsize; y++) {
+         t[y] ^= u[y];
+      }
+   }
+   return CRYPT_OK;
+}
+
 /**
    Execute PKCS #5 v2
    @param password          The input password (or key)
@@ -25,11 +64,12 @@ int pkcs_5_alg2(const unsigned char *password, unsigned long password_len,
                 int iteration_count,           int hash_idx,
                 unsigned char *out,            unsigned long *outlen)
 {
-   int err, itts;
+   int err;
    ulong32  blkno;
    unsigned long stored, left, x, y;
    unsigned char *buf[2];
-   hmac_state    *hmac;
+   hash_state    *md;
+   hmac_key      *hkey;
 
    LTC_ARGCHK(password != NULL);
    LTC_ARGCHK(salt     != NULL);
@@ -46,10 +86,14 @@ int pkcs_5_alg2(const unsigned char *password, unsigned long password_len,
    }
 
    buf[0] = XMALLOC(MAXBLOCKSIZE * 2);
-   hmac   = XMALLOC(sizeof(hmac_state));
-   if (hmac == NULL || buf[0] == NULL) {
-      if (hmac != NULL) {
-         XFREE(hmac);
+   md     = XMALLOC(sizeof(hash_state));
+   hkey   = XMALLOC(sizeof(hmac_key));
+   if (md == NULL || hkey == NULL || buf[0] == NULL) {
+      if (md != NULL) {
+         XFREE(md);
+      }
+      if (hkey != NULL) {
+         XFREE(hkey);
       }
       if (buf[0] != NULL) {
          XFREE(buf[0]);
@@ -59,43 +103,21 @@ int pkcs_5_alg2(const unsigned char *password, unsigned long password_len,
    /* buf[1] points to the second block of MAXBLOCKSIZE bytes */
    buf[1] = buf[0] + MAXBLOCKSIZE;
 
+   /* the password is the HMAC key of every PRF invocation */
+   if ((err = hmac_key_init(hkey, hash_idx, password, password_len)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+
+   x      = hash_descriptor[hash_idx].hashsize;
    left   = *outlen;
    blkno  = 1;
    stored = 0;
    while (left != 0) {
-       /* process block number blkno */
-       zeromem(buf[0], MAXBLOCKSIZE*2);
-
-       /* store current block number and increment for next pass */
-       STORE32H(blkno, buf[1]);
-       ++blkno;
-
-       /* get PRF(P, S||int(blkno)) */
-       if ((err = hmac_init(hmac, hash_idx, password, password_len)) != CRYPT_OK) {
-          goto LBL_ERR;
-       }
-       if ((err = hmac_process(hmac, salt, salt_len)) != CRYPT_OK) {
-          goto LBL_ERR;
-       }
-       if ((err = hmac_process(hmac, buf[1], 4)) != CRYPT_OK) {
-          goto LBL_ERR;
-       }
-       x = MAXBLOCKSIZE;
-       if ((err = hmac_done(hmac, buf[0], &x)) != CRYPT_OK) {
+       /* process block number blkno and increment for next pass */
+       if ((err = s_pkcs_5_alg2_block(hkey, md, salt, salt_len, blkno++, iteration_count, buf[0], buf[1])) != CRYPT_OK) {
           goto LBL_ERR;
        }
 
-       /* now compute repeated and XOR it in buf[1] */
-       XMEMCPY(buf[1], buf[0], x);
-       for (itts = 1; itts < iteration_count; ++itts) {
-           if ((err = hmac_memory(hash_idx, password, password_len, buf[0], x, buf[0], &x)) != CRYPT_OK) {
-              goto LBL_ERR;
-           }
-           for (y = 0; y < x; y++) {
-               buf[1][y] ^= buf[0][y];
-           }
-       }
-
        /* now emit upto x bytes of buf[1] to output */
        for (y = 0; y < x && left != 0; ++y) {
            out[stored++] = buf[1][y];
@@ -106,12 +128,12 @@ int pkcs_5_alg2(const unsigned char *password, unsigned long password_len,
 
    err = CRYPT_OK;
 LBL_ERR:
-#ifdef LTC_CLEAN_STACK
    zeromem(buf[0], MAXBLOCKSIZE*2);
-   zeromem(hmac, sizeof(hmac_state));
-#endif
+   zeromem(md, sizeof(hash_state));
+   zeromem(hkey, sizeof(hmac_key));
 
-   XFREE(hmac);
+   XFREE(hkey);
+   XFREE(md);
    XFREE(buf[0]);
 
    return err;
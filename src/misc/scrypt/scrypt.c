@@ -0,0 +1,155 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+   @file scrypt.c
+   scrypt memory-hard password based key derivation, RFC 7914
+*/
+#ifdef LTC_SCRYPT
+
+/* scryptBlockMix with Salsa20/8, out must not overlap in */
+static void s_scrypt_blockmix(const ulong32 *in, ulong32 *out, unsigned long r)
+{
+   ulong32 x[16];
+   unsigned long i, j;
+
+   XMEMCPY(x, &in[(2 * r - 1) * 16], sizeof(x));
+   for (i = 0; i < 2 * r; ++i) {
+      for (j = 0; j < 16; ++j) {
+         x[j] ^= in[i * 16 + j];
+      }
+      salsa20_core(x, x, 8);
+      /* the even blocks go to the first half, the odd ones to the second */
+      XMEMCPY(&out[((i / 2) + (i & 1) * r) * 16], x, sizeof(x));
+   }
+}
+
+/* scryptROMix on one 128 * r octets block of B, v holds N * 32 * r and xy 64 * r words */
+static void s_scrypt_romix(unsigned char *b, unsigned long r, unsigned long N, ulong32 *v, ulong32 *xy)
+{
+   ulong32 *x = xy, *y = xy + 32 * r;
+   unsigned long i, j, k, words = 32 * r;
+
+   for (k = 0; k < words; ++k) {
+      LOAD32L(x[k], &b[4 * k]);
+   }
+
+   /* N is a power of two, so two steps per iteration let x and y swap roles */
+   for (i = 0; i < N; i += 2) {
+      XMEMCPY(&v[i * words], x, words * sizeof(ulong32));
+      s_scrypt_blockmix(x, y, r);
+      XMEMCPY(&v[(i + 1) * words], y, words * sizeof(ulong32));
+      s_scrypt_blockmix(y, x, r);
+   }
+   for (i = 0; i < N; i += 2) {
+      j = x[(2 * r - 1) * 16] & (N - 1);
+      for (k = 0; k < words; ++k) {
+         x[k] ^= v[j * words + k];
+      }
+      s_scrypt_blockmix(x, y, r);
+      j = y[(2 * r - 1) * 16] & (N - 1);
+      for (k = 0; k < words; ++k) {
+         y[k] ^= v[j * words + k];
+      }
+      s_scrypt_blockmix(y, x, r);
+   }
+
+   for (k = 0; k < words; ++k) {
+      STORE32L(x[k], &b[4 * k]);
+   }
+}
+
+/**
+   scrypt, RFC 7914
+   @param password          The password
+   @param password_len      The length of the password (octets)
+   @param salt              The salt
+   @param salt_len          The length of the salt (octets)
+   @param N                 The CPU/memory cost, a power of 2 greater than 1
+   @param r                 The block size
+   @param p                 The parallelization parameter
+   @param out               [out] The derived key
+   @param outlen            The desired length of the derived key (octets)
+   @return CRYPT_OK if successful
+*/
+int scrypt(const unsigned char *password, unsigned long password_len,
+           const unsigned char *salt,     unsigned long salt_len,
+           unsigned long N, unsigned long r, unsigned long p,
+           unsigned char *out,            unsigned long outlen)
+{
+   const unsigned char zero = 0;
+   unsigned char *b;
+   ulong32 *v, *xy;
+   unsigned long blen, vlen, xylen, i, len;
+   int err, hash_idx;
+
+   LTC_ARGCHK(password != NULL);
+   LTC_ARGCHK(salt     != NULL);
+   LTC_ARGCHK(out      != NULL);
+
+   if (N < 2 || (N & (N - 1)) != 0 || r == 0 || p == 0 || outlen == 0) {
+      return CRYPT_INVALID_ARG;
+   }
+   /* N < 2^(128 * r / 8) */
+   if (16 * r < sizeof(N) * CHAR_BIT && (N >> (16 * r)) != 0) {
+      return CRYPT_INVALID_ARG;
+   }
+   /* the scratch buffer of 256 * r octets, this is the first size that wraps with a 32bit unsigned long */
+   if (r > ((unsigned long)-1) / 256) {
+      return CRYPT_INVALID_ARG;
+   }
+   /* p * r <= 2^30 - 1 and the sizes of the buffers */
+   if (r > (0x3FFFFFFFUL / p) || r > ((unsigned long)-1) / 128 / p
+       || N > ((unsigned long)-1) / 128 / r) {
+      return CRYPT_OVERFLOW;
+   }
+   if ((hash_idx = find_hash("sha256")) == -1) {
+      return CRYPT_INVALID_HASH;
+   }
+   /* HMAC pads its key with zeros, so an empty password is the same as a single zero octet */
+   if (password_len == 0) {
+      password = &zero;
+      password_len = 1;
+   }
+
+   blen  = 128 * r * p;
+   vlen  = 128 * r * N;
+   xylen = 256 * r;
+
+   b  = XMALLOC(blen);
+   v  = XMALLOC(vlen);
+   xy = XMALLOC(xylen);
+   if (b == NULL || v == NULL || xy == NULL) {
+      err = CRYPT_MEM;
+      goto LBL_ERR;
+   }
+
+   len = blen;
+   if ((err = pkcs_5_alg2(password, password_len, salt, salt_len, 1, hash_idx, b, &len)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   for (i = 0; i < p; ++i) {
+      s_scrypt_romix(&b[128 * r * i], r, N, v, xy);
+   }
+   len = outlen;
+   err = pkcs_5_alg2(password, password_len, b, blen, 1, hash_idx, out, &len);
+
+LBL_ERR:
+   if (xy != NULL) {
+      zeromem(xy, xylen);
+      XFREE(xy);
+   }
+   if (v != NULL) {
+      zeromem(v, vlen);
+      XFREE(v);
+   }
+   if (b != NULL) {
+      zeromem(b, blen);
+      XFREE(b);
+   }
+
+   return err;
+}
+
+#endif
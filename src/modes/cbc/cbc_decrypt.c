@@ -21,7 +21,9 @@
 int cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, symmetric_CBC *cbc)
 {
    int x, err;
-   unsigned char tmp[16];
+   unsigned long i, n;
+   unsigned char tmp[LTC_ECB_BATCH_BLOCKS * 16], next[16];
+   const unsigned char *prev;
 #ifdef LTC_FAST
    LTC_FAST_TYPE tmpy;
 #else
@@ -37,7 +39,7 @@ int cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, s
    }
 
    /* is blocklen valid? */
-   if (cbc->blocklen < 1 || cbc->blocklen > (int)sizeof(cbc->IV) || cbc->blocklen > (int)sizeof(tmp)) {
+   if (cbc->blocklen < 1 || cbc->blocklen > (int)sizeof(cbc->IV) || cbc->blocklen > (int)sizeof(next)) {
       return CRYPT_INVALID_ARG;
    }
 
@@ -53,31 +55,38 @@ int cbc_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, s
    if (cipher_descriptor[cbc->cipher].accel_cbc_decrypt != NULL) {
       return cipher_descriptor[cbc->cipher].accel_cbc_decrypt(ct, pt, len / cbc->blocklen, cbc->IV, &cbc->key);
    }
+   /* the blocks are independent on the way back, decrypt a batch of them at once */
    while (len) {
-      /* decrypt */
-      if ((err = cipher_descriptor[cbc->cipher].ecb_decrypt(ct, tmp, &cbc->key)) != CRYPT_OK) {
+      n = MIN(len / cbc->blocklen, LTC_ECB_BATCH_BLOCKS);
+      if ((err = cipher_ecb_decrypt_blocks(cbc->cipher, ct, tmp, n, &cbc->key)) != CRYPT_OK) {
          return err;
       }
+      XMEMCPY(next, ct + (n - 1) * cbc->blocklen, cbc->blocklen);
 
-      /* xor IV against plaintext */
+      /* backwards, so that pt may equal ct */
+      for (i = n; i-- > 0;) {
+         prev = (i == 0) ? cbc->IV : ct + (i - 1) * cbc->blocklen;
 #if defined(LTC_FAST)
-      for (x = 0; x < cbc->blocklen; x += sizeof(LTC_FAST_TYPE)) {
-         tmpy = *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)cbc->IV + x)) ^ *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)tmp + x));
-         *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)cbc->IV + x)) = *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)ct + x));
-         *(LTC_FAST_TYPE_PTR_CAST((unsigned char *)pt + x)) = tmpy;
-      }
+         for (x = 0; x < cbc->blocklen; x += sizeof(LTC_FAST_TYPE)) {
+            tmpy = *(LTC_FAST_TYPE_PTR_CAST(prev + x)) ^ *(LTC_FAST_TYPE_PTR_CAST(tmp + i * cbc->blocklen + x));
+            *(LTC_FAST_TYPE_PTR_CAST(pt + i * cbc->blocklen + x)) = tmpy;
+         }
 #else
-      for (x = 0; x < cbc->blocklen; x++) {
-         tmpy       = tmp[x] ^ cbc->IV[x];
-         cbc->IV[x] = ct[x];
-         pt[x]      = tmpy;
-      }
+         for (x = 0; x < cbc->blocklen; x++) {
+            tmpy = tmp[i * cbc->blocklen + x] ^ prev[x];
+            pt[i * cbc->blocklen + x] = tmpy;
+         }
 #endif
+      }
+      XMEMCPY(cbc->IV, next, cbc->blocklen);
 
-      ct  += cbc->blocklen;
-      pt  += cbc->blocklen;
-      len -= cbc->blocklen;
+      ct  += n * cbc->blocklen;
+      pt  += n * cbc->blocklen;
+      len -= n * cbc->blocklen;
    }
+#ifdef LTC_CLEAN_STACK
+   zeromem(tmp, sizeof(tmp));
+#endif
    return CRYPT_OK;
 }
 
@@ -31,6 +31,31 @@ static LTC_INLINE void s_shift1left_128(unsigned char *b, unsigned char v)
    STORE64H(bval[1], b + 8);
 }
 
+/* full block feedback: the key stream blocks only depend on the ciphertext, encrypt a batch of them at once */
+static int s_cfb_decrypt_blocks(const unsigned char *ct, unsigned char *pt, unsigned long blocks, symmetric_CFB *cfb)
+{
+   unsigned char buf[LTC_ECB_BATCH_BLOCKS * 16];
+   unsigned long bl = (unsigned long)cfb->blocklen, x;
+   int err;
+
+   XMEMCPY(buf, cfb->pad, bl);
+   XMEMCPY(buf + bl, ct, (blocks - 1) * bl);
+   if ((err = cipher_ecb_encrypt_blocks(cfb->cipher, buf, buf, blocks, &cfb->key)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   XMEMCPY(cfb->pad, ct + (blocks - 1) * bl, bl);
+   XMEMCPY(cfb->IV, buf + (blocks - 1) * bl, bl);
+   for (x = 0; x < blocks * bl; x++) {
+      pt[x] = ct[x] ^ buf[x];
+   }
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(buf, sizeof(buf));
+#endif
+   return err;
+}
+
 /**
    CFB decrypt
    @param ct      Ciphertext
@@ -42,6 +67,7 @@ static LTC_INLINE void s_shift1left_128(unsigned char *b, unsigned char v)
 int cfb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, symmetric_CFB *cfb)
 {
    int err;
+   unsigned long n;
    ulong64 bitlen = len * 8, bits_per_round;
    unsigned int cur_bit = 0;
    unsigned char pt_ = 0, ct_ = 0;
@@ -67,6 +93,17 @@ int cfb_decrypt(const unsigned char *ct, unsigned char *pt, unsigned long len, s
    bits_per_round = cfb->width == 1 ? 1 : 8;
 
    while (bitlen > 0) {
+       if (cfb->padlen == cfb->blocklen && cfb->width == cfb->blocklen * 8 && cfb->blocklen <= 16
+           && bitlen >= bits_per_round * (ulong64)cfb->blocklen * 2) {
+          n = (unsigned long)MIN(bitlen / 8 / (ulong64)cfb->blocklen, LTC_ECB_BATCH_BLOCKS);
+          if ((err = s_cfb_decrypt_blocks(ct, pt, n, cfb)) != CRYPT_OK) {
+             return err;
+          }
+          ct     += n * cfb->blocklen;
+          pt     += n * cfb->blocklen;
+          bitlen -= (ulong64)n * cfb->blocklen * 8;
+          continue;
+       }
        if (cfb->padlen == cfb->blocklen) {
           if ((err = cipher_descriptor[cfb->cipher].ecb_encrypt(cfb->pad, cfb->IV, &cfb->key)) != CRYPT_OK) {
              return err;
@@ -10,6 +10,64 @@
 
 #ifdef LTC_CTR_MODE
 
+static void s_ctr_increment(symmetric_CTR *ctr)
+{
+   int x;
+
+   if (ctr->mode == CTR_COUNTER_LITTLE_ENDIAN) {
+      /* little-endian */
+      for (x = 0; x < ctr->ctrlen; x++) {
+         ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
+         if (ctr->ctr[x] != (unsigned char)0) {
+            break;
+         }
+      }
+   } else {
+      /* big-endian */
+      for (x = ctr->blocklen-1; x >= ctr->ctrlen; x--) {
+         ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
+         if (ctr->ctr[x] != (unsigned char)0) {
+            break;
+         }
+      }
+   }
+}
+
+/**
+  CTR encrypt whole blocks, the counters of a batch are encrypted at once
+  @param pt     Plaintext
+  @param ct     [out] Ciphertext
+  @param blocks Number of blocks, at most LTC_ECB_BATCH_BLOCKS
+  @param ctr    CTR state, the pad has to be used up
+  @return CRYPT_OK if successful
+*/
+static int s_ctr_encrypt_blocks(const unsigned char *pt, unsigned char *ct, unsigned long blocks, symmetric_CTR *ctr)
+{
+   unsigned char buf[LTC_ECB_BATCH_BLOCKS * 16];
+   unsigned long x, bl = (unsigned long)ctr->blocklen;
+   int err;
+
+   for (x = 0; x < blocks; x++) {
+      s_ctr_increment(ctr);
+      XMEMCPY(buf + x * bl, ctr->ctr, bl);
+   }
+   if ((err = cipher_ecb_encrypt_blocks(ctr->cipher, buf, buf, blocks, &ctr->key)) != CRYPT_OK) {
+      goto LBL_ERR;
+   }
+   for (x = 0; x < blocks * bl; x++) {
+      ct[x] = pt[x] ^ buf[x];
+   }
+   /* keep the last pad, as if the blocks had been processed one by one */
+   XMEMCPY(ctr->pad, buf + (blocks - 1) * bl, bl);
+   ctr->padlen = ctr->blocklen;
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(buf, sizeof(buf));
+#endif
+   return err;
+}
+
 /**
   CTR encrypt software implementation
   @param pt     Plaintext
@@ -20,29 +78,27 @@
 */
 static int s_ctr_encrypt(const unsigned char *pt, unsigned char *ct, unsigned long len, symmetric_CTR *ctr)
 {
-   int x, err;
+   unsigned long n;
+   int err;
+#ifdef LTC_FAST
+   int x;
+#endif
 
    while (len) {
+      /* several whole blocks left and the pad used up? */
+      if ((ctr->padlen == ctr->blocklen) && (ctr->blocklen <= 16) && (len >= 2 * (unsigned long)ctr->blocklen)) {
+         n = MIN(len / ctr->blocklen, LTC_ECB_BATCH_BLOCKS);
+         if ((err = s_ctr_encrypt_blocks(pt, ct, n, ctr)) != CRYPT_OK) {
+            return err;
+         }
+         pt  += n * ctr->blocklen;
+         ct  += n * ctr->blocklen;
+         len -= n * ctr->blocklen;
+         continue;
+      }
       /* is the pad empty? */
       if (ctr->padlen == ctr->blocklen) {
-         /* increment counter */
-         if (ctr->mode == CTR_COUNTER_LITTLE_ENDIAN) {
-            /* little-endian */
-            for (x = 0; x < ctr->ctrlen; x++) {
-               ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
-               if (ctr->ctr[x] != (unsigned char)0) {
-                  break;
-               }
-            }
-         } else {
-            /* big-endian */
-            for (x = ctr->blocklen-1; x >= ctr->ctrlen; x--) {
-               ctr->ctr[x] = (ctr->ctr[x] + (unsigned char)1) & (unsigned char)255;
-               if (ctr->ctr[x] != (unsigned char)0) {
-                  break;
-               }
-            }
-         }
+         s_ctr_increment(ctr);
 
          /* encrypt it */
          if ((err = cipher_descriptor[ctr->cipher].ecb_encrypt(ctr->ctr, ctr->pad, &ctr->key)) != CRYPT_OK) {
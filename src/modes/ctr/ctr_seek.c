@@ -0,0 +1,55 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file ctr_seek.c
+  CTR implementation, random access to the key stream
+*/
+
+#ifdef LTC_CTR_MODE
+
+/**
+   Move to a position in the key stream
+   The position is relative to the IV given to ctr_start() or ctr_setiv(),
+   the counter is advanced with respect to its endianness and width.
+   @param offset  The new position (octets)
+   @param ctr     The CTR state
+   @return CRYPT_OK if successful
+*/
+int ctr_seek(ulong64 offset, symmetric_CTR *ctr)
+{
+   ulong64 carry, t;
+   int x, err;
+
+   LTC_ARGCHK(ctr != NULL);
+
+   if ((err = cipher_is_valid(ctr->cipher)) != CRYPT_OK) {
+      return err;
+   }
+   if ((ctr->blocklen < 1) || (ctr->blocklen > (int)sizeof(ctr->ctr))) {
+      return CRYPT_INVALID_ARG;
+   }
+
+   /* ctr = ctr0 + offset / blocklen, modulo the counter width */
+   XMEMCPY(ctr->ctr, ctr->ctr0, ctr->blocklen);
+   carry = offset / (ulong64)ctr->blocklen;
+   if (ctr->mode == CTR_COUNTER_LITTLE_ENDIAN) {
+      for (x = 0; x < ctr->ctrlen && carry != 0; x++) {
+         t           = (ulong64)ctr->ctr[x] + (carry & 255);
+         ctr->ctr[x] = (unsigned char)(t & 255);
+         carry       = (carry >> 8) + (t >> 8);
+      }
+   } else {
+      for (x = ctr->blocklen-1; x >= ctr->ctrlen && carry != 0; x--) {
+         t           = (ulong64)ctr->ctr[x] + (carry & 255);
+         ctr->ctr[x] = (unsigned char)(t & 255);
+         carry       = (carry >> 8) + (t >> 8);
+      }
+   }
+
+   ctr->padlen = (int)(offset % (ulong64)ctr->blocklen);
+   return cipher_descriptor[ctr->cipher].ecb_encrypt(ctr->ctr, ctr->pad, &ctr->key);
+}
+
+#endif
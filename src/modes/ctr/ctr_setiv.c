@@ -34,6 +34,7 @@ int ctr_setiv(const unsigned char *IV, unsigned long len, symmetric_CTR *ctr)
 
    /* set IV */
    XMEMCPY(ctr->ctr, IV, len);
+   XMEMCPY(ctr->ctr0, IV, len);
 
    /* force next block */
    ctr->padlen = 0;
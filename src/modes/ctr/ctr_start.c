@@ -83,6 +83,8 @@ int ctr_start(               int   cipher,
       }
    }
 
+   XMEMCPY(ctr->ctr0, ctr->ctr, ctr->blocklen);
+
    return cipher_descriptor[ctr->cipher].ecb_encrypt(ctr->ctr, ctr->pad, &ctr->key);
 }
 
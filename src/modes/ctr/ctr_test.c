@@ -9,6 +9,52 @@
 
 #ifdef LTC_CTR_MODE
 
+#ifndef LTC_NO_TEST
+/* every seek position has to give the same key stream as sequential processing, also across a wrap of the counter */
+static int s_ctr_seek_test(int idx)
+{
+   static const int modes[] = {
+      CTR_COUNTER_LITTLE_ENDIAN, CTR_COUNTER_LITTLE_ENDIAN | 2,
+      CTR_COUNTER_BIG_ENDIAN,    CTR_COUNTER_BIG_ENDIAN | 4,   CTR_COUNTER_BIG_ENDIAN | LTC_CTR_RFC3686
+   };
+   static const unsigned long offsets[] = { 0, 1, 15, 16, 17, 100, 255, 299 };
+   unsigned char key[16], IV[16], pt[300], ct[300], buf[300];
+   unsigned long n, o;
+   symmetric_CTR ctr;
+   int err, m;
+
+   for (n = 0; n < sizeof(key); n++) {
+      key[n] = (unsigned char)n;
+      IV[n]  = 0xFF;
+   }
+   for (n = 0; n < sizeof(pt); n++) {
+      pt[n] = (unsigned char)(n * 3);
+   }
+   for (m = 0; m < (int)(sizeof(modes)/sizeof(modes[0])); m++) {
+      if ((err = ctr_start(idx, IV, key, 16, 0, modes[m], &ctr)) != CRYPT_OK) {
+         return err;
+      }
+      if ((err = ctr_encrypt(pt, ct, sizeof(pt), &ctr)) != CRYPT_OK) {
+         return err;
+      }
+      for (o = 0; o < sizeof(offsets)/sizeof(offsets[0]); o++) {
+         n = offsets[o];
+         if ((err = ctr_seek(n, &ctr)) != CRYPT_OK) {
+            return err;
+         }
+         if ((err = ctr_encrypt(pt + n, buf, sizeof(pt) - n, &ctr)) != CRYPT_OK) {
+            return err;
+         }
+         if (compare_testvector(buf, sizeof(pt) - n, ct + n, sizeof(pt) - n, "CTR seek", m * 100 + (int)o)) {
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+      ctr_done(&ctr);
+   }
+   return CRYPT_OK;
+}
+#endif
+
 int ctr_test(void)
 {
 #ifdef LTC_NO_TEST
@@ -63,7 +109,7 @@ int ctr_test(void)
         return CRYPT_FAIL_TESTVECTOR;
      }
   }
-  return CRYPT_OK;
+  return s_ctr_seek_test(idx);
 #endif
 }
 
@@ -0,0 +1,194 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+  @file xts_sectors.c
+  XTS encryption and decryption of runs of consecutive sectors
+*/
+
+#ifdef LTC_XTS_MODE
+
+#define XTS_BATCH LTC_ECB_BATCH_BLOCKS
+
+/*
+   The blocks of all sectors form one stream: whitened blocks are collected into batches
+   that may cross a sector boundary and the tweaks of the next sectors are encrypted
+   ahead in batches as well.
+*/
+static int s_xts_sectors(const unsigned char *in, unsigned char *out,
+                         unsigned long sector_size, ulong64 sector, unsigned long nsectors,
+                         const symmetric_xts *xts, int enc)
+{
+   unsigned char T[XTS_BATCH][16], W[XTS_BATCH][16], buf[XTS_BATCH][16], cur[16];
+   unsigned long sector_blocks, left_in_sector, total, n, x, y, tw_next, tw_avail;
+   int err;
+
+   sector_blocks  = sector_size >> 4;
+   total          = sector_blocks * nsectors;
+   left_in_sector = 0;
+   tw_next = tw_avail = 0;
+   err = CRYPT_OK;
+
+   while (total > 0) {
+      n = MIN(total, XTS_BATCH);
+      for (x = 0; x < n; x++) {
+         if (left_in_sector == 0) {
+            /* encrypt the tweaks of the next sectors in one go */
+            if (tw_next == tw_avail) {
+               tw_avail = MIN(nsectors, XTS_BATCH);
+               for (y = 0; y < tw_avail; y++) {
+                  STORE64L(sector + y, T[y]);
+                  XMEMSET(T[y] + 8, 0, 8);
+               }
+               if ((err = cipher_ecb_encrypt_blocks(xts->cipher, T[0], T[0], tw_avail, &xts->key2)) != CRYPT_OK) {
+                  goto LBL_ERR;
+               }
+               sector   += tw_avail;
+               nsectors -= tw_avail;
+               tw_next   = 0;
+            }
+            XMEMCPY(cur, T[tw_next++], 16);
+            left_in_sector = sector_blocks;
+         }
+         XMEMCPY(W[x], cur, 16);
+         for (y = 0; y < 16; y++) {
+            buf[x][y] = in[y] ^ cur[y];
+         }
+         xts_mult_x(cur);
+         in += 16;
+         --left_in_sector;
+      }
+
+      if (enc) {
+         err = cipher_ecb_encrypt_blocks(xts->cipher, buf[0], buf[0], n, &xts->key1);
+      } else {
+         err = cipher_ecb_decrypt_blocks(xts->cipher, buf[0], buf[0], n, &xts->key1);
+      }
+      if (err != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+
+      for (x = 0; x < n; x++) {
+         for (y = 0; y < 16; y++) {
+            out[y] = buf[x][y] ^ W[x][y];
+         }
+         out += 16;
+      }
+      total -= n;
+   }
+
+LBL_ERR:
+#ifdef LTC_CLEAN_STACK
+   zeromem(T, sizeof(T));
+   zeromem(W, sizeof(W));
+   zeromem(buf, sizeof(buf));
+   zeromem(cur, sizeof(cur));
+#endif
+   return err;
+}
+
+/* one sector at a time, for ciphertext stealing or an accelerated cipher */
+static int s_xts_sectors_single(const unsigned char *in, unsigned char *out,
+                                unsigned long sector_size, ulong64 sector, unsigned long nsectors,
+                                const symmetric_xts *xts, int enc)
+{
+   unsigned char T[16];
+   unsigned long n;
+   int err;
+
+   for (n = 0; n < nsectors; n++) {
+      STORE64L(sector + n, T);
+      XMEMSET(T + 8, 0, 8);
+      if (enc) {
+         err = xts_encrypt(in, sector_size, out, T, xts);
+      } else {
+         err = xts_decrypt(in, sector_size, out, T, xts);
+      }
+      if (err != CRYPT_OK) {
+         return err;
+      }
+      in  += sector_size;
+      out += sector_size;
+   }
+   return CRYPT_OK;
+}
+
+static int s_xts_sectors_check(const unsigned char *in, const unsigned char *out,
+                               unsigned long sector_size, ulong64 sector, unsigned long nsectors,
+                               const symmetric_xts *xts)
+{
+   int err;
+
+   LTC_ARGCHK(in  != NULL);
+   LTC_ARGCHK(out != NULL);
+   LTC_ARGCHK(xts != NULL);
+
+   if ((err = cipher_is_valid(xts->cipher)) != CRYPT_OK) {
+      return err;
+   }
+   if (sector_size < 16) {
+      return CRYPT_INVALID_ARG;
+   }
+   if (nsectors > ((unsigned long)-1) / sector_size) {
+      return CRYPT_OVERFLOW;
+   }
+   /* the sector numbers are 64 bits wide, the run must not wrap around */
+   if (nsectors > 0 && sector + (nsectors - 1) < sector) {
+      return CRYPT_OVERFLOW;
+   }
+   return CRYPT_OK;
+}
+
+/**
+  XTS encrypt consecutive sectors
+  The tweak of each sector is its number as 128-bit little endian value, as described in IEEE P1619.
+  @param pt            The plaintext of all sectors
+  @param ct            [out] The ciphertext, may equal pt
+  @param sector_size   The length of one sector (octets), at least 16
+  @param sector        The number of the first sector
+  @param nsectors      The number of sectors
+  @param xts           The XTS structure
+  @return CRYPT_OK if successful
+*/
+int xts_encrypt_sectors(const unsigned char *pt, unsigned char *ct,
+                        unsigned long sector_size, ulong64 sector, unsigned long nsectors,
+                        const symmetric_xts *xts)
+{
+   int err;
+
+   if ((err = s_xts_sectors_check(pt, ct, sector_size, sector, nsectors, xts)) != CRYPT_OK) {
+      return err;
+   }
+   if ((sector_size & 15) != 0 || cipher_descriptor[xts->cipher].accel_xts_encrypt != NULL) {
+      return s_xts_sectors_single(pt, ct, sector_size, sector, nsectors, xts, 1);
+   }
+   return s_xts_sectors(pt, ct, sector_size, sector, nsectors, xts, 1);
+}
+
+/**
+  XTS decrypt consecutive sectors
+  @param ct            The ciphertext of all sectors
+  @param pt            [out] The plaintext, may equal ct
+  @param sector_size   The length of one sector (octets), at least 16
+  @param sector        The number of the first sector
+  @param nsectors      The number of sectors
+  @param xts           The XTS structure
+  @return CRYPT_OK if successful
+*/
+int xts_decrypt_sectors(const unsigned char *ct, unsigned char *pt,
+                        unsigned long sector_size, ulong64 sector, unsigned long nsectors,
+                        const symmetric_xts *xts)
+{
+   int err;
+
+   if ((err = s_xts_sectors_check(ct, pt, sector_size, sector, nsectors, xts)) != CRYPT_OK) {
+      return err;
+   }
+   if ((sector_size & 15) != 0 || cipher_descriptor[xts->cipher].accel_xts_decrypt != NULL) {
+      return s_xts_sectors_single(ct, pt, sector_size, sector, nsectors, xts, 0);
+   }
+   return s_xts_sectors(ct, pt, sector_size, sector, nsectors, xts, 0);
+}
+
+#endif
@@ -0,0 +1,166 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#include "tomcrypt_private.h"
+
+/**
+  @file dh_fixed_base.c
+  DH fixed-base exponentiation for the built-in groups,
+  using lazily built comb tables of their generator
+*/
+
+#ifdef LTC_DH_FIXED_BASE
+
+/* number of teeth of the comb, each table has 2^DH_COMB_TEETH entries */
+#define DH_COMB_TEETH   8
+
+/* one entry per possible group in ltc_dh_sets[] */
+#define DH_COMB_ENTRIES 8
+
+/** Our comb cache */
+static struct {
+   void        *base,                 /* copy of the generator */
+               *prime,                /* copy of the prime */
+               *mp;                   /* the montgomery constant of prime */
+   ltc_mp_comb  comb;                 /* the comb table of the generator */
+   void       (*deinit)(void *a);     /* the math provider which built the table */
+   void       (*montgomery_deinit)(void *a);
+   int          users,                /* number of exponentiations running on the table */
+                stale;                /* free the entry once the last user is done */
+} s_dh_comb[DH_COMB_ENTRIES];
+
+LTC_MUTEX_GLOBAL(ltc_dh_comb_lock)
+
+static void s_dh_comb_free_entry(int idx)
+{
+   if (s_dh_comb[idx].deinit == NULL) {
+      return;
+   }
+   ltc_mp_fixed_base_free(&s_dh_comb[idx].comb);
+   if (s_dh_comb[idx].base != NULL) {
+      s_dh_comb[idx].deinit(s_dh_comb[idx].base);
+   }
+   if (s_dh_comb[idx].prime != NULL) {
+      s_dh_comb[idx].deinit(s_dh_comb[idx].prime);
+   }
+   if (s_dh_comb[idx].mp != NULL) {
+      s_dh_comb[idx].montgomery_deinit(s_dh_comb[idx].mp);
+   }
+   zeromem(&s_dh_comb[idx], sizeof(s_dh_comb[idx]));
+}
+
+/* build the comb for ltc_dh_sets[idx], the table covers exponents of up to `bits` bits */
+static int s_dh_comb_build(int idx, unsigned long bits)
+{
+   int err;
+
+   s_dh_comb[idx].deinit            = ltc_mp.deinit;
+   s_dh_comb[idx].montgomery_deinit = ltc_mp.montgomery_deinit;
+
+   if ((err = mp_init_multi(&s_dh_comb[idx].base, &s_dh_comb[idx].prime, LTC_NULL)) != CRYPT_OK)  { goto error; }
+   if ((err = mp_read_radix(s_dh_comb[idx].base, ltc_dh_sets[idx].base, 16)) != CRYPT_OK)        { goto error; }
+   if ((err = mp_read_radix(s_dh_comb[idx].prime, ltc_dh_sets[idx].prime, 16)) != CRYPT_OK)      { goto error; }
+   if ((err = mp_montgomery_setup(s_dh_comb[idx].prime, &s_dh_comb[idx].mp)) != CRYPT_OK)        { goto error; }
+   if ((err = ltc_mp_fixed_base_init(&s_dh_comb[idx].comb, s_dh_comb[idx].base, s_dh_comb[idx].prime,
+                                     s_dh_comb[idx].mp, DH_COMB_TEETH, bits, 1)) != CRYPT_OK)     { goto error; }
+
+   return CRYPT_OK;
+
+error:
+   s_dh_comb_free_entry(idx);
+   return err;
+}
+
+/**
+  Compute y = g^x mod p with the comb table of the built-in group matching the key
+
+  The lock isn't held during the exponentiation, instead the entry counts its users
+  and is only freed or rebuilt while nobody works on it.
+  @param key     The DH key, its base and prime are used
+  @param x       The exponent as big-endian octets
+  @param xlen    The length of x
+  @param y       [out] The result
+  @return CRYPT_OK if successful, CRYPT_NOP if the key doesn't use a built-in group
+*/
+int dh_fixed_base_exptmod(const dh_key *key, const unsigned char *x, unsigned long xlen, void *y)
+{
+   int idx, groupsize, err;
+   ltc_mp_comb *comb;
+   void *prime, *base, *mp;
+
+   LTC_ARGCHK(key != NULL);
+   LTC_ARGCHK(x   != NULL);
+   LTC_ARGCHK(y   != NULL);
+
+   groupsize = mp_unsigned_bin_size(key->prime);
+   for (idx = 0; (groupsize != ltc_dh_sets[idx].size) && (ltc_dh_sets[idx].size != 0); idx++);
+   if (ltc_dh_sets[idx].size == 0 || idx >= DH_COMB_ENTRIES) {
+      return CRYPT_NOP;
+   }
+
+   /* a custom group of the same size must neither build nor replace the table of the built-in one */
+   if ((err = mp_init_multi(&prime, &base, LTC_NULL)) != CRYPT_OK) {
+      return err;
+   }
+   if ((err = mp_read_radix(prime, ltc_dh_sets[idx].prime, 16)) == CRYPT_OK &&
+       (err = mp_read_radix(base, ltc_dh_sets[idx].base, 16)) == CRYPT_OK &&
+       (mp_cmp(key->prime, prime) != LTC_MP_EQ || mp_cmp(key->base, base) != LTC_MP_EQ)) {
+      err = CRYPT_NOP;
+   }
+   mp_clear_multi(prime, base, LTC_NULL);
+   if (err != CRYPT_OK) {
+      return err;
+   }
+
+   LTC_MUTEX_LOCK(&ltc_dh_comb_lock);
+   if (s_dh_comb[idx].deinit != NULL &&
+       (s_dh_comb[idx].stale ||
+        s_dh_comb[idx].deinit != ltc_mp.deinit ||                                 /* the math provider was switched */
+        (unsigned long)s_dh_comb[idx].comb.cols * DH_COMB_TEETH < xlen * 8)) {     /* a longer exponent than before */
+      if (s_dh_comb[idx].users != 0) {
+         /* still in use, this one goes the regular way */
+         LTC_MUTEX_UNLOCK(&ltc_dh_comb_lock);
+         return CRYPT_NOP;
+      }
+      s_dh_comb_free_entry(idx);
+   }
+   if (s_dh_comb[idx].deinit == NULL) {
+      if ((err = s_dh_comb_build(idx, xlen * 8)) != CRYPT_OK) {
+         LTC_MUTEX_UNLOCK(&ltc_dh_comb_lock);
+         return err;
+      }
+   }
+   s_dh_comb[idx].users++;
+   comb  = &s_dh_comb[idx].comb;
+   prime = s_dh_comb[idx].prime;
+   mp    = s_dh_comb[idx].mp;
+   LTC_MUTEX_UNLOCK(&ltc_dh_comb_lock);
+
+   err = ltc_mp_fixed_base_exptmod(comb, &x, &xlen, 1, prime, mp, y, 1);
+
+   LTC_MUTEX_LOCK(&ltc_dh_comb_lock);
+   if (--s_dh_comb[idx].users == 0 && s_dh_comb[idx].stale) {
+      s_dh_comb_free_entry(idx);
+   }
+   LTC_MUTEX_UNLOCK(&ltc_dh_comb_lock);
+
+   return err;
+}
+
+/** Free the comb tables of the built-in DH groups, a table that is still in use is freed by its last user */
+void dh_fixed_base_free(void)
+{
+   int idx;
+
+   LTC_MUTEX_LOCK(&ltc_dh_comb_lock);
+   for (idx = 0; idx < DH_COMB_ENTRIES; idx++) {
+      if (s_dh_comb[idx].users != 0) {
+         s_dh_comb[idx].stale = 1;
+      } else {
+         s_dh_comb_free_entry(idx);
+      }
+   }
+   LTC_MUTEX_UNLOCK(&ltc_dh_comb_lock);
+}
+
+#endif /* LTC_DH_FIXED_BASE */
@@ -73,9 +73,19 @@ int dh_generate_key(prng_state *prng, int wprng, dh_key *key)
          goto freebuf;
       }
       /* compute the y value - public key */
+#ifdef LTC_DH_FIXED_BASE
+      err = dh_fixed_base_exptmod(key, buf, keysize, key->y);
+      if (err == CRYPT_NOP) {
+         err = mp_exptmod(key->base, key->x, key->prime, key->y);
+      }
+      if (err != CRYPT_OK) {
+         goto freebuf;
+      }
+#else
       if ((err = mp_exptmod(key->base, key->x, key->prime, key->y)) != CRYPT_OK) {
          goto freebuf;
       }
+#endif
       err = dh_check_pubkey(key);
    } while (err != CRYPT_OK && max_iterations-- > 0);
 
@@ -45,7 +45,7 @@ int dh_shared_secret(const dh_key *private_key, const dh_key *public_key,
    }
 
    /* compute tmp = y^x mod p */
-   if ((err = mp_exptmod(public_key->y, private_key->x, private_key->prime, tmp)) != CRYPT_OK)  {
+   if ((err = mp_exptmod_secret(public_key->y, private_key->x, private_key->prime, tmp)) != CRYPT_OK)  {
       goto error;
    }
 
@@ -0,0 +1,77 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+#include "tomcrypt_private.h"
+
+/**
+   @file dsa_prepare_key.c
+   DSA implementation, precompute the tables of a key
+*/
+
+#ifdef LTC_MDSA
+
+/**
+  Precompute the comb tables of g and y for faster signing and verification
+  @param key     The DSA key, it must stay valid as long as the prepared key is used
+  @param prep    [out] The prepared key
+  @return CRYPT_OK if successful
+*/
+int dsa_prepare_key(const dsa_key *key, dsa_prepared_key *prep)
+{
+   ltc_mp_comb  *comb;
+   unsigned long bits;
+   int           err;
+
+   LTC_ARGCHK(key         != NULL);
+   LTC_ARGCHK(prep        != NULL);
+   LTC_ARGCHK(ltc_mp.name != NULL);
+
+   XMEMSET(prep, 0, sizeof(*prep));
+
+   comb = XCALLOC(2, sizeof(*comb));
+   if (comb == NULL) {
+      return CRYPT_MEM;
+   }
+
+   /* all exponents are < q, the one for g is the signing nonce and must not leak through the lookups */
+   bits = (unsigned long)mp_count_bits(key->q);
+
+   if ((err = mp_montgomery_setup(key->p, &prep->mp)) != CRYPT_OK)                                       { goto error; }
+   if ((err = ltc_mp_fixed_base_init(&comb[0], key->g, key->p, prep->mp, LTC_MDSA_COMB_TEETH, bits, 1)) != CRYPT_OK) { goto error; }
+   if ((err = ltc_mp_fixed_base_init(&comb[1], key->y, key->p, prep->mp, LTC_MDSA_COMB_TEETH, bits, 0)) != CRYPT_OK) { goto error; }
+
+   prep->key    = key;
+   prep->tables = comb;
+   return CRYPT_OK;
+
+error:
+   ltc_mp_fixed_base_free(&comb[0]);
+   XFREE(comb);
+   if (prep->mp != NULL) {
+      mp_montgomery_free(prep->mp);
+      prep->mp = NULL;
+   }
+   return err;
+}
+
+/**
+  Free a prepared DSA key, the key it refers to is left untouched
+  @param prep   The prepared key to free
+*/
+void dsa_prepared_free(dsa_prepared_key *prep)
+{
+   ltc_mp_comb *comb;
+
+   LTC_ARGCHKVD(prep != NULL);
+
+   if ((comb = prep->tables) != NULL) {
+      ltc_mp_fixed_base_free(&comb[0]);
+      ltc_mp_fixed_base_free(&comb[1]);
+      XFREE(comb);
+   }
+   if (prep->mp != NULL) {
+      mp_montgomery_free(prep->mp);
+   }
+   XMEMSET(prep, 0, sizeof(*prep));
+}
+
+#endif
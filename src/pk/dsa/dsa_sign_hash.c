@@ -18,14 +18,17 @@
   @param prng     An active PRNG state
   @param wprng    The index of the PRNG desired
   @param key      A private DSA key
+  @param prep     The prepared key or NULL
   @return CRYPT_OK if successful
 */
-int dsa_sign_hash_raw(const unsigned char *in,  unsigned long inlen,
-                                   void   *r,   void *s,
-                               prng_state *prng, int wprng, const dsa_key *key)
+int dsa_int_sign_hash_raw(const unsigned char *in,  unsigned long inlen,
+                                       void   *r,   void *s,
+                                   prng_state *prng, int wprng, const dsa_key *key,
+                       const dsa_prepared_key *prep)
 {
    void         *k, *kinv, *tmp;
    unsigned char *buf;
+   unsigned long  buflen;
    int            err, qbits;
 
    LTC_ARGCHK(in  != NULL);
@@ -71,7 +74,17 @@ retry:
    if ((err = mp_invmod(k, key->q, kinv)) != CRYPT_OK)                                 { goto error; }
 
    /* now find r = g^k mod p mod q */
-   if ((err = mp_exptmod(key->g, k, key->p, r)) != CRYPT_OK)                           { goto error; }
+   if (prep != NULL) {
+      /* the table of g is built for secret exponents, it's read as a whole for every column */
+      buflen = mp_unsigned_bin_size(k);
+      if ((err = mp_to_unsigned_bin(k, buf)) != CRYPT_OK)                              { goto error; }
+      err = ltc_mp_fixed_base_exptmod(prep->tables, (const unsigned char * const *)&buf, &buflen, 1,
+                                      key->p, prep->mp, r, 1);
+      zeromem(buf, buflen);
+      if (err != CRYPT_OK)                                                             { goto error; }
+   } else {
+      if ((err = mp_exptmod(key->g, k, key->p, r)) != CRYPT_OK)                        { goto error; }
+   }
    if ((err = mp_mod(r, key->q, r)) != CRYPT_OK)                                       { goto error; }
 
    if (mp_iszero(r) == LTC_MP_YES)                                                     { goto retry; }
@@ -102,16 +115,24 @@ ERRBUF:
   Sign a hash with DSA
   @param in       The hash to sign
   @param inlen    The length of the hash to sign
-  @param out      [out] Where to store the signature
-  @param outlen   [in/out] The max size and resulting size of the signature
+  @param r        The "r" integer of the signature (caller must initialize with mp_init() first)
+  @param s        The "s" integer of the signature (caller must initialize with mp_init() first)
   @param prng     An active PRNG state
   @param wprng    The index of the PRNG desired
   @param key      A private DSA key
   @return CRYPT_OK if successful
 */
-int dsa_sign_hash(const unsigned char *in,  unsigned long inlen,
-                        unsigned char *out, unsigned long *outlen,
-                        prng_state *prng, int wprng, const dsa_key *key)
+int dsa_sign_hash_raw(const unsigned char *in,  unsigned long inlen,
+                                   void   *r,   void *s,
+                               prng_state *prng, int wprng, const dsa_key *key)
+{
+   return dsa_int_sign_hash_raw(in, inlen, r, s, prng, wprng, key, NULL);
+}
+
+static int s_dsa_sign_hash(const unsigned char *in,  unsigned long inlen,
+                                 unsigned char *out, unsigned long *outlen,
+                                 prng_state *prng, int wprng, const dsa_key *key,
+                           const dsa_prepared_key *prep)
 {
    void         *r, *s;
    int           err;
@@ -125,7 +146,7 @@ int dsa_sign_hash(const unsigned char *in,  unsigned long inlen,
       return CRYPT_MEM;
    }
 
-   if ((err = dsa_sign_hash_raw(in, inlen, r, s, prng, wprng, key)) != CRYPT_OK) {
+   if ((err = dsa_int_sign_hash_raw(in, inlen, r, s, prng, wprng, key, prep)) != CRYPT_OK) {
       goto error;
    }
 
@@ -139,4 +160,43 @@ error:
    return err;
 }
 
+/**
+  Sign a hash with DSA
+  @param in       The hash to sign
+  @param inlen    The length of the hash to sign
+  @param out      [out] Where to store the signature
+  @param outlen   [in/out] The max size and resulting size of the signature
+  @param prng     An active PRNG state
+  @param wprng    The index of the PRNG desired
+  @param key      A private DSA key
+  @return CRYPT_OK if successful
+*/
+int dsa_sign_hash(const unsigned char *in,  unsigned long inlen,
+                        unsigned char *out, unsigned long *outlen,
+                        prng_state *prng, int wprng, const dsa_key *key)
+{
+   return s_dsa_sign_hash(in, inlen, out, outlen, prng, wprng, key, NULL);
+}
+
+/**
+  Sign a hash with DSA using the precomputed tables of the key
+  @param in       The hash to sign
+  @param inlen    The length of the hash to sign
+  @param out      [out] Where to store the signature
+  @param outlen   [in/out] The max size and resulting size of the signature
+  @param prng     An active PRNG state
+  @param wprng    The index of the PRNG desired
+  @param prep     A prepared private DSA key
+  @return CRYPT_OK if successful
+*/
+int dsa_sign_hash_prepared(const unsigned char *in,  unsigned long inlen,
+                                 unsigned char *out, unsigned long *outlen,
+                                 prng_state *prng, int wprng, const dsa_prepared_key *prep)
+{
+   LTC_ARGCHK(prep         != NULL);
+   LTC_ARGCHK(prep->tables != NULL);
+
+   return s_dsa_sign_hash(in, inlen, out, outlen, prng, wprng, prep->key, prep);
+}
+
 #endif
@@ -10,6 +10,56 @@
 
 #ifdef LTC_MDSA
 
+/* check a signature once w = 1/s mod q is known, u1, u2 and v are scratch variables */
+static int s_dsa_verify_w(                void *r,                void *w,
+                          const unsigned char *hash,      unsigned long hashlen,
+                                          int *stat,      const dsa_key *key,
+                       const dsa_prepared_key *prep,
+                                         void *u1, void *u2, void *v)
+{
+   unsigned char  buf[2][LTC_MDSA_MAX_GROUP];
+   const unsigned char *e[2];
+   unsigned long  elen[2];
+   int           err;
+
+   /* FIPS 186-4 4.7: use leftmost min(bitlen(q), bitlen(hash)) bits of 'hash' */
+   hashlen = MIN(hashlen, (unsigned long)(key->qord));
+
+   /* u1 = m * w mod q */
+   if ((err = mp_read_unsigned_bin(u1, hash, hashlen)) != CRYPT_OK)                       { return err; }
+   if ((err = mp_mulmod(u1, w, key->q, u1)) != CRYPT_OK)                                  { return err; }
+
+   /* u2 = r*w mod q */
+   if ((err = mp_mulmod(r, w, key->q, u2)) != CRYPT_OK)                                   { return err; }
+
+   /* v = g^u1 * y^u2 mod p mod q */
+   if (prep != NULL) {
+      /* both exponentiations at once, sharing the squarings, all exponents are public */
+      elen[0] = mp_unsigned_bin_size(u1);
+      elen[1] = mp_unsigned_bin_size(u2);
+      if (elen[0] > sizeof(buf[0]) || elen[1] > sizeof(buf[1])) {
+         return CRYPT_INVALID_ARG;
+      }
+      if ((err = mp_to_unsigned_bin(u1, buf[0])) != CRYPT_OK)                             { return err; }
+      if ((err = mp_to_unsigned_bin(u2, buf[1])) != CRYPT_OK)                             { return err; }
+      e[0] = buf[0];
+      e[1] = buf[1];
+      if ((err = ltc_mp_fixed_base_exptmod(prep->tables, e, elen, 2, key->p, prep->mp, v, 0)) != CRYPT_OK) { return err; }
+   } else {
+      if ((err = mp_exptmod(key->g, u1, key->p, u1)) != CRYPT_OK)                         { return err; }
+      if ((err = mp_exptmod(key->y, u2, key->p, u2)) != CRYPT_OK)                         { return err; }
+      if ((err = mp_mulmod(u1, u2, key->p, v)) != CRYPT_OK)                               { return err; }
+   }
+   if ((err = mp_mod(v, key->q, v)) != CRYPT_OK)                                          { return err; }
+
+   /* if r = v then we're set */
+   if (mp_cmp(r, v) == LTC_MP_EQ) {
+      *stat = 1;
+   }
+
+   return CRYPT_OK;
+}
+
 /**
   Verify a DSA signature
   @param r        DSA "r" parameter
@@ -18,11 +68,13 @@
   @param hashlen  The length of the hash that was signed
   @param stat     [out] The result of the signature verification, 1==valid, 0==invalid
   @param key      The corresponding public DSA key
+  @param prep     The prepared key or NULL
   @return CRYPT_OK if successful (even if the signature is invalid)
 */
-int dsa_verify_hash_raw(         void   *r,          void   *s,
-                    const unsigned char *hash, unsigned long hashlen,
-                                    int *stat, const dsa_key *key)
+int dsa_int_verify_hash_raw(         void   *r,          void   *s,
+                        const unsigned char *hash, unsigned long hashlen,
+                                        int *stat, const dsa_key *key,
+                     const dsa_prepared_key *prep)
 {
    void          *w, *v, *u1, *u2;
    int           err;
@@ -46,34 +98,58 @@ int dsa_verify_hash_raw(         void   *r,          void   *s,
       goto error;
    }
 
-   /* FIPS 186-4 4.7: use leftmost min(bitlen(q), bitlen(hash)) bits of 'hash' */
-   hashlen = MIN(hashlen, (unsigned long)(key->qord));
-
    /* w = 1/s mod q */
    if ((err = mp_invmod(s, key->q, w)) != CRYPT_OK)                                       { goto error; }
 
-   /* u1 = m * w mod q */
-   if ((err = mp_read_unsigned_bin(u1, hash, hashlen)) != CRYPT_OK)                       { goto error; }
-   if ((err = mp_mulmod(u1, w, key->q, u1)) != CRYPT_OK)                                  { goto error; }
+   err = s_dsa_verify_w(r, w, hash, hashlen, stat, key, prep, u1, u2, v);
 
-   /* u2 = r*w mod q */
-   if ((err = mp_mulmod(r, w, key->q, u2)) != CRYPT_OK)                                   { goto error; }
+error:
+   mp_clear_multi(w, v, u1, u2, LTC_NULL);
+   return err;
+}
 
-   /* v = g^u1 * y^u2 mod p mod q */
-   if ((err = mp_exptmod(key->g, u1, key->p, u1)) != CRYPT_OK)                            { goto error; }
-   if ((err = mp_exptmod(key->y, u2, key->p, u2)) != CRYPT_OK)                            { goto error; }
-   if ((err = mp_mulmod(u1, u2, key->p, v)) != CRYPT_OK)                                  { goto error; }
-   if ((err = mp_mod(v, key->q, v)) != CRYPT_OK)                                          { goto error; }
+/**
+  Verify a DSA signature
+  @param r        DSA "r" parameter
+  @param s        DSA "s" parameter
+  @param hash     The hash that was signed
+  @param hashlen  The length of the hash that was signed
+  @param stat     [out] The result of the signature verification, 1==valid, 0==invalid
+  @param key      The corresponding public DSA key
+  @return CRYPT_OK if successful (even if the signature is invalid)
+*/
+int dsa_verify_hash_raw(         void   *r,          void   *s,
+                    const unsigned char *hash, unsigned long hashlen,
+                                    int *stat, const dsa_key *key)
+{
+   return dsa_int_verify_hash_raw(r, s, hash, hashlen, stat, key, NULL);
+}
 
-   /* if r = v then we're set */
-   if (mp_cmp(r, v) == LTC_MP_EQ) {
-      *stat = 1;
+static int s_dsa_verify_hash(const unsigned char *sig,        unsigned long  siglen,
+                             const unsigned char *hash,       unsigned long  hashlen,
+                                   int           *stat, const dsa_key       *key,
+                             const dsa_prepared_key *prep,
+                                   void          *r,          void          *s)
+{
+   int    err;
+   ltc_asn1_list sig_seq[2];
+   unsigned long reallen = 0;
+
+   LTC_SET_ASN1(sig_seq, 0, LTC_ASN1_INTEGER, r, 1UL);
+   LTC_SET_ASN1(sig_seq, 1, LTC_ASN1_INTEGER, s, 1UL);
+
+   err = der_decode_sequence_strict(sig, siglen, sig_seq, 2);
+   if (err != CRYPT_OK) {
+      return err;
    }
 
-   err = CRYPT_OK;
-error:
-   mp_clear_multi(w, v, u1, u2, LTC_NULL);
-   return err;
+   err = der_length_sequence(sig_seq, 2, &reallen);
+   if (err != CRYPT_OK || reallen != siglen) {
+      return err;
+   }
+
+   /* do the op */
+   return dsa_int_verify_hash_raw(r, s, hash, hashlen, stat, key, prep);
 }
 
 /**
@@ -92,8 +168,6 @@ int dsa_verify_hash(const unsigned char *sig,        unsigned long  siglen,
 {
    int    err;
    void   *r, *s;
-   ltc_asn1_list sig_seq[2];
-   unsigned long reallen = 0;
 
    LTC_ARGCHK(stat != NULL);
    *stat = 0; /* must be set before the first return */
@@ -102,24 +176,171 @@ int dsa_verify_hash(const unsigned char *sig,        unsigned long  siglen,
       return err;
    }
 
-   LTC_SET_ASN1(sig_seq, 0, LTC_ASN1_INTEGER, r, 1UL);
-   LTC_SET_ASN1(sig_seq, 1, LTC_ASN1_INTEGER, s, 1UL);
+   err = s_dsa_verify_hash(sig, siglen, hash, hashlen, stat, key, NULL, r, s);
 
-   err = der_decode_sequence_strict(sig, siglen, sig_seq, 2);
-   if (err != CRYPT_OK) {
-      goto LBL_ERR;
+   mp_clear_multi(r, s, LTC_NULL);
+   return err;
+}
+
+/**
+  Verify a DSA signature using the precomputed tables of the key
+  @param sig      The signature
+  @param siglen   The length of the signature (octets)
+  @param hash     The hash that was signed
+  @param hashlen  The length of the hash that was signed
+  @param stat     [out] The result of the signature verification, 1==valid, 0==invalid
+  @param prep     The corresponding prepared DSA key
+  @return CRYPT_OK if successful (even if the signature is invalid)
+*/
+int dsa_verify_hash_prepared(const unsigned char *sig,        unsigned long  siglen,
+                             const unsigned char *hash,       unsigned long  hashlen,
+                                   int           *stat, const dsa_prepared_key *prep)
+{
+   int    err;
+   void   *r, *s;
+
+   LTC_ARGCHK(stat         != NULL);
+   *stat = 0; /* must be set before the first return */
+   LTC_ARGCHK(prep         != NULL);
+   LTC_ARGCHK(prep->tables != NULL);
+
+   if ((err = mp_init_multi(&r, &s, LTC_NULL)) != CRYPT_OK) {
+      return err;
    }
 
-   err = der_length_sequence(sig_seq, 2, &reallen);
-   if (err != CRYPT_OK || reallen != siglen) {
-      goto LBL_ERR;
+   err = s_dsa_verify_hash(sig, siglen, hash, hashlen, stat, prep->key, prep, r, s);
+
+   mp_clear_multi(r, s, LTC_NULL);
+   return err;
+}
+
+/**
+  Verify a batch of DSA signatures made with the same key
+
+  All signatures are decoded first, so that a single inversion mod q covers the whole batch.
+  Malformed signatures are reported as invalid via their stat entry, they don't stop the batch.
+  @param sig      The signatures
+  @param siglen   The lengths of the signatures (octets)
+  @param hash     The hashes that were signed
+  @param hashlen  The lengths of the hashes that were signed
+  @param n        The number of signatures
+  @param stat     [out] The results of the signature verifications, 1==valid, 0==invalid
+  @param prep     The corresponding prepared DSA key
+  @return CRYPT_OK if successful (even if signatures are invalid)
+*/
+int dsa_verify_hash_batch(const unsigned char * const *sig,  const unsigned long *siglen,
+                          const unsigned char * const *hash, const unsigned long *hashlen,
+                                unsigned long          n,
+                                int                   *stat,
+                          const dsa_prepared_key      *prep)
+{
+   int            err;
+   void         **r, **s, **c, *w, *t, *v, *u1, *u2;
+   const dsa_key *key;
+   ltc_asn1_list  sig_seq[2];
+   unsigned long  x, reallen;
+
+   LTC_ARGCHK(stat         != NULL);
+   for (x = 0; x < n; x++) {
+      stat[x] = 0;
+   }
+   LTC_ARGCHK(sig          != NULL);
+   LTC_ARGCHK(siglen       != NULL);
+   LTC_ARGCHK(hash         != NULL);
+   LTC_ARGCHK(hashlen      != NULL);
+   LTC_ARGCHK(prep         != NULL);
+   LTC_ARGCHK(prep->tables != NULL);
+   for (x = 0; x < n; x++) {
+      LTC_ARGCHK(sig[x]  != NULL);
+      LTC_ARGCHK(hash[x] != NULL);
    }
 
-   /* do the op */
-   err = dsa_verify_hash_raw(r, s, hash, hashlen, stat, key);
+   if (n == 0) {
+      return CRYPT_OK;
+   }
+   key = prep->key;
+
+   /* r, s and the running products c of the s, n of each */
+   r = XCALLOC(3 * n, sizeof(void *));
+   if (r == NULL) {
+      return CRYPT_MEM;
+   }
+   s = r + n;
+   c = s + n;
+
+   if ((err = mp_init_multi(&w, &t, &v, &u1, &u2, LTC_NULL)) != CRYPT_OK) {
+      goto LBL_FREE;
+   }
+   for (x = 0; x < 3 * n; x++) {
+      if ((err = mp_init(&r[x])) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+   }
+
+   for (x = 0; x < n; x++) {
+      LTC_SET_ASN1(sig_seq, 0, LTC_ASN1_INTEGER, r[x], 1UL);
+      LTC_SET_ASN1(sig_seq, 1, LTC_ASN1_INTEGER, s[x], 1UL);
+      reallen = 0;
+      err = der_decode_sequence_strict(sig[x], siglen[x], sig_seq, 2);
+      if (err == CRYPT_OK) {
+         err = der_length_sequence(sig_seq, 2, &reallen);
+      }
+      if (err == CRYPT_MEM) {
+         goto LBL_ERR;
+      }
+      /* a malformed signature gets s = 0, it is skipped and stays invalid */
+      if (err != CRYPT_OK || reallen != siglen[x] ||
+          mp_cmp_d(r[x], 0) != LTC_MP_GT || mp_cmp_d(s[x], 0) != LTC_MP_GT ||
+          mp_cmp(r[x], key->q) != LTC_MP_LT || mp_cmp(s[x], key->q) != LTC_MP_LT) {
+         if ((err = mp_set(s[x], 0)) != CRYPT_OK)                                          { goto LBL_ERR; }
+      }
+
+      /* c[x] = the product of all valid s[0..x] mod q */
+      if (x == 0) {
+         err = (mp_iszero(s[0]) == LTC_MP_YES) ? mp_set(c[0], 1) : mp_copy(s[0], c[0]);
+      } else if (mp_iszero(s[x]) == LTC_MP_YES) {
+         err = mp_copy(c[x - 1], c[x]);
+      } else {
+         err = mp_mulmod(c[x - 1], s[x], key->q, c[x]);
+      }
+      if (err != CRYPT_OK)                                                                 { goto LBL_ERR; }
+   }
+
+   /* w = 1/c[n - 1], then every step back peels off one s, c.f. Montgomery's trick */
+   if ((err = mp_invmod(c[n - 1], key->q, w)) != CRYPT_OK)                                 { goto LBL_ERR; }
+   for (x = n; x-- > 0; ) {
+      if (mp_iszero(s[x]) == LTC_MP_YES) {
+         continue;
+      }
+      /* t = 1/s[x] and w = 1/c[x - 1] */
+      if (x == 0) {
+         err = mp_copy(w, t);
+      } else {
+         err = mp_mulmod(w, c[x - 1], key->q, t);
+      }
+      if (err != CRYPT_OK)                                                                 { goto LBL_ERR; }
+      if ((err = mp_mulmod(w, s[x], key->q, w)) != CRYPT_OK)                               { goto LBL_ERR; }
+
+      if ((err = s_dsa_verify_w(r[x], t, hash[x], hashlen[x], &stat[x], key, prep, u1, u2, v)) != CRYPT_OK) {
+         goto LBL_ERR;
+      }
+   }
+   err = CRYPT_OK;
 
 LBL_ERR:
-   mp_clear_multi(r, s, LTC_NULL);
+   if (err != CRYPT_OK) {
+      for (x = 0; x < n; x++) {
+         stat[x] = 0;
+      }
+   }
+   for (x = 0; x < 3 * n; x++) {
+      if (r[x] != NULL) {
+         mp_clear(r[x]);
+      }
+   }
+   mp_clear_multi(w, t, v, u1, u2, LTC_NULL);
+LBL_FREE:
+   XFREE(r);
    return err;
 }
 
@@ -10,6 +10,59 @@
 
 #ifdef LTC_MRSA
 
+/* x = x^e mod N for a public exponent of up to 32 bits, by left-to-right square and multiply in montgomery form */
+static int s_rsa_public_small_e(void *x, const rsa_key *key, void *mp)
+{
+   void          *a, *r;
+   unsigned long  e;
+   int            i, err;
+
+   e = mp_get_int(key->e);
+
+   if ((err = mp_init_multi(&a, &r, LTC_NULL)) != CRYPT_OK) {
+      return err;
+   }
+   if ((err = mp_montgomery_normalization(a, key->N)) != CRYPT_OK)                      { goto error; }
+   if ((err = mp_mulmod(x, a, key->N, a)) != CRYPT_OK)                                  { goto error; }
+   if ((err = mp_copy(a, r)) != CRYPT_OK)                                               { goto error; }
+   for (i = mp_count_bits(key->e) - 2; i >= 0; i--) {
+      if ((err = mp_sqr(r, r)) != CRYPT_OK)                                             { goto error; }
+      if ((err = mp_montgomery_reduce(r, key->N, mp)) != CRYPT_OK)                      { goto error; }
+      if ((e >> i) & 1) {
+         if ((err = mp_mul(r, a, r)) != CRYPT_OK)                                       { goto error; }
+         if ((err = mp_montgomery_reduce(r, key->N, mp)) != CRYPT_OK)                   { goto error; }
+      }
+   }
+   if ((err = mp_montgomery_reduce(r, key->N, mp)) != CRYPT_OK)                         { goto error; }
+   err = mp_copy(r, x);
+
+error:
+   mp_clear_multi(a, r, LTC_NULL);
+   return err;
+}
+
+/* x = x^e mod N, with the montgomery context of N if given */
+static int s_rsa_public(void *x, const rsa_key *key, void *mp)
+{
+   int err;
+
+   /* the fast path needs a native montgomery reduction, with an emulated one the exptmod of the provider is faster,
+      an odd modulus and an exponent which fits into a digit of mp_get_int() */
+   if (!ltc_mp.montgomery_native ||
+       mp_count_bits(key->e) > 32 || mp_count_bits(key->e) < 2 || mp_isodd(key->N) != LTC_MP_YES) {
+      return mp_exptmod(x, key->e, key->N, x);
+   }
+   if (mp != NULL) {
+      return s_rsa_public_small_e(x, key, mp);
+   }
+   if ((err = mp_montgomery_setup(key->N, &mp)) != CRYPT_OK) {
+      return err;
+   }
+   err = s_rsa_public_small_e(x, key, mp);
+   mp_montgomery_free(mp);
+   return err;
+}
+
 /**
    Compute an RSA modular exponentiation
    @param in         The input data to send into RSA
@@ -23,6 +76,24 @@
 int rsa_exptmod(const unsigned char *in,   unsigned long inlen,
                       unsigned char *out,  unsigned long *outlen, int which,
                 const rsa_key *key)
+{
+   return rsa_int_exptmod(in, inlen, out, outlen, which, key, NULL);
+}
+
+/**
+   Compute an RSA modular exponentiation
+   @param in         The input data to send into RSA
+   @param inlen      The length of the input (octets)
+   @param out        [out] The destination
+   @param outlen     [in/out] The max size and resulting size of the output
+   @param which      Which exponent to use, e.g. PK_PRIVATE or PK_PUBLIC
+   @param key        The RSA key to use
+   @param mp         The "b" value from montgomery_setup() of N, or NULL
+   @return CRYPT_OK if successful
+*/
+int rsa_int_exptmod(const unsigned char *in,   unsigned long inlen,
+                          unsigned char *out,  unsigned long *outlen, int which,
+                    const rsa_key *key, void *mp)
 {
    void        *tmp, *tmpa, *tmpb;
    #ifdef LTC_RSA_BLINDING
@@ -102,13 +173,13 @@ int rsa_exptmod(const unsigned char *in,   unsigned long inlen,
           * In case CRT optimization parameters are not provided,
           * the private key is directly used to exptmod it
           */
-         if ((err = mp_exptmod(tmp, key->d, key->N, tmp)) != CRYPT_OK)                              { goto error; }
+         if ((err = mp_exptmod_secret(tmp, key->d, key->N, tmp)) != CRYPT_OK)                       { goto error; }
       } else {
          /* tmpa = tmp^dP mod p */
-         if ((err = mp_exptmod(tmp, key->dP, key->p, tmpa)) != CRYPT_OK)                            { goto error; }
+         if ((err = mp_exptmod_secret(tmp, key->dP, key->p, tmpa)) != CRYPT_OK)                     { goto error; }
 
          /* tmpb = tmp^dQ mod q */
-         if ((err = mp_exptmod(tmp, key->dQ, key->q, tmpb)) != CRYPT_OK)                            { goto error; }
+         if ((err = mp_exptmod_secret(tmp, key->dQ, key->q, tmpb)) != CRYPT_OK)                     { goto error; }
 
          /* tmp = (tmpa - tmpb) * qInv (mod p) */
          if ((err = mp_sub(tmpa, tmpb, tmp)) != CRYPT_OK)                                           { goto error; }
@@ -129,14 +200,15 @@ int rsa_exptmod(const unsigned char *in,   unsigned long inlen,
 
       #ifdef LTC_RSA_CRT_HARDENING
       if (has_crt_parameters) {
-         if ((err = mp_exptmod(tmp, key->e, key->N, tmpa)) != CRYPT_OK)                              { goto error; }
+         if ((err = mp_copy(tmp, tmpa)) != CRYPT_OK)                                                 { goto error; }
+         if ((err = s_rsa_public(tmpa, key, mp)) != CRYPT_OK)                                        { goto error; }
          if ((err = mp_read_unsigned_bin(tmpb, in, (int)inlen)) != CRYPT_OK)                         { goto error; }
          if (mp_cmp(tmpa, tmpb) != LTC_MP_EQ)                                     { err = CRYPT_ERROR; goto error; }
       }
       #endif
    } else {
       /* exptmod it */
-      if ((err = mp_exptmod(tmp, key->e, key->N, tmp)) != CRYPT_OK)                                { goto error; }
+      if ((err = s_rsa_public(tmp, key, mp)) != CRYPT_OK)                                         { goto error; }
    }
 
    /* read it back */
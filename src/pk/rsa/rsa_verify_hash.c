@@ -9,36 +9,10 @@
 
 #ifdef LTC_MRSA
 
-/**
-  PKCS #1 de-sign then v1.5 or PSS depad
-  @param sig              The signature data
-  @param siglen           The length of the signature data (octets)
-  @param hash             The hash of the message that was signed
-  @param hashlen          The length of the hash of the message that was signed (octets)
-  @param padding          Type of padding (LTC_PKCS_1_PSS, LTC_PKCS_1_V1_5 or LTC_PKCS_1_V1_5_NA1)
-  @param hash_idx         The index of the desired hash
-  @param saltlen          The length of the salt used during signature
-  @param stat             [out] The result of the signature comparison, 1==valid, 0==invalid
-  @param key              The public RSA key corresponding to the key that performed the signature
-  @return CRYPT_OK on success (even if the signature is invalid)
-*/
-int rsa_verify_hash_ex(const unsigned char *sig,            unsigned long  siglen,
-                       const unsigned char *hash,           unsigned long  hashlen,
-                             int            padding,
-                             int            hash_idx,       unsigned long  saltlen,
-                             int           *stat,     const rsa_key       *key)
+/* check the arguments common to all signatures of a key, returns the modulus length in octets via len */
+static int s_rsa_verify_check(int padding, int hash_idx, const rsa_key *key, unsigned long *len)
 {
-  unsigned long modulus_bitlen, modulus_bytelen, x;
-  int           err;
-  unsigned char *tmpbuf;
-
-  LTC_ARGCHK(hash  != NULL);
-  LTC_ARGCHK(sig   != NULL);
-  LTC_ARGCHK(stat  != NULL);
-  LTC_ARGCHK(key   != NULL);
-
-  /* default to invalid */
-  *stat = 0;
+  int err;
 
   /* valid padding? */
 
@@ -55,31 +29,46 @@ int rsa_verify_hash_ex(const unsigned char *sig,            unsigned long  sigle
     }
   }
 
-  /* get modulus len in bits */
-  modulus_bitlen = mp_count_bits( (key->N));
-
-  /* outlen must be at least the size of the modulus */
-  modulus_bytelen = mp_unsigned_bin_size( (key->N));
-  if (modulus_bytelen != siglen) {
-     return CRYPT_INVALID_PACKET;
+  /* not all hashes have OIDs... so sad */
+  if (padding == LTC_PKCS_1_V1_5 && hash_descriptor[hash_idx].OIDlen == 0) {
+     return CRYPT_INVALID_ARG;
   }
 
-  /* allocate temp buffer for decoded sig */
-  tmpbuf = XMALLOC(siglen);
-  if (tmpbuf == NULL) {
-     return CRYPT_MEM;
-  }
+  *len = mp_unsigned_bin_size( (key->N));
+  return CRYPT_OK;
+}
+
+/*
+  de-sign and depad one signature, tmpbuf and out must provide room for the modulus length each
+  and mp is the montgomery context of N or NULL
+*/
+static int s_rsa_verify_hash(const unsigned char *sig,            unsigned long  siglen,
+                             const unsigned char *hash,           unsigned long  hashlen,
+                                   int            padding,
+                                   int            hash_idx,       unsigned long  saltlen,
+                                   int           *stat,     const rsa_key       *key,
+                                   unsigned char *tmpbuf,         unsigned char *out,
+                                   void          *mp)
+{
+  unsigned long modulus_bitlen, x;
+  int           err;
+
+  /* get modulus len in bits */
+  modulus_bitlen = mp_count_bits( (key->N));
 
   /* RSA decode it  */
   x = siglen;
-  if ((err = ltc_mp.rsa_me(sig, siglen, tmpbuf, &x, PK_PUBLIC, key)) != CRYPT_OK) {
-     XFREE(tmpbuf);
+  if (ltc_mp.rsa_me == rsa_exptmod) {
+     err = rsa_int_exptmod(sig, siglen, tmpbuf, &x, PK_PUBLIC, key, mp);
+  } else {
+     err = ltc_mp.rsa_me(sig, siglen, tmpbuf, &x, PK_PUBLIC, key);
+  }
+  if (err != CRYPT_OK) {
      return err;
   }
 
   /* make sure the output is the right size */
   if (x != siglen) {
-     XFREE(tmpbuf);
      return CRYPT_INVALID_PACKET;
   }
 
@@ -95,33 +84,19 @@ int rsa_verify_hash_ex(const unsigned char *sig,            unsigned long  sigle
 
   } else {
     /* PKCS #1 v1.5 decode it */
-    unsigned char *out;
     unsigned long outlen;
     int           decoded;
 
-    /* allocate temp buffer for decoded hash */
     outlen = ((modulus_bitlen >> 3) + (modulus_bitlen & 7 ? 1 : 0)) - 3;
-    out    = XMALLOC(outlen);
-    if (out == NULL) {
-      err = CRYPT_MEM;
-      goto bail_2;
-    }
 
     if ((err = pkcs_1_v1_5_decode(tmpbuf, x, LTC_PKCS_1_EMSA, modulus_bitlen, out, &outlen, &decoded)) != CRYPT_OK) {
-      XFREE(out);
-      goto bail_2;
+      return err;
     }
 
     if (padding == LTC_PKCS_1_V1_5) {
       unsigned long loid[16], reallen;
       ltc_asn1_list digestinfo[2], siginfo[2];
 
-      /* not all hashes have OIDs... so sad */
-      if (hash_descriptor[hash_idx].OIDlen == 0) {
-         err = CRYPT_INVALID_ARG;
-         goto bail_2;
-      }
-
       /* now we must decode out[0...outlen-1] using ASN.1, test the OID and then test the hash */
       /* construct the SEQUENCE
         SEQUENCE {
@@ -140,14 +115,12 @@ int rsa_verify_hash_ex(const unsigned char *sig,            unsigned long  sigle
          /* fallback to Legacy:missing NULL */
          LTC_SET_ASN1(siginfo, 0, LTC_ASN1_SEQUENCE,          digestinfo,                    1);
          if ((err = der_decode_sequence_strict(out, outlen, siginfo, 2)) != CRYPT_OK) {
-           XFREE(out);
-           goto bail_2;
+           return err;
          }
       }
 
       if ((err = der_length_sequence(siginfo, 2, &reallen)) != CRYPT_OK) {
-         XFREE(out);
-         goto bail_2;
+         return err;
       }
 
       /* test OID */
@@ -165,16 +138,160 @@ int rsa_verify_hash_ex(const unsigned char *sig,            unsigned long  sigle
         *stat = 1;
       }
     }
+  }
+
+  return err;
+}
+
+/**
+  PKCS #1 de-sign then v1.5 or PSS depad
+  @param sig              The signature data
+  @param siglen           The length of the signature data (octets)
+  @param hash             The hash of the message that was signed
+  @param hashlen          The length of the hash of the message that was signed (octets)
+  @param padding          Type of padding (LTC_PKCS_1_PSS, LTC_PKCS_1_V1_5 or LTC_PKCS_1_V1_5_NA1)
+  @param hash_idx         The index of the desired hash
+  @param saltlen          The length of the salt used during signature
+  @param stat             [out] The result of the signature comparison, 1==valid, 0==invalid
+  @param key              The public RSA key corresponding to the key that performed the signature
+  @return CRYPT_OK on success (even if the signature is invalid)
+*/
+int rsa_verify_hash_ex(const unsigned char *sig,            unsigned long  siglen,
+                       const unsigned char *hash,           unsigned long  hashlen,
+                             int            padding,
+                             int            hash_idx,       unsigned long  saltlen,
+                             int           *stat,     const rsa_key       *key)
+{
+  unsigned long modulus_bytelen;
+  int           err;
+  unsigned char *tmpbuf;
+
+  LTC_ARGCHK(hash  != NULL);
+  LTC_ARGCHK(sig   != NULL);
+  LTC_ARGCHK(stat  != NULL);
+  LTC_ARGCHK(key   != NULL);
+
+  /* default to invalid */
+  *stat = 0;
+
+  if ((err = s_rsa_verify_check(padding, hash_idx, key, &modulus_bytelen)) != CRYPT_OK) {
+     return err;
+  }
+
+  /* outlen must be at least the size of the modulus */
+  if (modulus_bytelen != siglen) {
+     return CRYPT_INVALID_PACKET;
+  }
+
+  /* allocate temp buffers for the decoded sig and hash */
+  tmpbuf = XMALLOC(2 * siglen);
+  if (tmpbuf == NULL) {
+     return CRYPT_MEM;
+  }
+
+  err = s_rsa_verify_hash(sig, siglen, hash, hashlen, padding, hash_idx, saltlen, stat, key,
+                          tmpbuf, tmpbuf + siglen, NULL);
 
 #ifdef LTC_CLEAN_STACK
-    zeromem(out, outlen);
+  zeromem(tmpbuf, 2 * siglen);
 #endif
-    XFREE(out);
+  XFREE(tmpbuf);
+  return err;
+}
+
+/* the errors a malformed signature causes while it's decoded, as opposed to errors of the key, the arguments or the math provider */
+static int s_rsa_verify_is_malformed(int err)
+{
+  return err == CRYPT_INVALID_PACKET ||
+         err == CRYPT_PK_INVALID_SIZE ||
+         err == CRYPT_PK_ASN1_ERROR ||
+         err == CRYPT_INPUT_TOO_LONG ||
+         err == CRYPT_BUFFER_OVERFLOW; /* an OID with more arcs than the decoder takes */
+}
+
+/**
+  Verify a batch of PKCS #1 signatures made with the same key
+
+  The buffers and, if the math provider has a native montgomery reduction, the montgomery context
+  of the modulus are set up once for the whole batch.
+  Signatures which fail to decode are reported as invalid via their stat entry, they don't stop the batch.
+  Any other error is returned and leaves all stat entries at 0.
+  @param sig              The signatures
+  @param siglen           The lengths of the signatures (octets)
+  @param hash             The hashes of the messages that were signed
+  @param hashlen          The lengths of the hashes (octets)
+  @param n                The number of signatures
+  @param padding          Type of padding (LTC_PKCS_1_PSS, LTC_PKCS_1_V1_5 or LTC_PKCS_1_V1_5_NA1)
+  @param hash_idx         The index of the desired hash
+  @param saltlen          The length of the salt used during signature
+  @param stat             [out] The results of the signature comparisons, 1==valid, 0==invalid
+  @param key              The public RSA key corresponding to the key that performed the signatures
+  @return CRYPT_OK on success (even if signatures are invalid)
+*/
+int rsa_verify_hash_batch(const unsigned char * const *sig,  const unsigned long *siglen,
+                          const unsigned char * const *hash, const unsigned long *hashlen,
+                                unsigned long          n,
+                                int                    padding,
+                                int                    hash_idx,   unsigned long  saltlen,
+                                int                   *stat, const rsa_key       *key)
+{
+  unsigned long modulus_bytelen, i;
+  int           err;
+  unsigned char *tmpbuf;
+  void          *mp = NULL;
+
+  LTC_ARGCHK(stat  != NULL);
+  for (i = 0; i < n; i++) {
+     stat[i] = 0;
+  }
+  LTC_ARGCHK(sig     != NULL);
+  LTC_ARGCHK(siglen  != NULL);
+  LTC_ARGCHK(hash    != NULL);
+  LTC_ARGCHK(hashlen != NULL);
+  LTC_ARGCHK(key     != NULL);
+  /* check all entries before anything is allocated */
+  for (i = 0; i < n; i++) {
+     LTC_ARGCHK(sig[i]  != NULL);
+     LTC_ARGCHK(hash[i] != NULL);
+  }
+
+  if ((err = s_rsa_verify_check(padding, hash_idx, key, &modulus_bytelen)) != CRYPT_OK) {
+     return err;
+  }
+
+  tmpbuf = XMALLOC(2 * modulus_bytelen);
+  if (tmpbuf == NULL) {
+     return CRYPT_MEM;
+  }
+  if (ltc_mp.montgomery_native && mp_isodd(key->N) == LTC_MP_YES) {
+     if ((err = mp_montgomery_setup(key->N, &mp)) != CRYPT_OK) {
+        goto LBL_ERR;
+     }
   }
 
-bail_2:
+  for (i = 0; i < n; i++) {
+     if (siglen[i] != modulus_bytelen) {
+        continue;
+     }
+     err = s_rsa_verify_hash(sig[i], siglen[i], hash[i], hashlen[i], padding, hash_idx, saltlen, &stat[i], key,
+                             tmpbuf, tmpbuf + modulus_bytelen, mp);
+     if (err != CRYPT_OK && !s_rsa_verify_is_malformed(err)) {
+        break;
+     }
+     err = CRYPT_OK;
+  }
+
+  if (mp != NULL) {
+     mp_montgomery_free(mp);
+  }
+LBL_ERR:
+  if (err != CRYPT_OK) {
+     for (i = 0; i < n; i++) {
+        stat[i] = 0;
+     }
+  }
 #ifdef LTC_CLEAN_STACK
-  zeromem(tmpbuf, siglen);
+  zeromem(tmpbuf, 2 * modulus_bytelen);
 #endif
   XFREE(tmpbuf);
   return err;
@@ -17,11 +17,12 @@
     x[d] ^= (ROL((x[c] + x[b]), 13)); \
     x[a] ^= (ROL((x[d] + x[c]), 18));
 
-static void s_salsa20_block(unsigned char *output, const ulong32 *input, int rounds)
+/* the Salsa20 core function, out = x + in after `rounds` rounds on x = in, out may equal in */
+void salsa20_core(ulong32 *out, const ulong32 *in, int rounds)
 {
    ulong32 x[16];
    int i;
-   XMEMCPY(x, input, sizeof(x));
+   XMEMCPY(x, in, sizeof(x));
    for (i = rounds; i > 0; i -= 2) {
       QUARTERROUND( 0, 4, 8,12)
       QUARTERROUND( 5, 9,13, 1)
@@ -33,7 +34,16 @@ static void s_salsa20_block(unsigned char *output, const ulong32 *input, int rou
       QUARTERROUND(15,12,13,14)
    }
    for (i = 0; i < 16; ++i) {
-     x[i] += input[i];
+     out[i] = x[i] + in[i];
+   }
+}
+
+static void s_salsa20_block(unsigned char *output, const ulong32 *input, int rounds)
+{
+   ulong32 x[16];
+   int i;
+   salsa20_core(x, input, rounds);
+   for (i = 0; i < 16; ++i) {
      STORE32L(x[i], output + 4 * i);
    }
 }
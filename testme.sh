@@ -65,3 +65,10 @@ bash .ci/run.sh "NO_TIMING_RESISTANCE" "-DLTC_NO_ECC_TIMING_RESISTANT -DLTC_NO_R
 
 # CLEANSTACK+NOTABLES+SMALL+NO_ASM+NO_TIMING_RESISTANCE
 bash .ci/run.sh "CLEANSTACK+NOTABLES+SMALL+NO_ASM+NO_TIMING_RESISTANCE" "-DLTC_CLEAN_STACK -DLTC_NO_TABLES -DLTC_SMALL_CODE -DLTC_NO_ECC_TIMING_RESISTANT -DLTC_NO_RSA_BLINDING" "$mk" "$2" "$3" || exit 1
+
+# GCM_TABLES_SSE2, the aligned loads of the GCM and GCM-SIV tables only exist on x86
+case "$(uname -m)" in
+   x86_64|i?86)
+      bash .ci/run.sh "GCM_TABLES_SSE2" "-DLTC_GCM_TABLES_SSE2" "$mk" "$2" "$3" || exit 1
+      ;;
+esac
@@ -0,0 +1,85 @@
+/* LibTomCrypt, modular cryptographic library -- Tom St Denis */
+/* SPDX-License-Identifier: Unlicense */
+
+#include  <tomcrypt_test.h>
+
+#ifdef LTC_ARGON2
+
+/* the test vectors of RFC 9106, Section 5 */
+static const struct {
+   argon2_type type;
+   const char *name;
+   unsigned char tag[32];
+} s_argon2_tests[] = {
+   { LTC_ARGON2_D, "Argon2d",
+     { 0x51, 0x2b, 0x39, 0x1b, 0x6f, 0x11, 0x62, 0x97, 0x53, 0x71, 0xd3, 0x09, 0x19, 0x73, 0x42, 0x94,
+       0xf8, 0x68, 0xe3, 0xbe, 0x39, 0x84, 0xf3, 0xc1, 0xa1, 0x3a, 0x4d, 0xb9, 0xfa, 0xbe, 0x4a, 0xcb } },
+   { LTC_ARGON2_I, "Argon2i",
+     { 0xc8, 0x14, 0xd9, 0xd1, 0xdc, 0x7f, 0x37, 0xaa, 0x13, 0xf0, 0xd7, 0x7f, 0x24, 0x94, 0xbd, 0xa1,
+       0xc8, 0xde, 0x6b, 0x01, 0x6d, 0xd3, 0x88, 0xd2, 0x99, 0x52, 0xa4, 0xc4, 0x67, 0x2b, 0x6c, 0xe8 } },
+   { LTC_ARGON2_ID, "Argon2id",
+     { 0x0d, 0x64, 0x0d, 0xf5, 0x8d, 0x78, 0x76, 0x6c, 0x08, 0xc0, 0x37, 0xa3, 0x4a, 0x8b, 0x53, 0xc9,
+       0xd0, 0x1e, 0xf0, 0x45, 0x2d, 0x75, 0xb6, 0x5e, 0xb5, 0x25, 0x20, 0xe9, 0x6b, 0x01, 0xe6, 0x59 } },
+};
+
+int argon2_test(void)
+{
+   unsigned char password[32], salt[16], secret[8], ad[12], tag[32], tag2[100];
+   argon2_arena arena;
+   unsigned long n;
+
+   XMEMSET(password, 0x01, sizeof(password));
+   XMEMSET(salt, 0x02, sizeof(salt));
+   XMEMSET(secret, 0x03, sizeof(secret));
+   XMEMSET(ad, 0x04, sizeof(ad));
+
+   DO(argon2_arena_init(&arena));
+   for (n = 0; n < sizeof(s_argon2_tests) / sizeof(s_argon2_tests[0]); ++n) {
+      /* once with a temporary memory, once with the arena */
+      DO(argon2_hash(s_argon2_tests[n].type, 3, 32, 4, password, sizeof(password), salt, sizeof(salt),
+                     secret, sizeof(secret), ad, sizeof(ad), NULL, tag, sizeof(tag)));
+      COMPARE_TESTVECTOR(tag, sizeof(tag), s_argon2_tests[n].tag, sizeof(s_argon2_tests[n].tag), s_argon2_tests[n].name, 0);
+      DO(argon2_hash(s_argon2_tests[n].type, 3, 32, 4, password, sizeof(password), salt, sizeof(salt),
+                     secret, sizeof(secret), ad, sizeof(ad), &arena, tag, sizeof(tag)));
+      COMPARE_TESTVECTOR(tag, sizeof(tag), s_argon2_tests[n].tag, sizeof(s_argon2_tests[n].tag), s_argon2_tests[n].name, 1);
+   }
+
+   /* a larger arena is reused for a smaller memory size, and tags longer than 64 octets */
+   DO(argon2_hash(LTC_ARGON2_ID, 1, 64, 1, password, sizeof(password), salt, sizeof(salt),
+                  NULL, 0, NULL, 0, &arena, tag2, sizeof(tag2)));
+   DO(argon2_hash(LTC_ARGON2_ID, 1, 64, 1, password, sizeof(password), salt, sizeof(salt),
+                  NULL, 0, NULL, 0, NULL, tag, sizeof(tag)));
+   ENSURE(XMEMCMP(tag, tag2, sizeof(tag)) != 0);
+   DO(argon2_hash(LTC_ARGON2_ID, 3, 32, 4, password, sizeof(password), salt, sizeof(salt),
+                  secret, sizeof(secret), ad, sizeof(ad), &arena, tag, sizeof(tag)));
+   COMPARE_TESTVECTOR(tag, sizeof(tag), s_argon2_tests[2].tag, sizeof(s_argon2_tests[2].tag), "Argon2id reuse", 0);
+   argon2_arena_free(&arena);
+
+   /* invalid parameters */
+   SHOULD_FAIL(argon2_hash(LTC_ARGON2_ID, 0, 32, 4, password, sizeof(password), salt, sizeof(salt),
+                           NULL, 0, NULL, 0, NULL, tag, sizeof(tag)));
+   SHOULD_FAIL(argon2_hash(LTC_ARGON2_ID, 1, 31, 4, password, sizeof(password), salt, sizeof(salt),
+                           NULL, 0, NULL, 0, NULL, tag, sizeof(tag)));
+   SHOULD_FAIL(argon2_hash(LTC_ARGON2_ID, 1, 32, 4, password, sizeof(password), salt, 7,
+                           NULL, 0, NULL, 0, NULL, tag, sizeof(tag)));
+   SHOULD_FAIL(argon2_hash(LTC_ARGON2_ID, 1, 32, 4, password, sizeof(password), salt, sizeof(salt),
+                           NULL, 0, NULL, 0, NULL, tag, 3));
+   if (sizeof(unsigned long) > 4) {
+      /* the costs are encoded with 32 bits, larger values must not be truncated */
+      SHOULD_FAIL(argon2_hash(LTC_ARGON2_ID, (unsigned long)-1, 32, 4, password, sizeof(password), salt, sizeof(salt),
+                              NULL, 0, NULL, 0, NULL, tag, sizeof(tag)));
+      SHOULD_FAIL(argon2_hash(LTC_ARGON2_ID, 1, (unsigned long)-1, 4, password, sizeof(password), salt, sizeof(salt),
+                              NULL, 0, NULL, 0, NULL, tag, sizeof(tag)));
+   }
+
+   return CRYPT_OK;
+}
+
+#else
+
+int argon2_test(void)
+{
+   return CRYPT_NOP;
+}
+
+#endif
@@ -94,6 +94,71 @@ struct test tests[] = {
    },
 };
 
+/* "$2a$" vectors from the test suite of crypt_blowfish by Solar Designer */
+static const struct {
+   const char *password;
+   const char *hash;
+} s_2b_tests[] = {
+   { "U*U", "$2a$05$CCCCCCCCCCCCCCCCCCCCC.E5YPO9kmyuRGyh0XouQYb4YMJKvyOeW" },
+   { "U*U*", "$2a$05$CCCCCCCCCCCCCCCCCCCCC.VGOzA784oUp/Z0DY336zx7pLYAy0lwK" },
+   { "U*U*U", "$2a$05$XXXXXXXXXXXXXXXXXXXXXOAcXxm9kjPGEMsLznoKqmqw7tc8WCx4a" },
+   { "", "$2a$05$CCCCCCCCCCCCCCCCCCCCC.7uG0VCzI2bS7j6ymqJi9CdcdxiRTWNy" },
+   { "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789chars after 72 are ignored",
+     "$2a$05$abcdefghijklmnopqrstuu5s2v8.iXieOjg/.AySBTTZIIVFJeBui" },
+};
+
+static int s_bcrypt_2b_test(void)
+{
+   unsigned char salt[16];
+   char out[61], tmp[61];
+   unsigned long l, n;
+   int stat;
+
+   for (n = 0; n < sizeof(s_2b_tests) / sizeof(s_2b_tests[0]); ++n) {
+      l = XSTRLEN(s_2b_tests[n].password);
+      DO(bcrypt_verify(s_2b_tests[n].password, l, s_2b_tests[n].hash, &stat));
+      ENSURE(stat == 1);
+      /* only the first 72 octets of the password count */
+      if (l > 0 && l <= 72) {
+         DO(bcrypt_verify(s_2b_tests[n].password, l - 1, s_2b_tests[n].hash, &stat));
+         ENSURE(stat == 0);
+      }
+      /* "$2b$" only differs in the identifier */
+      XMEMCPY(tmp, s_2b_tests[n].hash, sizeof(tmp));
+      tmp[2] = 'b';
+      DO(bcrypt_verify(s_2b_tests[n].password, l, tmp, &stat));
+      ENSURE(stat == 1);
+   }
+
+   /* hash and verify a fresh password */
+   XMEMSET(salt, 0xA5, sizeof(salt));
+   l = sizeof(out);
+   DO(bcrypt_hash("password", 8, salt, 4, out, &l));
+   ENSURE(l == 60);
+   ENSURE(XSTRLEN(out) == 60);
+   ENSURE(XMEMCMP(out, "$2b$04$", 7) == 0);
+   DO(bcrypt_verify("password", 8, out, &stat));
+   ENSURE(stat == 1);
+   DO(bcrypt_verify("Password", 8, out, &stat));
+   ENSURE(stat == 0);
+
+   /* too small output buffers and invalid hash strings */
+   l = 60;
+   SHOULD_FAIL(bcrypt_hash("password", 8, salt, 4, out, &l));
+   ENSURE(l == 61);
+   l = sizeof(out);
+   SHOULD_FAIL(bcrypt_hash("password", 8, salt, 3, out, &l));
+   XMEMCPY(tmp, out, sizeof(tmp));
+   tmp[2] = 'x';
+   SHOULD_FAIL(bcrypt_verify("password", 8, tmp, &stat));
+   XMEMCPY(tmp, out, sizeof(tmp));
+   tmp[10] = '!';
+   SHOULD_FAIL(bcrypt_verify("password", 8, tmp, &stat));
+   SHOULD_FAIL(bcrypt_verify("password", 8, "$2b$04$", &stat));
+
+   return CRYPT_OK;
+}
+
 int bcrypt_test(void)
 {
    unsigned long l;
@@ -132,6 +197,8 @@ int bcrypt_test(void)
 #endif
    }
 
+   DO(s_bcrypt_2b_test());
+
    return CRYPT_OK;
 }
 
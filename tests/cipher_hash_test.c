@@ -4,6 +4,37 @@
 
 #include <tomcrypt_test.h>
 
+/* the multi-block entry points of a cipher have to match its single block functions */
+static int s_accel_ecb_test(int x)
+{
+   unsigned char key[MAXBLOCKSIZE], pt[5 * MAXBLOCKSIZE], ct[5 * MAXBLOCKSIZE], tmp[5 * MAXBLOCKSIZE];
+   unsigned long n, bl;
+   symmetric_key skey;
+
+   bl = (unsigned long)cipher_descriptor[x].block_length;
+   for (n = 0; n < sizeof(key); n++) {
+      key[n] = (unsigned char)(n * 5 + 3);
+   }
+   for (n = 0; n < 5 * bl; n++) {
+      pt[n] = (unsigned char)(n * 11);
+   }
+   DO(cipher_descriptor[x].setup(key, cipher_descriptor[x].min_key_length, 0, &skey));
+   for (n = 0; n < 5; n++) {
+      DO(cipher_descriptor[x].ecb_encrypt(pt + n * bl, ct + n * bl, &skey));
+   }
+   /* the hooks are optional on their own, e.g. an encrypt-only one for the CTR based modes */
+   if (cipher_descriptor[x].accel_ecb_encrypt != NULL) {
+      DO(cipher_descriptor[x].accel_ecb_encrypt(pt, tmp, 5, &skey));
+      COMPARE_TESTVECTOR(tmp, 5 * bl, ct, 5 * bl, cipher_descriptor[x].name, 0);
+   }
+   if (cipher_descriptor[x].accel_ecb_decrypt != NULL) {
+      DO(cipher_descriptor[x].accel_ecb_decrypt(ct, tmp, 5, &skey));
+      COMPARE_TESTVECTOR(tmp, 5 * bl, pt, 5 * bl, cipher_descriptor[x].name, 1);
+   }
+   cipher_descriptor[x].done(&skey);
+   return CRYPT_OK;
+}
+
 int cipher_hash_test(void)
 {
    int           x;
@@ -11,6 +42,9 @@ int cipher_hash_test(void)
    /* test block ciphers */
    for (x = 0; cipher_descriptor[x].name != NULL; x++) {
       DOX(cipher_descriptor[x].test(), cipher_descriptor[x].name);
+      if (cipher_descriptor[x].accel_ecb_encrypt != NULL || cipher_descriptor[x].accel_ecb_decrypt != NULL) {
+         DOX(s_accel_ecb_test(x), cipher_descriptor[x].name);
+      }
    }
 
    /* explicit AES-NI test */
@@ -20,6 +54,9 @@ int cipher_hash_test(void)
    }
    DO(rijndael_test());
 #endif
+#if defined(LTC_AES_CT)
+   DO(aes_ct_test());
+#endif
 #if defined(LTC_RIJNDAEL)
 #ifndef ENCRYPT_ONLY
    DO(aes_test());
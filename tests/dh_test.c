@@ -383,6 +383,66 @@ static int s_basic_test(void)
    return CRYPT_OK;
 }
 
+#ifdef LTC_DH_FIXED_BASE
+static int s_fixed_base_test(void)
+{
+   unsigned char p[1024], g[] = { 5 };
+   unsigned long plen, x;
+   void          *y, *e, *z;
+   dh_key        key, key2;
+
+   DO(mp_init(&y));
+   for (x = 0; ltc_dh_sets[x].size != 0; x++) {
+      /* tfm has a problem with larger sizes */
+      if ((strcmp(ltc_mp.name, "TomsFastMath") == 0) && (ltc_dh_sets[x].size > 256)) break;
+
+      /* built-in group, uses the comb table */
+      DO(dh_set_pg_groupsize(ltc_dh_sets[x].size, &key));
+      DO(dh_generate_key(&yarrow_prng, find_prng("yarrow"), &key));
+      DO(mp_exptmod(key.base, key.x, key.prime, y));
+      ENSURE(mp_cmp(key.y, y) == LTC_MP_EQ);
+
+      /* same prime but another generator, must not use the table */
+      plen = mp_unsigned_bin_size(key.prime);
+      DO(mp_to_unsigned_bin(key.prime, p));
+      dh_free(&key);
+      DO(dh_set_pg(p, plen, g, sizeof(g), &key));
+      DO(dh_generate_key(&yarrow_prng, find_prng("yarrow"), &key));
+      DO(mp_exptmod(key.base, key.x, key.prime, y));
+      ENSURE(mp_cmp(key.y, y) == LTC_MP_EQ);
+      dh_free(&key);
+   }
+
+   /* a longer exponent than the table was built for has to rebuild it instead of falling back */
+   dh_fixed_base_free();
+   DO(mp_init_multi(&e, &z, LTC_NULL));
+   DO(dh_set_pg_groupsize(ltc_dh_sets[0].size, &key));
+   for (x = 0; x < sizeof(p); x++) {
+      p[x] = (unsigned char)(x * 13 + 1);
+   }
+   DO(dh_fixed_base_exptmod(&key, p, 16, y));
+   plen = (unsigned long)ltc_dh_sets[0].size - 1;
+
+   /* a custom group of the same size is turned away before it gets to the table */
+   DO(mp_to_unsigned_bin(key.prime, p + 512));
+   DO(dh_set_pg(p + 512, (unsigned long)ltc_dh_sets[0].size, g, sizeof(g), &key2));
+   ENSURE(dh_fixed_base_exptmod(&key2, p, plen, y) == CRYPT_NOP);
+   dh_free(&key2);
+
+   DO(dh_fixed_base_exptmod(&key, p, plen, y));
+   DO(mp_read_unsigned_bin(e, p, plen));
+   DO(mp_exptmod(key.base, e, key.prime, z));
+   ENSURE(mp_cmp(y, z) == LTC_MP_EQ);
+   dh_free(&key);
+   mp_clear_multi(e, z, LTC_NULL);
+
+   mp_clear(y);
+   dh_fixed_base_free();
+
+   return CRYPT_OK;
+}
+#endif
+
 int dh_test(void)
 {
    int fails = 0;
@@ -393,6 +453,9 @@ int dh_test(void)
    if (s_basic_test() != CRYPT_OK) fails++;
    if (s_dhparam_test() != CRYPT_OK) fails++;
    if (s_set_test() != CRYPT_OK) fails++;
+#ifdef LTC_DH_FIXED_BASE
+   if (s_fixed_base_test() != CRYPT_OK) fails++;
+#endif
    return fails > 0 ? CRYPT_FAIL_TESTVECTOR : CRYPT_OK;
 }
 
@@ -313,6 +313,70 @@ static int s_dsa_wycheproof_test(void)
    return CRYPT_OK;
 }
 
+static int s_dsa_prepared_test(void)
+{
+   unsigned char msg[4][20], sig[4][128], bad[128];
+   const unsigned char *sigs[5], *hashes[5];
+   unsigned long siglen[5], hashlen[5], x;
+   int stat[5];
+   dsa_key key;
+   dsa_prepared_key prep;
+
+   DO(dsa_generate_pqg(&yarrow_prng, find_prng("yarrow"), 20, 128, &key));
+   DO(dsa_generate_key(&yarrow_prng, find_prng("yarrow"), &key));
+   DO(dsa_prepare_key(&key, &prep));
+   /* the table of g is used with the secret nonce and has to take the constant time path, y is public */
+   ENSURE(((ltc_mp_comb *)prep.tables)[0].packed != NULL);
+   ENSURE(((ltc_mp_comb *)prep.tables)[1].packed == NULL);
+
+   for (x = 0; x < 4; x++) {
+      XMEMSET(msg[x], (int)x, sizeof(msg[x]));
+      siglen[x] = sizeof(sig[x]);
+      if (x & 1) {
+         DO(dsa_sign_hash_prepared(msg[x], sizeof(msg[x]), sig[x], &siglen[x], &yarrow_prng, find_prng("yarrow"), &prep));
+      } else {
+         DO(dsa_sign_hash(msg[x], sizeof(msg[x]), sig[x], &siglen[x], &yarrow_prng, find_prng("yarrow"), &key));
+      }
+      /* both kinds of signatures must be accepted by both verifiers */
+      DO(dsa_verify_hash(sig[x], siglen[x], msg[x], sizeof(msg[x]), &stat[0], &key));
+      ENSURE(stat[0] == 1);
+      DO(dsa_verify_hash_prepared(sig[x], siglen[x], msg[x], sizeof(msg[x]), &stat[0], &prep));
+      ENSURE(stat[0] == 1);
+      sigs[x] = sig[x];
+      hashes[x] = msg[x];
+      hashlen[x] = sizeof(msg[x]);
+   }
+
+   /* a signature of another message and a malformed one */
+   hashes[3] = msg[2];
+   XMEMCPY(bad, sig[0], siglen[0]);
+   bad[0] ^= 0xff;
+   sigs[4] = bad;
+   siglen[4] = siglen[0];
+   hashes[4] = msg[0];
+   hashlen[4] = sizeof(msg[0]);
+
+   DO(dsa_verify_hash_batch(sigs, siglen, hashes, hashlen, 5, stat, &prep));
+   ENSURE(stat[0] == 1 && stat[1] == 1 && stat[2] == 1);
+   ENSURE(stat[3] == 0 && stat[4] == 0);
+
+   /* a malformed signature in front of a valid one, and one on its own */
+   sigs[3] = sigs[1];
+   siglen[3] = siglen[1];
+   hashes[3] = hashes[1];
+   DO(dsa_verify_hash_batch(sigs + 4, siglen + 4, hashes + 4, hashlen + 4, 1, stat, &prep));
+   ENSURE(stat[0] == 0);
+   sigs[2] = bad;
+   siglen[2] = siglen[4];
+   hashes[2] = hashes[4];
+   DO(dsa_verify_hash_batch(sigs + 2, siglen + 2, hashes + 2, hashlen + 2, 2, stat, &prep));
+   ENSURE(stat[0] == 0 && stat[1] == 1);
+
+   dsa_prepared_free(&prep);
+   dsa_free(&key);
+   return CRYPT_OK;
+}
+
 int dsa_test(void)
 {
    unsigned char msg[16], out[1024], out2[1024], ch;
@@ -324,6 +388,7 @@ int dsa_test(void)
 
    DO(s_dsa_compat_test());
    DO(s_dsa_wycheproof_test());
+   DO(s_dsa_prepared_test());
 
    /* make a random key */
    DO(dsa_generate_pqg(&yarrow_prng, find_prng("yarrow"), 20, 128, &key));
@@ -35,6 +35,25 @@ int file_test(void)
    DO(err);
    DO(do_compare_testvector(buf, len, exp_sha256, 32, "hash_filehandle", 1));
 
+   /* a file handle is hashed from the current position on */
+   {
+      unsigned char data[1024], exp[32];
+      unsigned long datalen;
+      if ((in = fopen(fname, "rb")) == NULL)                                    return CRYPT_FILE_NOTFOUND;
+      datalen = (unsigned long)fread(data, 1, sizeof(data), in);
+      if (datalen < 100 || fseek(in, 100, SEEK_SET) != 0) {
+         fclose(in);
+         return CRYPT_ERROR;
+      }
+      len = sizeof(buf);
+      err = hash_filehandle(isha256, in, buf, &len);
+      fclose(in);
+      DO(err);
+      len = sizeof(exp);
+      DO(hash_memory(isha256, data + 100, datalen - 100, exp, &len));
+      DO(do_compare_testvector(buf, len, exp, 32, "hash_filehandle at an offset", 1));
+   }
+
    len = sizeof(buf);
    DO(hash_file(isha256, fname, buf, &len));
    DO(do_compare_testvector(buf, len, exp_sha256, 32, "hash_file", 1));
@@ -88,6 +107,14 @@ int file_test(void)
       DO(do_compare_testvector(buf, len, exp_poly1305, 16, "poly1305_file", 1));
    }
 #endif
+#ifdef LTC_GMAC
+   {
+      unsigned char exp_gmacaes[16]    = { 0xAA, 0x52, 0xD7, 0xDF, 0xE4, 0x26, 0xC5, 0x9B, 0x52, 0x04, 0xAE, 0x12, 0x60, 0x2E, 0xD5, 0x42 };
+      len = sizeof(buf);
+      DO(gmac_file(iaes, key, 32, key, 12, fname, buf, &len));
+      DO(do_compare_testvector(buf, len, exp_gmacaes, 16, "gmac_file", 1));
+   }
+#endif
 #ifdef LTC_BLAKE2SMAC
    {
       unsigned char exp_blake2smac[16]   = { 0x4f, 0x94, 0x45, 0x15, 0xcd, 0xd1, 0xca, 0x02, 0x1a, 0x0c, 0x7a, 0xe4, 0x6d, 0x2f, 0xe8, 0xb3 };
@@ -104,6 +131,42 @@ int file_test(void)
       DO(do_compare_testvector(buf, len, exp_blake2bmac, 16, "exp_blake2bmac_file", 1));
    }
 #endif
+#if defined(LTC_DIGEST_FANOUT) && defined(LTC_HMAC) && defined(LTC_OMAC)
+   {
+      /* one pass over the file has to give the results of the single-purpose helpers */
+      unsigned char ref[3][32];
+      unsigned long reflen[3];
+      hash_state md;
+      hmac_state hmac;
+      omac_state omac;
+      digest_sink sinks[3];
+
+      reflen[0] = reflen[1] = reflen[2] = 32;
+      DO(hash_file(isha256, fname, ref[0], &reflen[0]));
+      DO(hmac_file(isha256, fname, key, 32, ref[1], &reflen[1]));
+      DO(omac_file(iaes, key, 32, fname, ref[2], &reflen[2]));
+
+      sinks[0].type = LTC_SINK_HASH;
+      sinks[0].hash = isha256;
+      sinks[0].state = &md;
+      sinks[1].type = LTC_SINK_HMAC;
+      sinks[1].state = &hmac;
+      sinks[2].type = LTC_SINK_OMAC;
+      sinks[2].state = &omac;
+      DO(hash_descriptor[isha256].init(&md));
+      DO(hmac_init(&hmac, isha256, key, 32));
+      DO(omac_init(&omac, iaes, key, 32));
+      DO(digest_fanout_file(sinks, 3, fname));
+      DO(hash_descriptor[isha256].done(&md, buf));
+      DO(do_compare_testvector(buf, 32, ref[0], reflen[0], "digest_fanout_file sha256", 1));
+      len = sizeof(buf);
+      DO(hmac_done(&hmac, buf, &len));
+      DO(do_compare_testvector(buf, len, ref[1], reflen[1], "digest_fanout_file hmac", 1));
+      len = sizeof(buf);
+      DO(omac_done(&omac, buf, &len));
+      DO(do_compare_testvector(buf, len, ref[2], reflen[2], "digest_fanout_file omac", 1));
+   }
+#endif
 
    return CRYPT_OK;
 #endif
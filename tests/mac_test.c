@@ -3,6 +3,211 @@
 /* test pmac/omac/hmac */
 #include <tomcrypt_test.h>
 
+#if defined(LTC_PMAC) && defined(LTC_RIJNDAEL)
+/* whole runs of blocks must give the same MAC as feeding the data one octet at a time */
+static int s_pmac_batch_test(void)
+{
+   unsigned char key[16], msg[613], tag[16], tag2[16];
+   unsigned long taglen, n, x;
+   pmac_state pmac;
+   int cipher;
+
+   cipher = find_cipher("aes");
+   for (x = 0; x < sizeof(key); x++) key[x] = (unsigned char)x;
+   for (x = 0; x < sizeof(msg); x++) msg[x] = (unsigned char)(x * 7);
+
+   for (n = 0; n < sizeof(msg); n += 61) {
+      DO(pmac_init(&pmac, cipher, key, sizeof(key)));
+      for (x = 0; x < n; x++) {
+         DO(pmac_process(&pmac, msg + x, 1));
+      }
+      taglen = sizeof(tag);
+      DO(pmac_done(&pmac, tag, &taglen));
+
+      /* the data in two parts, the first one not block aligned */
+      DO(pmac_init(&pmac, cipher, key, sizeof(key)));
+      DO(pmac_process(&pmac, msg, n / 3));
+      DO(pmac_process(&pmac, msg + n / 3, n - n / 3));
+      taglen = sizeof(tag2);
+      DO(pmac_done(&pmac, tag2, &taglen));
+      COMPARE_TESTVECTOR(tag2, taglen, tag, sizeof(tag), "PMAC batch", n);
+   }
+   return CRYPT_OK;
+}
+#endif
+
+#if defined(LTC_OCB3_MODE) && defined(LTC_RIJNDAEL)
+/* runs of many blocks must give the same result as processing one block at a time */
+static int s_ocb3_batch_test(void)
+{
+   unsigned char key[16], nonce[12], aad[301], pt[37 * 16 + 5], ct[sizeof(pt)], ct2[sizeof(pt)], tmp[sizeof(pt)];
+   unsigned char tag[16], tag2[16];
+   unsigned long taglen, x, full;
+   ocb3_state ocb;
+   int cipher, stat;
+
+   cipher = find_cipher("aes");
+   for (x = 0; x < sizeof(key); x++) key[x] = (unsigned char)(x + 1);
+   for (x = 0; x < sizeof(nonce); x++) nonce[x] = (unsigned char)(x * 3);
+   for (x = 0; x < sizeof(aad); x++) aad[x] = (unsigned char)(x * 5);
+   for (x = 0; x < sizeof(pt); x++) pt[x] = (unsigned char)(x * 11);
+   full = (sizeof(pt) / 16) * 16;
+
+   DO(ocb3_init(&ocb, cipher, key, sizeof(key), nonce, sizeof(nonce), 16));
+   for (x = 0; x < sizeof(aad); x++) {
+      DO(ocb3_add_aad(&ocb, aad + x, 1));
+   }
+   for (x = 0; x < full; x += 16) {
+      DO(ocb3_encrypt(&ocb, pt + x, 16, ct + x));
+   }
+   DO(ocb3_encrypt_last(&ocb, pt + full, sizeof(pt) - full, ct + full));
+   taglen = sizeof(tag);
+   DO(ocb3_done(&ocb, tag, &taglen));
+
+   taglen = sizeof(tag2);
+   DO(ocb3_encrypt_authenticate_memory(cipher, key, sizeof(key), nonce, sizeof(nonce), aad, sizeof(aad),
+                                       pt, sizeof(pt), ct2, tag2, &taglen));
+   COMPARE_TESTVECTOR(ct2, sizeof(ct2), ct, sizeof(ct), "OCB3 batch ct", 0);
+   COMPARE_TESTVECTOR(tag2, taglen, tag, sizeof(tag), "OCB3 batch tag", 0);
+
+   DO(ocb3_decrypt_verify_memory(cipher, key, sizeof(key), nonce, sizeof(nonce), aad, sizeof(aad),
+                                 ct, sizeof(ct), tmp, tag, sizeof(tag), &stat));
+   ENSURE(stat == 1);
+   COMPARE_TESTVECTOR(tmp, sizeof(tmp), pt, sizeof(pt), "OCB3 batch pt", 0);
+
+   /* in place */
+   XMEMCPY(tmp, ct, sizeof(ct));
+   DO(ocb3_init(&ocb, cipher, key, sizeof(key), nonce, sizeof(nonce), 16));
+   DO(ocb3_add_aad(&ocb, aad, sizeof(aad)));
+   DO(ocb3_decrypt(&ocb, tmp, full, tmp));
+   DO(ocb3_decrypt_last(&ocb, tmp + full, sizeof(tmp) - full, tmp + full));
+   taglen = sizeof(tag2);
+   DO(ocb3_done(&ocb, tag2, &taglen));
+   COMPARE_TESTVECTOR(tmp, sizeof(tmp), pt, sizeof(pt), "OCB3 batch pt", 1);
+   COMPARE_TESTVECTOR(tag2, taglen, tag, sizeof(tag), "OCB3 batch tag", 1);
+   return CRYPT_OK;
+}
+#endif
+
+#if (defined(LTC_OMAC) || defined(LTC_XCBC)) && defined(LTC_RIJNDAEL)
+static int s_cbc_mac_tag(int omac, int cipher, const unsigned char *key, const unsigned char *msg, unsigned long len,
+                         unsigned long chunk, unsigned char *tag)
+{
+   unsigned long x, n, taglen = 16;
+#ifdef LTC_OMAC
+   omac_state o;
+#endif
+#ifdef LTC_XCBC
+   xcbc_state xc;
+#endif
+
+#ifdef LTC_OMAC
+   if (omac) {
+      DO(omac_init(&o, cipher, key, 16));
+      for (x = 0; x < len; x += n) {
+         n = MIN(chunk, len - x);
+         DO(omac_process(&o, msg + x, n));
+      }
+      return omac_done(&o, tag, &taglen);
+   }
+#endif
+#ifdef LTC_XCBC
+   if (!omac) {
+      DO(xcbc_init(&xc, cipher, key, 16));
+      for (x = 0; x < len; x += n) {
+         n = MIN(chunk, len - x);
+         DO(xcbc_process(&xc, msg + x, n));
+      }
+      return xcbc_done(&xc, tag, &taglen);
+   }
+#endif
+   return CRYPT_NOP;
+}
+
+/* the CBC-MAC accelerator must match the plain chain, and the spans taken straight from the input the octet-wise processing */
+static int s_cbc_mac_accel_test(void)
+{
+   static const unsigned long chunks[] = { 1, 5, 16, 17, 48, 1000 };
+#ifdef LTC_OMAC
+   static const unsigned char cmac_key[16] = {
+      0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+   };
+   static const unsigned char cmac_msg[64] = {
+      0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+      0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+      0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+      0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10
+   };
+   static const unsigned char cmac_tag[2][16] = {
+      { 0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27 },
+      { 0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92, 0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe }
+   };
+#endif
+   int (*accel)(const unsigned char *in, unsigned long blocks, unsigned char *IV, const symmetric_key *skey);
+   unsigned char key[16], msg[200], tag[16], tag2[16], iv[16], iv2[16];
+   unsigned long x, len, c;
+   int cipher, omac, err;
+   symmetric_key skey;
+
+   cipher = find_cipher("aes");
+   for (x = 0; x < sizeof(key); x++) key[x] = (unsigned char)(x * 13);
+   for (x = 0; x < sizeof(msg); x++) msg[x] = (unsigned char)(x + 100);
+   accel = cipher_descriptor[cipher].accel_cbc_mac;
+
+#ifdef LTC_OMAC
+   /* RFC 4493 Example 3 and 4, so the accelerator isn't only compared with itself */
+   for (x = 0; x < 2; x++) {
+      for (c = 0; c < sizeof(chunks)/sizeof(chunks[0]); c++) {
+         DO(s_cbc_mac_tag(1, cipher, cmac_key, cmac_msg, x ? 64 : 40, chunks[c], tag));
+         COMPARE_TESTVECTOR(tag, 16, cmac_tag[x], 16, "CMAC accel KAT", x * 10 + c);
+      }
+   }
+#endif
+
+   /* the hook against a plain chain of ecb_encrypt() calls, without touching the shared descriptor table */
+   if (accel != NULL) {
+      DO(cipher_descriptor[cipher].setup(key, sizeof(key), 0, &skey));
+      for (len = 0; len <= sizeof(msg) / 16; len++) {
+         XMEMSET(iv, 0x5a, sizeof(iv));
+         XMEMSET(iv2, 0x5a, sizeof(iv2));
+         err = accel(msg, len, iv, &skey);
+         for (x = 0; err == CRYPT_OK && x < len * 16; x++) {
+            iv2[x % 16] ^= msg[x];
+            if (x % 16 == 15) {
+               err = cipher_descriptor[cipher].ecb_encrypt(iv2, iv2, &skey);
+            }
+         }
+         if (err != CRYPT_OK) {
+            cipher_descriptor[cipher].done(&skey);
+            return err;
+         }
+         if (compare_testvector(iv, 16, iv2, 16, "CBC-MAC accel", len)) {
+            cipher_descriptor[cipher].done(&skey);
+            return CRYPT_FAIL_TESTVECTOR;
+         }
+      }
+      cipher_descriptor[cipher].done(&skey);
+   }
+
+   for (omac = 0; omac < 2; omac++) {
+#ifndef LTC_OMAC
+      if (omac) continue;
+#endif
+#ifndef LTC_XCBC
+      if (!omac) continue;
+#endif
+      for (len = 0; len < sizeof(msg); len += 7) {
+         DO(s_cbc_mac_tag(omac, cipher, key, msg, len, 1, tag));
+         for (c = 0; c < sizeof(chunks)/sizeof(chunks[0]); c++) {
+            DO(s_cbc_mac_tag(omac, cipher, key, msg, len, chunks[c], tag2));
+            COMPARE_TESTVECTOR(tag2, 16, tag, 16, omac ? "OMAC accel" : "XCBC accel", len * 10 + c);
+         }
+      }
+   }
+   return CRYPT_OK;
+}
+#endif
+
 int mac_test(void)
 {
 #ifdef LTC_HMAC
@@ -11,12 +216,18 @@ int mac_test(void)
 #ifdef LTC_PMAC
    DO(pmac_test());
 #endif
+#if defined(LTC_PMAC) && defined(LTC_RIJNDAEL)
+   DO(s_pmac_batch_test());
+#endif
 #ifdef LTC_OMAC
    DO(omac_test());
 #endif
 #ifdef LTC_XCBC
    DO(xcbc_test());
 #endif
+#if (defined(LTC_OMAC) || defined(LTC_XCBC)) && defined(LTC_RIJNDAEL)
+   DO(s_cbc_mac_accel_test());
+#endif
 #ifdef LTC_F9_MODE
    DO(f9_test());
 #endif
@@ -29,12 +240,18 @@ int mac_test(void)
 #ifdef LTC_OCB3_MODE
    DO(ocb3_test());
 #endif
+#if defined(LTC_OCB3_MODE) && defined(LTC_RIJNDAEL)
+   DO(s_ocb3_batch_test());
+#endif
 #ifdef LTC_CCM_MODE
    DO(ccm_test());
 #endif
 #ifdef LTC_GCM_MODE
    DO(gcm_test());
 #endif
+#ifdef LTC_GMAC
+   DO(gmac_test());
+#endif
 #ifdef LTC_PELICAN
    DO(pelican_test());
 #endif
@@ -52,6 +269,9 @@ int mac_test(void)
 #endif
 #ifdef LTC_SIV_MODE
    DO(siv_test());
+#endif
+#ifdef LTC_GCM_SIV_MODE
+   DO(gcm_siv_test());
 #endif
    return 0;
 }
@@ -7,6 +7,12 @@ int misc_test(void)
 #ifdef LTC_BCRYPT
    DO(bcrypt_test());
 #endif
+#ifdef LTC_ARGON2
+   DO(argon2_test());
+#endif
+#ifdef LTC_SCRYPT
+   DO(scrypt_test());
+#endif
 #ifdef LTC_HKDF
    DO(hkdf_test());
 #endif
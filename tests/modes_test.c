@@ -25,6 +25,49 @@ static const struct {
 };
 #endif
 
+#if defined(LTC_CBC_MODE) || defined(LTC_CFB_MODE)
+/* more blocks than one batch, decrypted in place and in pieces that start in the middle of a batch */
+static int s_modes_batch_test(int cipher_idx)
+{
+   unsigned char pt[200], ct[200], tmp[200], key[16], iv[16];
+#ifdef LTC_CBC_MODE
+   symmetric_CBC cbc;
+#endif
+#ifdef LTC_CFB_MODE
+   symmetric_CFB cfb;
+#endif
+
+   ENSURE(yarrow_read(pt,  sizeof(pt), &yarrow_prng) == sizeof(pt));
+   ENSURE(yarrow_read(key, 16, &yarrow_prng) == 16);
+   ENSURE(yarrow_read(iv,  16, &yarrow_prng) == 16);
+
+#ifdef LTC_CBC_MODE
+   DO(cbc_start(cipher_idx, iv, key, 16, 0, &cbc));
+   DO(cbc_encrypt(pt, ct, 192, &cbc));
+   DO(cbc_setiv(iv, 16, &cbc));
+   XMEMCPY(tmp, ct, 192);
+   DO(cbc_decrypt(tmp, tmp, 16, &cbc));
+   DO(cbc_decrypt(tmp + 16, tmp + 16, 176, &cbc));
+   COMPARE_TESTVECTOR(tmp, 192, pt, 192, "cbc-batch-dec", 0);
+   DO(cbc_done(&cbc));
+#endif
+
+#ifdef LTC_CFB_MODE
+   DO(cfb_start(cipher_idx, iv, key, 16, 0, &cfb));
+   DO(cfb_encrypt(pt, ct, sizeof(pt), &cfb));
+   DO(cfb_setiv(iv, 16, &cfb));
+   XMEMCPY(tmp, ct, sizeof(ct));
+   DO(cfb_decrypt(tmp, tmp, 5, &cfb));
+   DO(cfb_decrypt(tmp + 5, tmp + 5, 27, &cfb));
+   DO(cfb_decrypt(tmp + 32, tmp + 32, sizeof(tmp) - 32, &cfb));
+   COMPARE_TESTVECTOR(tmp, sizeof(tmp), pt, sizeof(pt), "cfb-batch-dec", 0);
+   DO(cfb_done(&cfb));
+#endif
+
+   return CRYPT_OK;
+}
+#endif
+
 int modes_test(void)
 {
    int ret = CRYPT_NOP;
@@ -126,6 +169,10 @@ int modes_test(void)
    }
 #endif
 
+#if defined(LTC_CBC_MODE) || defined(LTC_CFB_MODE)
+   DO(ret = s_modes_batch_test(cipher_idx));
+#endif
+
 #ifdef LTC_OFB_MODE
    /* test OFB mode */
    /* encode the block */
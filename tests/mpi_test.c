@@ -131,9 +131,79 @@ static int s_radix_to_bin_test(void)
    return CRYPT_OK;
 }
 
+#if defined(LTC_MPI_SCRATCH)
+static int s_scratch_test(void)
+{
+   void *a, *b, *c;
+   const unsigned char buf[] = { 0xde, 0xad, 0xbe, 0xef, 0xfe, 0xed, 0xfa, 0xce, 0xca, 0xfe, 0xba, 0xbe };
+
+   ltc_mp_scratch_flush();
+
+   DO(mp_init(&a));
+   DO(mp_read_unsigned_bin(a, buf, sizeof(buf)));
+   mp_clear(a);
+
+   /* the released number must come back from the cache as zero */
+   DO(mp_init(&b));
+   ENSURE(b == a);
+   ENSURE(mp_iszero(b) == LTC_MP_YES);
+
+   DO(mp_read_unsigned_bin(b, buf, sizeof(buf)));
+   DO(mp_init_copy(&c, b));
+   mp_clear(b);
+
+   DO(mp_init_copy(&a, c));
+   ENSURE(a == b);
+   ENSURE(mp_cmp(a, c) == LTC_MP_EQ);
+   mp_clear_multi(a, c, LTC_NULL);
+
+   ltc_mp_scratch_flush();
+   return CRYPT_OK;
+}
+#endif
+
+#if defined(LTC_MPI_FIXED_WINDOW)
+static int s_fixed_window_test(void)
+{
+   void *g, *x, *p, *y1, *y2;
+   int i, bits[] = { 32, 127, 512, 1024, 1600 };
+
+   DO(mp_init_multi(&g, &x, &p, &y1, &y2, LTC_NULL));
+   for (i = 0; i < (int)(sizeof(bits)/sizeof(bits[0])); i++) {
+      /* odd moduli use the fixed window, the even ones fall back to mp_exptmod() */
+      DO(rand_bn_bits(p, bits[i], &yarrow_prng, find_prng("yarrow")));
+      DO(mp_2expt(y1, bits[i] - 1));
+      DO(mp_add(p, y1, p));
+      if ((i & 1) == 0 && mp_isodd(p) == LTC_MP_NO) {
+         DO(mp_add_d(p, 1, p));
+      }
+      DO(rand_bn_bits(g, bits[i] + 8, &yarrow_prng, find_prng("yarrow")));
+      DO(rand_bn_bits(x, bits[i], &yarrow_prng, find_prng("yarrow")));
+
+      DO(ltc_mp_fixed_window_exptmod(g, x, p, y1));
+      DO(mp_exptmod(g, x, p, y2));
+      ENSURE(mp_cmp(y1, y2) == LTC_MP_EQ);
+
+      /* short exponents, including single window ones */
+      DO(mp_set_int(x, 3));
+      DO(ltc_mp_fixed_window_exptmod(g, x, p, y1));
+      DO(mp_exptmod(g, x, p, y2));
+      ENSURE(mp_cmp(y1, y2) == LTC_MP_EQ);
+   }
+   mp_clear_multi(g, x, p, y1, y2, LTC_NULL);
+   return CRYPT_OK;
+}
+#endif
+
 int mpi_test(void)
 {
    if (ltc_mp.name == NULL) return CRYPT_NOP;
+#if defined(LTC_MPI_SCRATCH)
+   DO(s_scratch_test());
+#endif
+#if defined(LTC_MPI_FIXED_WINDOW)
+   DO(s_fixed_window_test());
+#endif
    return s_radix_to_bin_test();
 }
 #else
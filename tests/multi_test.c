@@ -232,5 +232,38 @@ int multi_test(void)
    }
 #endif
 
+#if defined(LTC_DIGEST_FANOUT) && defined(LTC_BLAKE2BMAC)
+   {
+      /* more than one chunk through two consumers */
+      static unsigned char msg[3 * LTC_DIGEST_FANOUT_CHUNK + 17];
+      hash_state md;
+      blake2bmac_state mac;
+      digest_sink sinks[2];
+
+      for (len = 0; len < sizeof(msg); len++) msg[len] = (unsigned char)len;
+      sinks[0].type = LTC_SINK_HASH;
+      sinks[0].hash = find_hash("sha256");
+      sinks[0].state = &md;
+      sinks[1].type = LTC_SINK_BLAKE2BMAC;
+      sinks[1].state = &mac;
+
+      DO(sha256_init(&md));
+      DO(blake2bmac_init(&mac, 32, key, 16));
+      DO(digest_fanout_memory(sinks, 2, msg, sizeof(msg)));
+      DO(sha256_done(&md, buf[0]));
+      len = 32;
+      DO(hash_memory(find_hash("sha256"), msg, sizeof(msg), buf[1], &len));
+      COMPARE_TESTVECTOR(buf[0], 32, buf[1], len, "digest_fanout_memory sha256", 0);
+      len = 32;
+      DO(blake2bmac_done(&mac, buf[0], &len));
+      len2 = 32;
+      DO(blake2bmac_memory(key, 16, msg, sizeof(msg), buf[1], &len2));
+      COMPARE_TESTVECTOR(buf[0], len, buf[1], len2, "digest_fanout_memory blake2bmac", 0);
+
+      sinks[0].hash = -1;
+      SHOULD_FAIL(digest_fanout_memory(sinks, 2, msg, sizeof(msg)));
+   }
+#endif
+
    return CRYPT_OK;
 }
@@ -416,6 +416,70 @@ static int s_rsa_public_ubin_e(int prng_idx)
    return CRYPT_OK;
 }
 
+static int s_rsa_verify_batch(int prng_idx, int hash_idx)
+{
+   rsa_key       key;
+   unsigned char msg[4][20], sig[4][128], bad[128];
+   const unsigned char *sigs[6], *hashes[6];
+   unsigned long siglen[6], hashlen[6], x;
+   int           stat[6], padding, i;
+   const int     paddings[] = { LTC_PKCS_1_V1_5, LTC_PKCS_1_PSS };
+
+   DO(rsa_make_key(&yarrow_prng, prng_idx, 1024/8, 65537, &key));
+
+   for (i = 0; i < 2; i++) {
+      padding = paddings[i];
+      for (x = 0; x < 4; x++) {
+         XMEMSET(msg[x], (int)x + 1, sizeof(msg[x]));
+         siglen[x] = sizeof(sig[x]);
+         DO(rsa_sign_hash_ex(msg[x], sizeof(msg[x]), sig[x], &siglen[x], padding, &yarrow_prng, prng_idx, hash_idx, 8, &key));
+         sigs[x] = sig[x];
+         hashes[x] = msg[x];
+         hashlen[x] = sizeof(msg[x]);
+      }
+      /* a signature of another message, a broken one and one of the wrong length */
+      hashes[3] = msg[0];
+      XMEMCPY(bad, sig[1], siglen[1]);
+      bad[7] ^= 0x40;
+      sigs[4] = bad;
+      siglen[4] = siglen[1];
+      hashes[4] = msg[1];
+      hashlen[4] = sizeof(msg[1]);
+      sigs[5] = sig[2];
+      siglen[5] = siglen[2] - 1;
+      hashes[5] = msg[2];
+      hashlen[5] = sizeof(msg[2]);
+
+      DO(rsa_verify_hash_batch(sigs, siglen, hashes, hashlen, 6, padding, hash_idx, 8, stat, &key));
+      ENSURE(stat[0] == 1 && stat[1] == 1 && stat[2] == 1);
+      ENSURE(stat[3] == 0 && stat[4] == 0 && stat[5] == 0);
+
+      /* the single verification must agree */
+      for (x = 0; x < 5; x++) {
+         stat[5] = -1;
+         if (rsa_verify_hash_ex(sigs[x], siglen[x], hashes[x], hashlen[x], padding, hash_idx, 8, &stat[5], &key) != CRYPT_OK) {
+            stat[5] = 0;
+         }
+         ENSURE(stat[5] == stat[x]);
+      }
+   }
+
+   /* a signature which is larger than the modulus is only invalid */
+   XMEMSET(bad, 0xff, siglen[0]);
+   DO(rsa_verify_hash_batch(sigs + 4, siglen, hashes, hashlen, 1, LTC_PKCS_1_V1_5, hash_idx, 0, stat, &key));
+   ENSURE(stat[0] == 0);
+
+   /* but a hash without an OID can't be used with v1.5 at all, that's no invalid signature */
+   if ((x = (unsigned long)find_hash("keccak256")) != (unsigned long)-1) {
+      stat[0] = -1;
+      ENSURE(rsa_verify_hash_batch(sigs, siglen, hashes, hashlen, 1, LTC_PKCS_1_V1_5, (int)x, 0, stat, &key) == CRYPT_INVALID_ARG);
+      ENSURE(stat[0] == 0);
+   }
+
+   rsa_free(&key);
+   return CRYPT_OK;
+}
+
 #ifdef LTC_TEST_READDIR
 static int s_rsa_import_x509(const void *in, unsigned long inlen, void *key)
 {
@@ -483,6 +547,7 @@ int rsa_test(void)
    DO(s_rsa_cryptx_issue_69());
    DO(s_rsa_issue_301(prng_idx));
    DO(s_rsa_public_ubin_e(prng_idx));
+   DO(s_rsa_verify_batch(prng_idx, hash_idx));
 
    /* make 10 random key */
    for (cnt = 0; cnt < 10; cnt++) {
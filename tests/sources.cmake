@@ -1,4 +1,5 @@
 set(SOURCES
+argon2_test.c
 base16_test.c
 base32_test.c
 base64_test.c
@@ -28,6 +29,7 @@ pkcs_1_test.c
 prng_test.c
 rotate_test.c
 rsa_test.c
+scrypt_test.c
 ssh_test.c
 store_test.c
 test.c
@@ -43,6 +43,8 @@ int x25519_test(void);
 int ed25519_test(void);
 int ssh_test(void);
 int bcrypt_test(void);
+int argon2_test(void);
+int scrypt_test(void);
 int no_null_termination_check_test(void);
 
 #ifdef LTC_PKCS_1